@@ -0,0 +1,187 @@
+#include "Compression.h"
+#include "RZip.h"
+#include "ROOTUnitTestSupport.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// A buffer that compresses well, with some variation from one seed to the other
+std::vector<char> MakeBuffer(std::size_t size, int seed)
+{
+   std::vector<char> buffer(size);
+   for (std::size_t i = 0; i < size; ++i)
+      buffer[i] = static_cast<char>('a' + (i * 7 + seed) % 13 + (i % 1000 == 0 ? seed : 0));
+   return buffer;
+}
+
+std::vector<char> Zip(std::vector<char> &src)
+{
+   int srcSize = src.size();
+   int tgtSize = src.size() + 64;
+   std::vector<char> tgt(tgtSize);
+   int irep = 0;
+   R__zipMultipleAlgorithm(5, &srcSize, src.data(), &tgtSize, tgt.data(), &irep,
+                           ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+   tgt.resize(irep);
+   return tgt;
+}
+
+int Unzip(std::vector<char> &src, std::vector<char> &tgt)
+{
+   int srcSize = src.size();
+   int tgtSize = tgt.size();
+   int irep = 0;
+   R__unzip(&srcSize, reinterpret_cast<unsigned char *>(src.data()), &tgtSize,
+            reinterpret_cast<unsigned char *>(tgt.data()), &irep);
+   return irep;
+}
+
+} // anonymous namespace
+
+TEST(ZipZSTD, RoundTrip)
+{
+   // The compression and decompression contexts are reused from one buffer to the next
+   for (int i = 0; i < 20; ++i) {
+      const std::size_t size = 100 + i * 1733;
+      auto src = MakeBuffer(size, i);
+      auto zipped = Zip(src);
+      ASSERT_GT(zipped.size(), 0u);
+      EXPECT_LT(zipped.size(), src.size());
+      EXPECT_EQ('Z', zipped[0]);
+      EXPECT_EQ('S', zipped[1]);
+
+      std::vector<char> unzipped(size);
+      ASSERT_EQ(static_cast<int>(size), Unzip(zipped, unzipped));
+      EXPECT_EQ(src, unzipped);
+   }
+}
+
+TEST(ZipZSTD, RoundTripInterleaved)
+{
+   // Interleave compression and decompression of different buffers on the same thread
+   auto src1 = MakeBuffer(50000, 1);
+   auto src2 = MakeBuffer(300, 2);
+   auto zipped1 = Zip(src1);
+   auto zipped2 = Zip(src2);
+   std::vector<char> unzipped1(src1.size());
+   std::vector<char> unzipped2(src2.size());
+   ASSERT_EQ(static_cast<int>(src2.size()), Unzip(zipped2, unzipped2));
+   EXPECT_EQ(zipped1, Zip(src1));
+   ASSERT_EQ(static_cast<int>(src1.size()), Unzip(zipped1, unzipped1));
+   EXPECT_EQ(src1, unzipped1);
+   EXPECT_EQ(src2, unzipped2);
+}
+
+TEST(ZipZSTD, RoundTripThreads)
+{
+   // Every thread uses its own contexts
+   const int nThreads = 4;
+   std::vector<int> nFailures(nThreads, 0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([t, &nFailures]() {
+         for (int i = 0; i < 10; ++i) {
+            auto src = MakeBuffer(1000 + 997 * i, t * 10 + i);
+            auto zipped = Zip(src);
+            std::vector<char> unzipped(src.size());
+            if (Unzip(zipped, unzipped) != static_cast<int>(src.size()) || unzipped != src)
+               ++nFailures[t];
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   for (int t = 0; t < nThreads; ++t)
+      EXPECT_EQ(0, nFailures[t]);
+}
+
+TEST(ZipZSTD, UnknownDictionary)
+{
+   auto src = MakeBuffer(10000, 3);
+   auto zipped = Zip(src);
+   ASSERT_GT(zipped.size(), 14u);
+
+   // Turn the zstd frame into one that references dictionary 123: set the dictionary ID flag of the frame header
+   // descriptor and insert the one-byte dictionary ID after the optional window descriptor
+   const std::size_t kHeaderSize = 9;
+   const std::size_t fhdPos = kHeaderSize + 4;
+   unsigned char fhd = zipped[fhdPos];
+   ASSERT_EQ(0, fhd & 0x3);
+   const bool singleSegment = (fhd >> 5) & 0x1;
+   zipped[fhdPos] = static_cast<char>(fhd | 0x1);
+   zipped.insert(zipped.begin() + fhdPos + (singleSegment ? 1 : 2), static_cast<char>(123));
+   const std::size_t deflateSize = zipped.size() - kHeaderSize;
+   zipped[3] = deflateSize & 0xff;
+   zipped[4] = (deflateSize >> 8) & 0xff;
+   zipped[5] = (deflateSize >> 16) & 0xff;
+
+   std::vector<char> unzipped(src.size());
+   {
+      ROOTUnitTestSupport::CheckDiagsRAII diags;
+      diags.requiredDiag(kError, "R__unzipZSTD", "error in unzip ZSTD", /*matchFullMessage=*/false);
+      EXPECT_EQ(0, Unzip(zipped, unzipped));
+   }
+
+   // The contexts of the thread are still usable after the failure
+   auto zipped2 = Zip(src);
+   ASSERT_EQ(static_cast<int>(src.size()), Unzip(zipped2, unzipped));
+   EXPECT_EQ(src, unzipped);
+}
+
+TEST(ZipZSTD, Dictionary)
+{
+   // Small records sharing their structure, as found in the baskets of a branch
+   std::mt19937 gen(42);
+   std::uniform_real_distribution<double> dist(-100., 100.);
+   auto makeRecord = [&](int i) {
+      std::string record;
+      char line[128];
+      for (int j = 0; j < 10; ++j) {
+         snprintf(line, sizeof(line), "event=%d track=%d px=%.3f py=%.3f pz=%.3f\n", i, j, dist(gen), dist(gen),
+                  dist(gen));
+         record += line;
+      }
+      return std::vector<char>(record.begin(), record.end());
+   };
+
+   std::vector<char> samples;
+   std::vector<std::size_t> sampleSizes;
+   for (int i = 0; i < 200; ++i) {
+      auto record = makeRecord(i);
+      samples.insert(samples.end(), record.begin(), record.end());
+      sampleSizes.push_back(record.size());
+   }
+   std::vector<char> dict(4096);
+   const std::size_t dictSize =
+      R__ZSTDTrainDictionary(dict.data(), dict.size(), samples.data(), sampleSizes.data(), sampleSizes.size());
+   ASSERT_GT(dictSize, 0u);
+   const unsigned dictId = R__ZSTDRegisterDictionary(dict.data(), dictSize);
+   ASSERT_NE(0u, dictId);
+   EXPECT_TRUE(R__ZSTDHasDictionary(dictId));
+
+   auto src = makeRecord(1000);
+   int srcSize = src.size();
+   int tgtSize = src.size() + 64;
+   std::vector<char> zipped(tgtSize);
+   int irep = 0;
+   R__zipZSTDDict(dictId, 5, &srcSize, src.data(), &tgtSize, zipped.data(), &irep);
+   ASSERT_GT(irep, 0);
+   zipped.resize(irep);
+   EXPECT_EQ(dictId, R__ZSTDGetDictID(reinterpret_cast<unsigned char *>(zipped.data()), zipped.size()));
+   EXPECT_LT(zipped.size(), Zip(src).size());
+
+   std::vector<char> unzipped(src.size());
+   ASSERT_EQ(static_cast<int>(src.size()), Unzip(zipped, unzipped));
+   EXPECT_EQ(src, unzipped);
+
+   // Buffers compressed without a dictionary do not reference one
+   auto plain = Zip(src);
+   EXPECT_EQ(0u, R__ZSTDGetDictID(reinterpret_cast<unsigned char *>(plain.data()), plain.size()));
+}
@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <cstddef>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -33,6 +35,17 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * ZSTD dictionary compression for small buffers, see ZipZSTD.h.  A buffer compressed with a dictionary can only be
+ * unzipped once the dictionary is registered.
+ */
+extern "C" size_t R__ZSTDTrainDictionary(void *dictBuffer, size_t dictCapacity, const void *samples,
+                                         const size_t *sampleSizes, unsigned nSamples);
+extern "C" unsigned R__ZSTDRegisterDictionary(const void *dict, size_t dictSize);
+extern "C" int R__ZSTDHasDictionary(unsigned dictId);
+extern "C" unsigned R__ZSTDGetDictID(const unsigned char *src, int srcsize);
+extern "C" void R__zipZSTDDict(unsigned dictId, int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
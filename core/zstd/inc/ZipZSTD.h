@@ -10,6 +10,8 @@
 #ifndef ROOT_ZipZSTD
 #define ROOT_ZipZSTD
 
+#include <stddef.h>
+
 // NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
 // #ifdef's to avoid problems with C code.
 #ifdef __cplusplus
@@ -17,6 +19,25 @@ extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+// Dictionary compression for small buffers that compress badly on their own, such as baskets of low-multiplicity
+// branches.  A dictionary is trained from sample buffers, e.g. the first few baskets of a branch, and it must be
+// registered before buffers compressed with it can be unzipped.  R__unzipZSTD picks the dictionary from the
+// dictionary ID stored in the zstd frame header, so that dictionary-compressed buffers use the regular ZS header.
+
+/// Trains a dictionary of at most dictCapacity bytes from nSamples buffers stored back-to-back in samples.
+/// Returns the size of the dictionary or 0 on failure.
+size_t R__ZSTDTrainDictionary(void *dictBuffer, size_t dictCapacity, const void *samples, const size_t *sampleSizes,
+                              unsigned nSamples);
+/// Makes a copy of the dictionary and registers it by its dictionary ID, which is returned.  Returns 0 if the buffer
+/// is not a valid zstd dictionary.  Registering the same dictionary again is a no-op.
+unsigned R__ZSTDRegisterDictionary(const void *dict, size_t dictSize);
+/// Returns whether a dictionary with this ID is registered
+int R__ZSTDHasDictionary(unsigned dictId);
+/// Returns the ID of the dictionary used by a ZS compressed buffer, or 0 if it uses none
+unsigned R__ZSTDGetDictID(const unsigned char *src, int srcsize);
+/// Like R__zipZSTD but using a dictionary previously registered with R__ZSTDRegisterDictionary
+void R__zipZSTDDict(unsigned dictId, int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 #ifdef __cplusplus
 }
 #endif
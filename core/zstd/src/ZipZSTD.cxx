@@ -11,33 +11,103 @@
 #include "ZipZSTD.h"
 
 #include "ROOT/RConfig.hxx"
+#include "TError.h"
 
 #include "zdict.h"
 #include <zstd.h>
+#include <map>
 #include <memory>
-
-#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
-void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+namespace {
+
+using CCtx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+using DCtx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+
+/// Contexts are expensive to set up; they are reused by all the (de)compression calls of a thread
+ZSTD_CCtx *GetThreadCCtx()
+{
+    thread_local CCtx_ptr ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return ctx.get();
+}
+
+ZSTD_DCtx *GetThreadDCtx()
+{
+    thread_local DCtx_ptr ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return ctx.get();
+}
+
+using CDict_ptr = std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>;
+using DDict_ptr = std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>;
+
+/// A registered dictionary; the digested compression dictionaries are created on demand per compression level
+struct RDictionary {
+    std::vector<char> fBuffer;
+    DDict_ptr fDDict{nullptr, &ZSTD_freeDDict};
+    std::map<int, CDict_ptr> fCDicts;
+};
+
+std::mutex gDictionaryLock;
+
+std::map<unsigned, RDictionary> &GetDictionaries()
+{
+    static std::map<unsigned, RDictionary> dictionaries;
+    return dictionaries;
+}
+
+/// Returns nullptr if the dictionary is unknown.  The registered dictionaries are never freed.
+const ZSTD_CDict *GetCDict(unsigned dictId, int level)
+{
+    std::lock_guard<std::mutex> guard(gDictionaryLock);
+    auto itr = GetDictionaries().find(dictId);
+    if (itr == GetDictionaries().end())
+        return nullptr;
+    auto &cdicts = itr->second.fCDicts;
+    auto itrCDict = cdicts.find(level);
+    if (itrCDict == cdicts.end()) {
+        const auto &buffer = itr->second.fBuffer;
+        CDict_ptr cdict{ZSTD_createCDict(buffer.data(), buffer.size(), level), &ZSTD_freeCDict};
+        itrCDict = cdicts.emplace(level, std::move(cdict)).first;
+    }
+    return itrCDict->second.get();
+}
+
+const ZSTD_DDict *GetDDict(unsigned dictId)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    std::lock_guard<std::mutex> guard(gDictionaryLock);
+    auto itr = GetDictionaries().find(dictId);
+    if (itr == GetDictionaries().end())
+        return nullptr;
+    return itr->second.fDDict.get();
+}
 
+/// Common part of R__zipZSTD and R__zipZSTDDict; cdict can be nullptr
+void ZipImpl(const ZSTD_CDict *cdict, int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+    size_t retval;
+    if (cdict) {
+        retval = ZSTD_compress_usingCDict(GetThreadCCtx(),
+                                          &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                          src, static_cast<size_t>(*srcsize),
+                                          cdict);
+    } else {
+        retval = ZSTD_compressCCtx(GetThreadCCtx(),
+                                   &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                   src, static_cast<size_t>(*srcsize),
+                                   2*cxlevel);
+    }
 
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
-            std::cerr << "Error in zip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
-            " . Code = " << retval << std::endl;
+            Error("R__zipZSTD", "error in zip ZSTD. Type = %s . Code = %zu", ZSTD_getErrorName(retval), retval);
             return;
         }
     }
@@ -58,36 +128,111 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
     tgt[8] = (inflate_size >> 16) & 0xff;
 }
 
+} // anonymous namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    ZipImpl(nullptr, cxlevel, srcsize, src, tgtsize, tgt, irep);
+}
+
+void R__zipZSTDDict(unsigned dictId, int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    auto cdict = GetCDict(dictId, 2*cxlevel);
+    if (R__unlikely(!cdict)) {
+        *irep = 0;
+        Error("R__zipZSTDDict", "unknown dictionary %u", dictId);
+        return;
+    }
+    ZipImpl(cdict, cxlevel, srcsize, src, tgtsize, tgt, irep);
+}
+
+size_t R__ZSTDTrainDictionary(void *dictBuffer, size_t dictCapacity, const void *samples, const size_t *sampleSizes,
+                              unsigned nSamples)
+{
+    size_t retval = ZDICT_trainFromBuffer(dictBuffer, dictCapacity, samples, sampleSizes, nSamples);
+    if (ZDICT_isError(retval)) {
+        // Typically too few or too small samples; the caller then compresses without dictionary
+        Warning("R__ZSTDTrainDictionary", "cannot train dictionary. Type = %s", ZDICT_getErrorName(retval));
+        return 0;
+    }
+    return retval;
+}
+
+unsigned R__ZSTDRegisterDictionary(const void *dict, size_t dictSize)
+{
+    unsigned dictId = ZDICT_getDictID(dict, dictSize);
+    if (dictId == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> guard(gDictionaryLock);
+    auto &dictionaries = GetDictionaries();
+    if (dictionaries.count(dictId) > 0)
+        return dictId;
+
+    RDictionary entry;
+    entry.fBuffer.assign(static_cast<const char *>(dict), static_cast<const char *>(dict) + dictSize);
+    entry.fDDict = DDict_ptr(ZSTD_createDDict(entry.fBuffer.data(), entry.fBuffer.size()), &ZSTD_freeDDict);
+    if (!entry.fDDict)
+        return 0;
+    dictionaries.emplace(dictId, std::move(entry));
+    return dictId;
+}
+
+int R__ZSTDHasDictionary(unsigned dictId)
+{
+    std::lock_guard<std::mutex> guard(gDictionaryLock);
+    return GetDictionaries().count(dictId) > 0;
+}
+
+unsigned R__ZSTDGetDictID(const unsigned char *src, int srcsize)
+{
+    if (srcsize <= kHeaderSize || src[0] != 'Z' || src[1] != 'S')
+        return 0;
+    return ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(srcsize - kHeaderSize));
+}
+
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
-    Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
     *irep = 0;
 
     if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
-      std::cerr << "R__unzipZSTD: algorithm run against buffer with incorrect header (got " <<
-      src[0] << src[1] << "; expected ZS)." << std::endl;
+      Error("R__unzipZSTD", "algorithm run against buffer with incorrect header (got %c%c; expected ZS).", src[0],
+            src[1]);
       return;
     }
 
     int ZSTD_version =  ZSTD_versionNumber() / (100 * 100);
     if (R__unlikely(src[2] != ZSTD_version)) {
-      std::cerr << "R__unzipZSTD: This version of ZSTD is incompatible with the on-disk version "
-      "got "<< src[2] << "; expected "<< ZSTD_version << ")" << std::endl;
+      Error("R__unzipZSTD", "this version of ZSTD is incompatible with the on-disk version (got %d; expected %d)",
+            src[2], ZSTD_version);
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    const size_t frameSize = static_cast<size_t>(*srcsize - kHeaderSize);
+    size_t retval;
+    if (unsigned dictId = ZSTD_getDictID_fromFrame(&src[kHeaderSize], frameSize)) {
+        // The dictionary must have been registered, e.g. by the reader of the file that stores it
+        auto ddict = GetDDict(dictId);
+        if (R__unlikely(!ddict)) {
+            Error("R__unzipZSTD", "error in unzip ZSTD: unknown dictionary %u", dictId);
+            return;
+        }
+        retval = ZSTD_decompress_usingDDict(GetThreadDCtx(),
+                                            (char *)tgt, static_cast<size_t>(*tgtsize),
+                                            (char *)&src[kHeaderSize], frameSize,
+                                            ddict);
+    } else {
+        retval = ZSTD_decompressDCtx(GetThreadDCtx(),
+                                     (char *)tgt, static_cast<size_t>(*tgtsize),
+                                     (char *)&src[kHeaderSize], frameSize);
+    }
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
      */
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
-            std::cerr << "Error in unzip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
-            " . Code = " << retval << std::endl;
+            Error("R__unzipZSTD", "error in unzip ZSTD. Type = %s . Code = %zu", ZSTD_getErrorName(retval), retval);
             return;
         }
     }
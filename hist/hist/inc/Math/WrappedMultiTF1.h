@@ -165,6 +165,9 @@ namespace ROOT {
             return fFunc->EvalPar(x, 0);
          }
 
+         /// evaluate function at n points passing coordinates x and vector of parameters
+         void DoEvalParVec(const T *x, std::size_t n, const double *p, T *out) const;
+
          /// evaluate the partial derivative with respect to the parameter
          T DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const;
 
@@ -209,6 +212,38 @@ namespace ROOT {
          }
       };
 
+      /**
+       * Auxiliar class to evaluate the function at many points with TF1::EvalParVec, which is available only for
+       * double. The general implementation evaluates the points one by one.
+       */
+      template <class T>
+      struct EvalParVecFunction {
+         static void
+         DoEvalParVec(const WrappedMultiTF1Templ<T> *wrappedFunc, const T *x, std::size_t n, const double *p, T *out)
+         {
+            TF1 *func = const_cast<TF1 *>(wrappedFunc->GetFunction());
+            const unsigned int ndim = wrappedFunc->NDim();
+            for (std::size_t i = 0; i < n; ++i)
+               out[i] = func->EvalPar(x + i * ndim, p);
+         }
+      };
+
+      template <>
+      struct EvalParVecFunction<double> {
+         static void DoEvalParVec(const WrappedMultiTF1Templ<double> *wrappedFunc, const double *x, std::size_t n,
+                                  const double *p, double *out)
+         {
+            TF1 *func = const_cast<TF1 *>(wrappedFunc->GetFunction());
+            const unsigned int ndim = wrappedFunc->NDim();
+            if (ndim == static_cast<unsigned int>(func->GetNdim())) {
+               func->EvalParVec(x, n, p, out);
+               return;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+               out[i] = func->EvalPar(x + i * ndim, p);
+         }
+      };
+
       // implementations for WrappedMultiTF1Templ<T>
       template<class T>
       WrappedMultiTF1Templ<T>::WrappedMultiTF1Templ(TF1 &f, unsigned int dim)  :
@@ -314,6 +349,12 @@ namespace ROOT {
             return GeneralLinearFunctionDerivation<T>::DoParameterDerivative(this, x, ipar);
          }
       }
+      template<class T>
+      void WrappedMultiTF1Templ<T>::DoEvalParVec(const T *x, std::size_t n, const double *p, T *out) const
+      {
+         EvalParVecFunction<T>::DoEvalParVec(this, x, n, p, out);
+      }
+
       template<class T>
       void WrappedMultiTF1Templ<T>::SetDerivPrecision(double eps)
       {
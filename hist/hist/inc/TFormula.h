@@ -105,6 +105,8 @@ private:
    CallFuncSignature fFuncPtr = nullptr;           ///<! Function pointer, owned by the JIT.
    CallFuncSignature fGradFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
    CallFuncSignature fHessFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
+   CallFuncSignature fBatchFuncPtr = nullptr;      ///<! Function pointer to the loop over many points, owned by the JIT.
+   std::atomic<Bool_t> fBatchInitialized{kFALSE};  ///<! Transient flag set once the generation of the loop has been tried
    void *   fLambdaPtr = nullptr;                  ///<! Pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
@@ -137,6 +139,11 @@ private:
    bool HasHessianGenerationFailed() const {
       return !fHessFuncPtr && !fHessGenerationInput.empty();
    }
+   std::string GetBatchFuncName() const {
+      assert(fClingName.Length() && "TFormula is not initialized yet!");
+      return std::string(fClingName.Data()) + "_batch" + std::to_string(fNdim);
+   }
+   bool GenerateBatchEval();
 
 protected:
 
@@ -202,6 +209,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalParVec(const Double_t *x, std::size_t n, const Double_t *params, Double_t *out) const;
 
    /// Generate gradient computation routine with respect to the parameters.
    /// \returns true if a gradient was generated and GradientPar can be called.
@@ -0,0 +1,95 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH1ConcurrentFillManager, TH1ConcurrentFiller                        //
+//                                                                      //
+// Fill one TH1, TH2 or TH3 from several threads at the same time,      //
+// without a copy of the histogram per thread.                          //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+class TH1ConcurrentFiller;
+
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller;
+
+public:
+   /// How the fillers accumulate the bin contents
+   enum class EMode {
+      kDeltaBuffer, ///< Each filler collects the bins it touched in a small map, added to the histogram under a lock when full
+      kAtomic       ///< All fillers add to one shared array of atomic bin contents, moved into the histogram by Flush()
+   };
+
+private:
+   TH1 *fHist = nullptr;                                 ///< Histogram filled, nullptr if it cannot be filled concurrently
+   EMode fMode;                                          ///< Accumulation mode of the fillers
+   std::size_t fBufferSize;                              ///< Number of distinct bins after which a delta buffer is flushed
+   Int_t fNcells = 0;                                    ///< Number of bins, including under- and overflow
+   std::unique_ptr<std::atomic<Double_t>[]> fSumw;       ///< Shared bin contents in atomic mode
+   std::unique_ptr<std::atomic<Double_t>[]> fSumw2;      ///< Shared sums of squared weights in atomic mode
+   std::atomic<Bool_t> fWeighted{kFALSE};                ///< Whether a weight different from 1 was filled in atomic mode
+   std::mutex fMutex;                                    ///< Protects all modifications of fHist
+
+   void AddToHist(const std::unordered_map<Int_t, std::pair<Double_t, Double_t>> &deltas, Bool_t weighted);
+   void AddStats(const Double_t *stats, Double_t entries);
+   void PrepareSumw2(Bool_t weighted);
+
+public:
+   TH1ConcurrentFillManager(TH1 &h, EMode mode = EMode::kDeltaBuffer, std::size_t bufferSize = 1024);
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+   ~TH1ConcurrentFillManager();
+
+   TH1ConcurrentFiller MakeFiller();
+   void Flush();
+
+   EMode GetMode() const { return fMode; }
+   TH1 *GetHist() const { return fHist; }
+};
+
+class TH1ConcurrentFiller {
+   friend class TH1ConcurrentFillManager;
+
+private:
+   TH1ConcurrentFillManager *fManager;                          ///< Manager of the histogram filled
+   std::unordered_map<Int_t, std::pair<Double_t, Double_t>> fDeltas; ///< Sum of weights and of squared weights per bin in delta buffer mode
+   Double_t fStats[TH1::kNstat];                                ///< Statistics not yet added to the histogram
+   Double_t fEntries = 0;                                       ///< Number of entries not yet added to the histogram
+   Bool_t fWeighted = kFALSE;                                   ///< Whether a weight different from 1 was filled since the last flush
+
+   explicit TH1ConcurrentFiller(TH1ConcurrentFillManager &manager);
+   void FillBin(Int_t bin, Double_t w);
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other);
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(TH1ConcurrentFiller &&) = delete;
+   ~TH1ConcurrentFiller();
+
+   Int_t Fill(Double_t x, Double_t w = 1.);
+   Int_t Fill(const Double_t *x, Double_t w = 1.);
+   void Flush();
+};
+
+#endif
@@ -32,6 +32,7 @@ class THn: public THnBase {
 protected:
    void AllocCoordBuf() const;
    void InitStorage(Int_t* nbins, Int_t chunkSize);
+   void AddSameLayout(const std::vector<const THn*>& hists);
 
    THn() = default;
    THn(const char* name, const char* title, Int_t dim, const Int_t* nbins,
@@ -174,6 +175,8 @@ public:
       return (THn*) RebinBase(group);
    }
 
+   Long64_t Merge(TCollection* list);
+
    void Reset(Option_t* option = "");
 
 protected:
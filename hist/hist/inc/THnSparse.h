@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -38,8 +37,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;                   ///<  Number of entries for each chunk
    Long64_t   fFilledBins;                  ///<  Number of filled bins
    TObjArray  fBinContent;                  ///<  Array of THnSparseArrayChunk
-   TExMap     fBins;                        ///<! Filled bins
-   TExMap     fBinsContinued;               ///<! Filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseHashTable fBins;                ///<! Linear bin index of the filled bins, by hash of their compact coordinate
    THnSparseCompactBinCoord *fCompactCoord; ///<! Compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -57,9 +55,12 @@ class THnSparse: public THnBase {
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
-   void FillExMap();
+   void FillBinIndex();
    virtual TArray* GenerateArray() const = 0;
+   Long64_t FindBinIndex(ULong64_t hash, const Char_t* buf) const;
+   Long64_t AllocateBin(ULong64_t hash, const Char_t* buf);
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   void AddSparse(const THnSparse* h);
 
    /// Increment the bin content of "bin" by "w",
    /// return the bin index.
@@ -162,6 +163,7 @@ class THnSparse: public THnBase {
       return (THnSparse*) RebinBase(group);
    }
 
+   Long64_t Merge(TCollection* list);
    void Reset(Option_t* option = "");
    void Sumw2();
 
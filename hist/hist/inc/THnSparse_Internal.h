@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -66,5 +68,48 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDef(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+/** \class THnSparseHashTable
+Open-addressing hash table used internally by THnSparse to find the linear
+bin index of a compact bin coordinate. Keys and bin indices are stored in
+two flat arrays, probed linearly. Bins are never removed, so no deletion
+markers are needed.
+*/
+
+class THnSparseHashTable {
+ private:
+   std::vector<ULong64_t> fKeys;   ///< Hash of the compact bin coordinate of each slot
+   std::vector<Long64_t>  fValues; ///< Linear bin index of each slot; -1 for an empty slot
+   Long64_t               fSize = 0; ///< Number of occupied slots
+   ULong64_t              fMask = 0; ///< Number of slots minus one; the number of slots is a power of two
+
+   void Rehash(ULong64_t nslots);
+
+ public:
+   /// Spread the bits of the hash: compact coordinates that fit into 8 bytes are used as their own
+   /// hash, and neighbouring bins would otherwise occupy neighbouring slots.
+   static ULong64_t Mix(ULong64_t hash) {
+      hash ^= hash >> 33;
+      hash *= 0xff51afd7ed558ccdULL;
+      hash ^= hash >> 33;
+      hash *= 0xc4ceb9fe1a85ec53ULL;
+      hash ^= hash >> 33;
+      return hash;
+   }
+
+   Long64_t  GetSize() const { return fSize; }
+   ULong64_t GetCapacity() const { return fKeys.size(); }
+   Bool_t    IsEmpty() const { return fSize == 0; }
+
+   /// First slot to look at for "hash"; continue with NextSlot() until GetValue() is -1.
+   ULong64_t FirstSlot(ULong64_t hash) const { return Mix(hash) & fMask; }
+   ULong64_t NextSlot(ULong64_t slot) const { return (slot + 1) & fMask; }
+   ULong64_t GetKey(ULong64_t slot) const { return fKeys[slot]; }
+   Long64_t  GetValue(ULong64_t slot) const { return fKeys.empty() ? -1 : fValues[slot]; }
+
+   void Clear();
+   void Insert(ULong64_t hash, Long64_t value);
+   void Reserve(Long64_t n);
+};
+
 #endif // ROOT_THnSparse_Internal
 
@@ -73,7 +73,8 @@ public:
    enum EBinning{
       kUnbinned,
       kRelaxedBinning, ///< The algorithm is allowed to use binning if the data is large enough
-      kForcedBinning
+      kForcedBinning,
+      kFFTBinning      ///< The data are linearly binned on a grid, where the estimate is computed by FFT convolution. Events are not kept.
    };
 
    ///  default constructor used only by I/O
@@ -88,6 +89,9 @@ public:
    /// For this reason, by default for Nevents >=10000, the data are automatically binned  in
    /// nbins=Min(10000,Nevents/10)
    /// In case of ForceBinning option the default number of bins is 1000
+   /// With the FFTBinning option the events are accumulated on a grid of nbins points in [xMin,xMax] and
+   /// are not stored, such that any number of them can be added with Fill() or FillN(), also after the
+   /// construction with events = 0. Only the fixed iteration is supported in this case.
    TKDE(UInt_t events, const Double_t* data, Double_t xMin = 0.0, Double_t xMax = 0.0, const Option_t* option =
                  "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:RelaxedBinning", Double_t rho = 1.0) {
       Instantiate( nullptr,  events, data, nullptr, xMin, xMax, option, rho);
@@ -115,6 +119,7 @@ public:
 
    void Fill(Double_t data);
    void Fill(Double_t data, Double_t weight);
+   void FillN(UInt_t n, const Double_t* data, const Double_t* weights = nullptr);
    void SetKernelType(EKernelType kern);
    void SetIteration(EIteration iter);
    void SetMirror(EMirror mir);
@@ -227,6 +232,11 @@ private:
 
    std::vector<Double_t> fBinCount;    ///< Number of events per bin for binned data option
 
+   std::vector<Double_t> fGridCounts;  ///< Linearly binned sum of weights on the grid points for the FFT binning option
+   std::vector<Double_t> fGridDensity; ///<! Estimate on the grid points, extended by the kernel support on both sides
+   Double_t fSumOfX;                   ///< Sum of weight * x of the events on the grid for the FFT binning option
+   Double_t fSumOfX2;                  ///< Sum of weight * x * x of the events on the grid for the FFT binning option
+
    std::vector<Bool_t> fSettedOptions; ///< User input options flag
 
    struct KernelIntegrand;
@@ -268,6 +278,11 @@ private:
 
    void SetBinCentreData(Double_t xmin, Double_t xmax);
    void SetBinCountData();
+   void InitGrid();
+   void FillGrid(Double_t x, Double_t w);
+   void ComputeGridStats();
+   void ComputeGridDensity();
+   Double_t GetGridDensity(Double_t x) const;
    void CheckKernelValidity();
    void SetUserCanonicalBandwidth();
    void SetUserKernelSigma2();
@@ -298,7 +313,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 4) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
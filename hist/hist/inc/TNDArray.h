@@ -82,6 +82,13 @@ public:
    virtual void SetAsDouble(ULong64_t linidx, Double_t value) = 0;
    virtual void AddAt(ULong64_t linidx, Double_t value) = 0;
 
+   /// Add the bins [begin, end) of other, which has the same layout, to this array.
+   /// The storage of this array must be allocated, e.g. by a preceding AddAt().
+   virtual void AddRange(const TNDArray &other, ULong64_t begin, ULong64_t end) {
+      for (ULong64_t i = begin; i < end; ++i)
+         AddAt(i, other.AtAsDouble(i));
+   }
+
 protected:
    std::vector<Long64_t> fSizes; ///< bin count
    ClassDef(TNDArray, 2);        ///< Base for n-dimensional array
@@ -167,6 +174,20 @@ public:
          fData.resize(fSizes[0], T());
       fData[linidx] += (T) value;
    }
+   void AddRange(const TNDArray &other, ULong64_t begin, ULong64_t end) {
+      const TNDArrayT<T> *same = dynamic_cast<const TNDArrayT<T> *>(&other);
+      if (!same) {
+         TNDArray::AddRange(other, begin, end);
+         return;
+      }
+      if (same->fData.empty())
+         return;
+      // no dependency between the iterations, such that the compiler vectorizes the loop
+      T *out = fData.data();
+      const T *in = same->fData.data();
+      for (ULong64_t i = begin; i < end; ++i)
+         out[i] += in[i];
+   }
 
 protected:
    std::vector<T> fData;   // data
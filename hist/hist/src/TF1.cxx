@@ -1529,6 +1529,31 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function at n points for the given parameters.
+///
+/// The coordinates of the point i are x[i * GetNdim()] to
+/// x[i * GetNdim() + GetNdim() - 1] and its value is stored in out[i].
+/// If argument params is omitted or equal 0, the internal values
+/// of parameters will be used instead.
+/// Functions defined by a formula are evaluated by TFormula::EvalParVec,
+/// in a loop that the compiler can vectorize; the other functions are
+/// evaluated point by point with EvalPar.
+
+void TF1::EvalParVec(const Double_t *x, std::size_t n, const Double_t *params, Double_t *out)
+{
+   if (fType == EFType::kFormula && fFormula && fFormula->GetNdim() == fNdim) {
+      fFormula->EvalParVec(x, n, params, out);
+      if (fNormalized && fNormIntegral != 0) {
+         for (std::size_t i = 0; i < n; ++i)
+            out[i] /= fNormIntegral;
+      }
+      return;
+   }
+   for (std::size_t i = 0; i < n; ++i)
+      out[i] = EvalPar(x + i * fNdim, params);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
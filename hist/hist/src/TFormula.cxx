@@ -759,6 +759,8 @@ void TFormula::Copy(TObject &obj) const
    fnew.fHessGenerationInput = fHessGenerationInput;
    fnew.fGradFuncPtr = fGradFuncPtr;
    fnew.fHessFuncPtr = fHessFuncPtr;
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
+   fnew.fBatchInitialized = fBatchInitialized.load();
 
 }
 
@@ -775,6 +777,8 @@ void TFormula::Clear(Option_t * )
    fClingName = "";
 
    fMethod.reset();
+   fBatchFuncPtr = nullptr;
+   fBatchInitialized = false;
 
    fClingVariables.clear();
    fClingParameters.clear();
@@ -2310,6 +2314,9 @@ void TFormula::ProcessFormula(TString &formula)
 
          // set the name for Cling using the hash_function
          fClingName = gNamePrefix;
+         // a loop over many points generated for a previous expression cannot be used anymore
+         fBatchFuncPtr = nullptr;
+         fBatchInitialized = false;
 
          // check if formula exist already in the map
          R__LOCKGUARD(gROOTMutex);
@@ -3367,6 +3374,97 @@ void TFormula::HessianPar(const Double_t *x, Double_t *result) {
    CallCladFunction(fHessFuncPtr, vars, pars, result, fNpar * fNpar);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the function evaluating the formula in a loop over many points.
+/// The loop is compiled together with the formula and with optimizations, such
+/// that the compiler can inline the formula and vectorize the loop.
+/// \returns true if the loop was generated and EvalParVec can call it.
+
+bool TFormula::GenerateBatchEval()
+{
+   if (fBatchFuncPtr)
+      return true;
+
+   const std::string batchName = GetBatchFuncName();
+   // As for the gradient, another TFormula with the same expression and
+   // dimension may have generated the function already
+   if (!functionExists(batchName)) {
+      std::string call = std::string(fClingName.Data()) + "(";
+      if (fNdim > 0 || fNpar > 0)
+         call += "x + i * " + std::to_string(fNdim);
+      if (fNpar > 0)
+         call += ", p";
+      call += ")";
+      std::string input = "#pragma cling optimize(2)\n"
+                          "void " + batchName + "(Double_t *x, Double_t *p, Double_t *out, Long64_t n) {\n"
+                          "   for (Long64_t i = 0; i < n; ++i)\n"
+                          "      out[i] = " + call + ";\n"
+                          "}";
+      if (!gInterpreter->Declare(input.c_str())) {
+         Error("GenerateBatchEval", "Can't declare function %s", batchName.c_str());
+         return false;
+      }
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(batchName.c_str(), "Double_t*,Double_t*,Double_t*,Long64_t");
+   if (!method.IsValid()) {
+      Error("GenerateBatchEval", "Can't compile function %s", batchName.c_str());
+      return false;
+   }
+   fBatchFuncPtr = prepareFuncPtr(&method);
+   return fBatchFuncPtr != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points for the parameters params, storing the
+/// values in out. The coordinates of the point i are x[i * GetNdim()] to
+/// x[i * GetNdim() + GetNdim() - 1]. If params is nullptr the parameter values
+/// of the formula are used.
+///
+/// The points are evaluated by a loop JIT-ed together with the formula, which
+/// the compiler can vectorize. Vectorized formulas and formulas built from a
+/// lambda expression are evaluated point by point.
+
+void TFormula::EvalParVec(const Double_t *x, std::size_t n, const Double_t *params, Double_t *out) const
+{
+   if (n == 0)
+      return;
+
+   // the first point is evaluated as usual: this initializes the formula if needed
+   // and reports the errors of an invalid formula only once
+   out[0] = EvalPar(x, params);
+   if (!fReadyToExecute || !fClingInitialized) {
+      for (std::size_t i = 1; i < n; ++i)
+         out[i] = TMath::QuietNaN();
+      return;
+   }
+
+   const bool useBatch = !fVectorized && !(fLambdaPtr && TestBit(TFormula::kLambda));
+   if (useBatch && !fBatchInitialized) {
+      // generating the loop is not thread safe
+      R__LOCKGUARD(gROOTMutex);
+      if (!fBatchInitialized) {
+         auto thisFormula = const_cast<TFormula *>(this);
+         thisFormula->GenerateBatchEval();
+         thisFormula->fBatchInitialized = true;
+      }
+   }
+
+   if (!useBatch || !fBatchFuncPtr) {
+      for (std::size_t i = 1; i < n; ++i)
+         out[i] = EvalPar(x + i * fNdim, params);
+      return;
+   }
+
+   double *vars = const_cast<double *>(x + fNdim);
+   double *pars = (params) ? const_cast<double *>(params) : const_cast<double *>(fClingParameters.data());
+   double *result = out + 1;
+   Long64_t npoints = n - 1;
+   void *args[4] = {&vars, &pars, &result, &npoints};
+   (*fBatchFuncPtr)(0, 4, args, /*ret*/ nullptr); // the loop returns void
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 #ifdef R__HAS_VECCORE
 // ROOT::Double_v TFormula::Eval(ROOT::Double_v x, ROOT::Double_v y, ROOT::Double_v z, ROOT::Double_v t) const
@@ -52,6 +52,7 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "THFillHelper.h"
 
 /** \addtogroup Histograms
 @{
@@ -3478,6 +3479,10 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method to fill histogram content from a vector
 /// called directly by TH1::BufferEmpty
+///
+/// If the axis has fixed bins and cannot be extended, the bins are computed
+/// for chunks of entries at once and the statistics are accumulated in local
+/// variables. The results are identical to filling the entries one by one.
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3486,6 +3491,35 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   if (THFillHelper::IsFixedAxis(fXaxis)) {
+      Int_t bins[THFillHelper::kChunkSize];
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      for (Int_t first = 0; first < ntimes; first += THFillHelper::kChunkSize) {
+         const Int_t n = TMath::Min(THFillHelper::kChunkSize, ntimes - first);
+         THFillHelper::FindFixedBins(fXaxis, n, x + first * stride, stride, bins);
+         for (Int_t j = 0; j < n; ++j) {
+            i = (first + j) * stride;
+            bin = bins[j];
+            if (w) ww = w[i];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if ((bin == 0 || bin > nbins) && !statOverflows) continue;
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*x[i];
+            tsumwx2 += ww*x[i]*x[i];
+         }
+      }
+      fTsumw = tsumw;
+      fTsumw2 = tsumw2;
+      fTsumwx = tsumwx;
+      fTsumwx2 = tsumwx2;
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -0,0 +1,309 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH1ConcurrentFill.h"
+
+#include "TAxis.h"
+#include "TError.h"
+
+/** \class TH1ConcurrentFillManager
+    \ingroup Hist
+Manages the concurrent filling of one TH1, TH2 or TH3 from several threads.
+
+Each thread obtains its own TH1ConcurrentFiller from MakeFiller() and fills through it:
+~~~ {.cpp}
+TH2D h("h", "h", 100, 0., 1., 100, 0., 1.);
+TH1ConcurrentFillManager manager(h);
+auto work = [&manager]() {
+   auto filler = manager.MakeFiller();
+   Double_t xy[2];
+   for (...)
+      filler.Fill(xy, w);
+};
+// run work in several threads, join them ...
+manager.Flush();
+~~~
+Contrary to a clone of the histogram per thread, the memory used does not grow with the number of
+threads times the number of bins:
+
+  - In delta buffer mode (the default), each filler collects the sums of weights of the bins it
+    touched in a map of at most `bufferSize` bins. A full map is added to the histogram under a lock.
+    This is efficient for histograms with many bins of which each thread touches few at a time.
+  - In atomic mode, all fillers add to one shared array of atomic bin contents, owned by the manager.
+    Flush() moves the array into the histogram. This is efficient for histograms with few bins.
+
+The statistics of the fills (sum of weights, of x*w, ...) are kept by each filler and added to the
+histogram when the filler is flushed or destroyed. The histogram must not be accessed by other means
+until all fillers are destroyed and the manager is flushed; the manager must outlive its fillers.
+
+The bins are computed with TH1::FindFixBin: axes are never extended, values beyond the axis range go
+into the under- or overflow bins. Profiles and TH2Poly cannot be filled concurrently.
+*/
+
+/** \class TH1ConcurrentFiller
+    \ingroup Hist
+Fills a histogram managed by a TH1ConcurrentFillManager. A filler must only be used by one thread.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the concurrent filling of `h` in the given mode. In delta buffer mode, `bufferSize`
+/// is the number of distinct bins each filler collects before adding them to the histogram.
+
+TH1ConcurrentFillManager::TH1ConcurrentFillManager(TH1 &h, EMode mode, std::size_t bufferSize)
+   : fMode(mode), fBufferSize(bufferSize > 0 ? bufferSize : 1)
+{
+   if (h.InheritsFrom("TProfile") || h.InheritsFrom("TProfile2D") || h.InheritsFrom("TProfile3D") ||
+       h.InheritsFrom("TH2Poly")) {
+      Error("TH1ConcurrentFillManager", "histogram %s of class %s cannot be filled concurrently, fills are ignored",
+            h.GetName(), h.ClassName());
+      return;
+   }
+   if (h.GetXaxis()->CanExtend() || h.GetYaxis()->CanExtend() || h.GetZaxis()->CanExtend())
+      Warning("TH1ConcurrentFillManager", "the axes of histogram %s are not extended by the concurrent fills",
+              h.GetName());
+
+   fHist = &h;
+   // fills of the buffer must go into the bins before the concurrent ones
+   if (fHist->GetBuffer())
+      fHist->BufferEmpty(1);
+   fNcells = fHist->GetNcells();
+
+   if (fMode == EMode::kAtomic) {
+      fSumw.reset(new std::atomic<Double_t>[fNcells]);
+      fSumw2.reset(new std::atomic<Double_t>[fNcells]);
+      for (Int_t bin = 0; bin < fNcells; ++bin) {
+         fSumw[bin] = 0.;
+         fSumw2[bin] = 0.;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor, flushes the shared bin contents into the histogram.
+
+TH1ConcurrentFillManager::~TH1ConcurrentFillManager()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a filler of the histogram, to be used by one thread.
+
+TH1ConcurrentFiller TH1ConcurrentFillManager::MakeFiller()
+{
+   return TH1ConcurrentFiller(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// In atomic mode, move the shared bin contents into the histogram.
+/// Bins and statistics collected by the fillers are added by TH1ConcurrentFiller::Flush().
+
+void TH1ConcurrentFillManager::Flush()
+{
+   if (!fHist || fMode != EMode::kAtomic)
+      return;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   PrepareSumw2(fWeighted);
+   Double_t *sumw2 = fHist->GetSumw2N() ? fHist->GetSumw2()->GetArray() : nullptr;
+   for (Int_t bin = 0; bin < fNcells; ++bin) {
+      // exchange rather than load and store, such that fillers may still be running
+      const Double_t w = fSumw[bin].exchange(0.);
+      const Double_t w2 = fSumw2[bin].exchange(0.);
+      if (w != 0.)
+         fHist->AddBinContent(bin, w);
+      if (sumw2)
+         sumw2[bin] += w2;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the sum of squares of weights of the histogram if needed, as TH1::Fill does.
+/// Must be called with fMutex locked, before adding bin contents.
+
+void TH1ConcurrentFillManager::PrepareSumw2(Bool_t weighted)
+{
+   if (weighted && !fHist->GetSumw2N() && !fHist->TestBit(TH1::kIsNotW))
+      fHist->Sumw2();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the delta buffer of a filler to the histogram.
+
+void TH1ConcurrentFillManager::AddToHist(const std::unordered_map<Int_t, std::pair<Double_t, Double_t>> &deltas,
+                                         Bool_t weighted)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   PrepareSumw2(weighted);
+   Double_t *sumw2 = fHist->GetSumw2N() ? fHist->GetSumw2()->GetArray() : nullptr;
+   for (const auto &delta : deltas) {
+      fHist->AddBinContent(delta.first, delta.second.first);
+      if (sumw2)
+         sumw2[delta.first] += delta.second.second;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics and number of entries of a filler to the histogram.
+
+void TH1ConcurrentFillManager::AddStats(const Double_t *stats, Double_t entries)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   Double_t histStats[TH1::kNstat] = {0};
+   fHist->GetStats(histStats);
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      histStats[i] += stats[i];
+   fHist->PutStats(histStats);
+   fHist->SetEntries(fHist->GetEntries() + entries);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor, use TH1ConcurrentFillManager::MakeFiller().
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFillManager &manager) : fManager(&manager), fStats()
+{
+   if (fManager->fMode == TH1ConcurrentFillManager::EMode::kDeltaBuffer)
+      fDeltas.reserve(fManager->fBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move constructor, the moved-from filler does not fill anything anymore.
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+   : fManager(other.fManager), fDeltas(std::move(other.fDeltas)), fEntries(other.fEntries), fWeighted(other.fWeighted)
+{
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      fStats[i] = other.fStats[i];
+   other.fManager = nullptr;
+   other.fDeltas.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor, adds what was filled to the histogram.
+
+TH1ConcurrentFiller::~TH1ConcurrentFiller()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add weight `w` to global bin `bin`.
+
+void TH1ConcurrentFiller::FillBin(Int_t bin, Double_t w)
+{
+   fEntries += 1;
+   if (w != 1.)
+      fWeighted = kTRUE;
+
+   if (fManager->fMode == TH1ConcurrentFillManager::EMode::kAtomic) {
+      if (w != 1. && !fManager->fWeighted.load(std::memory_order_relaxed))
+         fManager->fWeighted = kTRUE;
+      // atomic<double>::fetch_add is C++20
+      auto add = [](std::atomic<Double_t> &a, Double_t v) {
+         Double_t old = a.load(std::memory_order_relaxed);
+         while (!a.compare_exchange_weak(old, old + v, std::memory_order_relaxed))
+            ;
+      };
+      add(fManager->fSumw[bin], w);
+      add(fManager->fSumw2[bin], w * w);
+      return;
+   }
+
+   auto &delta = fDeltas[bin];
+   delta.first += w;
+   delta.second += w * w;
+   if (fDeltas.size() >= fManager->fBufferSize) {
+      fManager->AddToHist(fDeltas, fWeighted);
+      fDeltas.clear();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Increment the bin of a 1-dimensional histogram corresponding to `x` by weight `w`.
+/// As for TH1::Fill, the function returns the bin number, or -1 if the entry does not
+/// enter the statistics.
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t w)
+{
+   if (!fManager || !fManager->fHist)
+      return -1;
+   if (fManager->fHist->GetDimension() != 1) {
+      Error("TH1ConcurrentFiller::Fill", "histogram %s has %d dimensions, use Fill(const Double_t *x, Double_t w)",
+            fManager->fHist->GetName(), fManager->fHist->GetDimension());
+      return -1;
+   }
+   return Fill(&x, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Increment the bin corresponding to the coordinates `x`, an array with as many values as the
+/// histogram has dimensions, by weight `w`.
+/// As for TH1::Fill, the function returns the global bin number, or -1 if the entry does not
+/// enter the statistics.
+
+Int_t TH1ConcurrentFiller::Fill(const Double_t *x, Double_t w)
+{
+   if (!fManager || !fManager->fHist)
+      return -1;
+   const TH1 &h = *fManager->fHist;
+   const Int_t dim = h.GetDimension();
+   const TAxis *axes[3] = {h.GetXaxis(), h.GetYaxis(), h.GetZaxis()};
+
+   Int_t bins[3] = {0, 0, 0};
+   Bool_t inRange = kTRUE;
+   for (Int_t d = 0; d < dim; ++d) {
+      bins[d] = axes[d]->FindFixBin(x[d]);
+      if (bins[d] == 0 || bins[d] > axes[d]->GetNbins())
+         inRange = kFALSE;
+   }
+   const Int_t bin = h.GetBin(bins[0], bins[1], bins[2]);
+   FillBin(bin, w);
+
+   if (!inRange && !h.GetStatOverflowsBehaviour())
+      return -1;
+   // same layout as TH1::GetStats, TH2::GetStats and TH3::GetStats
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x[0];
+   fStats[3] += w * x[0] * x[0];
+   if (dim > 1) {
+      fStats[4] += w * x[1];
+      fStats[5] += w * x[1] * x[1];
+      fStats[6] += w * x[0] * x[1];
+   }
+   if (dim > 2) {
+      fStats[7] += w * x[2];
+      fStats[8] += w * x[2] * x[2];
+      fStats[9] += w * x[0] * x[2];
+      fStats[10] += w * x[1] * x[2];
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bins collected in the delta buffer and the statistics to the histogram.
+/// In atomic mode, the bin contents are added to the histogram by TH1ConcurrentFillManager::Flush().
+
+void TH1ConcurrentFiller::Flush()
+{
+   if (!fManager || !fManager->fHist)
+      return;
+   if (!fDeltas.empty()) {
+      fManager->AddToHist(fDeltas, fWeighted);
+      fDeltas.clear();
+   }
+   if (fEntries > 0) {
+      fManager->AddStats(fStats, fEntries);
+      for (Int_t i = 0; i < TH1::kNstat; ++i)
+         fStats[i] = 0.;
+      fEntries = 0;
+   }
+   fWeighted = kFALSE;
+}
@@ -8,6 +8,14 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -16,6 +24,35 @@
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
           b->GetNbins());
 
+namespace {
+
+/// Number of cells summed at once by TH1Merger::MergeArrays(): all inputs are added to one
+/// chunk of the result before going to the next, such that the chunk stays in the cache.
+constexpr Int_t kMergeChunkSize = 8192;
+
+/// Minimum number of cells times number of inputs for which TH1Merger::MergeArrays()
+/// distributes the chunks over the implicit multi-threading pool.
+constexpr Long64_t kMinParallelMergeCells = 1 << 20;
+
+/// Add in[begin, end) to out[begin, end). There is no dependency between the iterations,
+/// such that the compiler vectorizes the loop.
+template <typename TOut, typename TIn>
+void AddArrayRange(TOut *out, const TIn *in, Int_t begin, Int_t end)
+{
+   for (Int_t i = begin; i < end; ++i)
+      out[i] += in[i];
+}
+
+/// Add the absolute values of in[begin, end) to out[begin, end), like AddArrayRange().
+template <typename TOut, typename TIn>
+void AddAbsArrayRange(TOut *out, const TIn *in, Int_t begin, Int_t end)
+{
+   for (Int_t i = begin; i < end; ++i)
+      out[i] += std::abs(in[i]);
+}
+
+} // anonymous namespace
+
 Bool_t TH1Merger::AxesHaveLimits(const TH1 * h) {
    Bool_t hasLimits = h->GetXaxis()->GetXmin() < h->GetXaxis()->GetXmax();
    if (h->GetDimension() > 1) hasLimits &=  h->GetYaxis()->GetXmin() < h->GetYaxis()->GetXmax();
@@ -794,6 +831,19 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   // consecutive histograms storing their content like fH0 are added array by array; they are merged
+   // before the next histogram that is merged bin by bin, such that every cell receives the inputs in order
+   std::vector<const TH1 *> arrayInputs;
+   auto mergeArrayInputs = [&]() {
+      if (arrayInputs.empty())
+         return;
+      if (dynamic_cast<TArrayD *>(fH0))
+         MergeArrays<TArrayD>(arrayInputs);
+      else
+         MergeArrays<TArrayF>(arrayInputs);
+      arrayInputs.clear();
+   };
+
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -811,12 +861,19 @@ Bool_t TH1Merger::SameAxesMerge() {
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
 
+      if (CanMergeArrays(hist)) {
+         arrayInputs.push_back(hist);
+         continue;
+      }
+      mergeArrayInputs();
+
          //Int_t nx = hist->GetXaxis()->GetNbins();
          // loop on bins of the histogram and do the merge
       for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
          MergeBin(hist, ibin, ibin);
       }
    }
+   mergeArrayInputs();
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -825,6 +882,63 @@ Bool_t TH1Merger::SameAxesMerge() {
 }
 
 
+/// Whether the cells of hist can be added to the ones of fH0 by MergeArrays(): both
+/// are of the same class, storing their content in a TArrayD or a TArrayF.
+/// Histograms with integer content are not merged this way, as their AddBinContent()
+/// saturates, nor are classes giving another meaning to the array, like TH1K.
+
+Bool_t TH1Merger::CanMergeArrays(const TH1 *hist) const
+{
+   if (fIsProfileMerge || hist->IsA() != fH0->IsA() || hist->fNcells != fH0->fNcells)
+      return kFALSE;
+   TClass *cl = fH0->IsA();
+   return cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class() || cl == TH1F::Class() ||
+          cl == TH2F::Class() || cl == TH3F::Class();
+}
+
+/// Add the cells of hists, which all have the same class as fH0, to the cells of fH0.
+/// The cells are summed in chunks, which are independent of each other and are
+/// distributed over the implicit multi-threading pool for large histograms. Every
+/// cell receives the inputs in the same order as with MergeBin(), so that the result
+/// is identical to the one of the bin by bin merge. As there, the inputs without
+/// sum of weights squared contribute the absolute value of their content to it.
+
+template <class TArrayType>
+void TH1Merger::MergeArrays(const std::vector<const TH1 *> &hists)
+{
+   auto out = dynamic_cast<TArrayType *>(fH0)->GetArray();
+   Double_t *outSumw2 = fH0->fSumw2.fN ? fH0->fSumw2.GetArray() : nullptr;
+   std::vector<decltype(dynamic_cast<const TArrayType *>(fH0)->GetArray())> in;
+   for (const TH1 *hist : hists)
+      in.push_back(dynamic_cast<const TArrayType *>(hist)->GetArray());
+
+   const Int_t ncells = fH0->fNcells;
+   const Int_t nchunks = (ncells + kMergeChunkSize - 1) / kMergeChunkSize;
+   auto mergeChunk = [&](Int_t ichunk) {
+      const Int_t begin = ichunk * kMergeChunkSize;
+      const Int_t end = std::min(begin + kMergeChunkSize, ncells);
+      for (std::size_t i = 0; i < hists.size(); ++i) {
+         AddArrayRange(out, in[i], begin, end);
+         if (!outSumw2)
+            continue;
+         if (hists[i]->fSumw2.fN)
+            AddArrayRange(outSumw2, hists[i]->fSumw2.GetArray(), begin, end);
+         else
+            AddAbsArrayRange(outSumw2, in[i], begin, end);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1 && Long64_t(ncells) * hists.size() >= kMinParallelMergeCells) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(mergeChunk, ROOT::TSeq<Int_t>(nchunks));
+      return;
+   }
+#endif
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk)
+      mergeChunk(ichunk);
+}
+
 /**
    Merged histogram when axis can be different.
    Histograms are merged looking at bin center positions
@@ -1139,7 +1253,7 @@ void TH1Merger::MergeBin(const TH1 *hist, Int_t ibin, Int_t cbin)
       Double_t cu = hist->RetrieveBinContent(ibin);
       fH0->AddBinContent(cbin, cu);
       if (fH0->fSumw2.fN) {
-         Double_t e1sq = (hist->fSumw2.fN) ? hist->GetBinErrorSqUnchecked(ibin) : cu;
+         Double_t e1sq = TMath::Abs(hist->GetBinErrorSqUnchecked(ibin));
          fH0->fSumw2.fArray[cbin] += e1sq;
       }
    } else {
@@ -17,6 +17,8 @@
 #include "TProfile3D.h"
 #include "TList.h"
 
+#include <vector>
+
 class TH1Merger {
 
 public:
@@ -115,6 +117,11 @@ private:
 
    Bool_t SameAxesMerge();
 
+   Bool_t CanMergeArrays(const TH1 *hist) const;
+
+   template <class TArrayType>
+   void MergeArrays(const std::vector<const TH1 *> &hists);
+
    Bool_t DifferentAxesMerge();
 
    Bool_t LabelMerge();
@@ -24,6 +24,7 @@
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "THFillHelper.h"
 
 ClassImp(TH3);
 
@@ -433,6 +434,102 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// If all the axes have fixed bins and cannot be extended, the bins of chunks of
+/// entries are computed at once. The result is the same as calling Fill for each entry.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   if (!THFillHelper::IsFixedAxis(fXaxis) || !THFillHelper::IsFixedAxis(fYaxis) || !THFillHelper::IsFixedAxis(fZaxis)) {
+      for (i=ifirst;i<ntimes;i+=stride) {
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      return;
+   }
+
+   Int_t binsx[THFillHelper::kChunkSize], binsy[THFillHelper::kChunkSize], binsz[THFillHelper::kChunkSize];
+   const Int_t nbinsx = fXaxis.GetNbins(), nbinsy = fYaxis.GetNbins(), nbinsz = fZaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+   Double_t tsumwz = fTsumwz, tsumwz2 = fTsumwz2, tsumwxz = fTsumwxz, tsumwyz = fTsumwyz;
+   Double_t ww = 1;
+   const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+   for (Int_t first = 0; first < nentries; first += THFillHelper::kChunkSize) {
+      const Int_t n = TMath::Min(THFillHelper::kChunkSize, nentries - first);
+      const Int_t offset = ifirst + first * stride;
+      THFillHelper::FindFixedBins(fXaxis, n, x + offset, stride, binsx);
+      THFillHelper::FindFixedBins(fYaxis, n, y + offset, stride, binsy);
+      THFillHelper::FindFixedBins(fZaxis, n, z + offset, stride, binsz);
+      fEntries += n;
+      for (Int_t j = 0; j < n; ++j) {
+         i = offset + j * stride;
+         const Int_t binx = binsx[j], biny = binsy[j], binz = binsz[j];
+         const Int_t bin = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();   // must be called before AddBinContent
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if ((binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy || binz == 0 || binz > nbinsz) && !statOverflows)
+            continue;
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*x[i];
+         tsumwx2 += ww*x[i]*x[i];
+         tsumwy  += ww*y[i];
+         tsumwy2 += ww*y[i]*y[i];
+         tsumwxy += ww*x[i]*y[i];
+         tsumwz  += ww*z[i];
+         tsumwz2 += ww*z[i]*z[i];
+         tsumwxz += ww*x[i]*z[i];
+         tsumwyz += ww*y[i]*z[i];
+      }
+   }
+   fTsumw   = tsumw;
+   fTsumw2  = tsumw2;
+   fTsumwx  = tsumwx;
+   fTsumwx2 = tsumwx2;
+   fTsumwy  = tsumwy;
+   fTsumwy2 = tsumwy2;
+   fTsumwxy = tsumwxy;
+   fTsumwz  = tsumwz;
+   fTsumwz2 = tsumwz2;
+   fTsumwxz = tsumwxz;
+   fTsumwyz = tsumwyz;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
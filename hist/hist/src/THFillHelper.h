@@ -0,0 +1,58 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THFillHelper
+#define ROOT_THFillHelper
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THFillHelper                                                         //
+//                                                                      //
+// Helpers for the batched filling of histograms (TH1::FillN,           //
+// TH2::FillN, TH3::FillN) with fixed bin width axes.                   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TAxis.h"
+
+namespace THFillHelper {
+
+/// Number of entries for which the bins are computed at once
+constexpr Int_t kChunkSize = 256;
+
+/// Whether the bins of the axis can be computed by FindFixedBins rather than TAxis::FindBin:
+/// the bins have a fixed width and the axis is never extended.
+inline Bool_t IsFixedAxis(const TAxis &axis)
+{
+   return axis.GetXbins()->fN == 0 && !axis.CanExtend();
+}
+
+/// Compute the bin numbers of the n values x[0], x[stride], ... on a fixed bin axis.
+/// The result is the same as the one of TAxis::FindBin, including NaN going into the overflow bin,
+/// but the loop has no branches, such that the compiler can vectorize it.
+inline void FindFixedBins(const TAxis &axis, Int_t n, const Double_t *x, Int_t stride, Int_t *bins)
+{
+   const Double_t xmin = axis.GetXmin();
+   const Double_t xmax = axis.GetXmax();
+   const Int_t nbins = axis.GetNbins();
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t xi = x[i * stride];
+      const Bool_t under = xi < xmin;
+      const Bool_t inRange = !under && xi < xmax;
+      // clamp such that the conversion to int is always defined
+      const Double_t xc = inRange ? xi : xmin;
+      const Int_t bin = 1 + int(nbins * (xc - xmin) / (xmax - xmin));
+      bins[i] = inRange ? bin : (under ? 0 : nbins + 1);
+   }
+}
+
+} // namespace THFillHelper
+
+#endif
@@ -11,6 +11,14 @@
 
 #include "THn.h"
 
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+
 namespace {
    //______________________________________________________________________________
    //
@@ -244,6 +252,92 @@ void THn::InitStorage(Int_t* nbins, Int_t /*chunkSize*/)
    fSumw2.Init(fNdimensions, nbins, true /*addOverflow*/);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge this with a list of THnBase objects.
+/// THn objects with the same number of bins on each axis are added with
+/// AddSameLayout(); all others as done by THnBase::Add().
+
+Long64_t THn::Merge(TCollection* list)
+{
+   if (!list) return 0;
+   if (list->IsEmpty()) return (Long64_t)GetEntries();
+
+   std::vector<const THn*> sameLayout;
+   TIter iter(list);
+   const TObject* addMeObj = 0;
+   while ((addMeObj = iter())) {
+      const THnBase* addMe = dynamic_cast<const THnBase*>(addMeObj);
+      if (!addMe) {
+         Error("Merge", "Object named %s is not THnBase! Skipping it.",
+               addMeObj->GetName());
+         continue;
+      }
+      if (!CheckConsistency(addMe, "Merge"))
+         continue;
+      const THn* addMeDense = dynamic_cast<const THn*>(addMe);
+      if (addMeDense)
+         sameLayout.push_back(addMeDense);
+      else
+         AddInternal(addMe, 1., kFALSE);
+   }
+   AddSameLayout(sameLayout);
+   return (Long64_t)GetEntries();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the histograms hists, which have the same number of bins on each axis
+/// as this one, such that their bins are stored in the same order.
+/// The bin arrays are summed in chunks, all histograms being added to a chunk
+/// before going to the next one; for large histograms the chunks are
+/// distributed over the implicit multi-threading pool.
+
+void THn::AddSameLayout(const std::vector<const THn*>& hists)
+{
+   if (hists.empty()) return;
+
+   // Trigger error calculation if one of hists has it
+   Bool_t haveErrors = GetCalculateErrors();
+   for (const THn* h: hists)
+      haveErrors |= h->GetCalculateErrors();
+   if (haveErrors && !GetCalculateErrors())
+      Sumw2();
+
+   // Allocate the storage before it is shared by the chunks
+   TNDArray& content = GetArray();
+   content.AddAt(0, 0.);
+   if (haveErrors)
+      fSumw2.AddAt(0, 0.);
+
+   const Long64_t nbins = GetNbins();
+   const Long64_t chunkSize = 8192;
+   const Long64_t nchunks = (nbins + chunkSize - 1) / chunkSize;
+   auto addChunk = [&](Long64_t ichunk) {
+      const Long64_t begin = ichunk * chunkSize;
+      const Long64_t end = std::min(begin + chunkSize, nbins);
+      for (const THn* h: hists) {
+         // without errors, the squared error of a bin is its content
+         if (haveErrors)
+            fSumw2.AddRange(h->GetCalculateErrors() ? (const TNDArray&)h->fSumw2 : h->GetArray(), begin, end);
+         content.AddRange(h->GetArray(), begin, end);
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1 && nbins * (Long64_t)hists.size() >= (1 << 20)) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(addChunk, ROOT::TSeq<Long64_t>(nchunks));
+   } else
+#endif
+   {
+      for (Long64_t ichunk = 0; ichunk < nchunks; ++ichunk)
+         addChunk(ichunk);
+   }
+
+   Double_t nEntries = GetEntries();
+   for (const THn* h: hists)
+      nEntries += h->GetEntries();
+   SetEntries(nEntries);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the contents of a THn.
 
@@ -15,6 +15,13 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <vector>
 
 namespace {
 //______________________________________________________________________________
@@ -270,9 +277,10 @@ ULong64_t THnSparseCoordCompression::GetHashFromCoords(const Int_t* coord) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
-   // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // If it does, we use it directly as the hash: distinct bins never
+   // share a hash in the open-addressing table fBins.
+   // If not we build a hash from the compact bin index; bins with the
+   // same hash are told apart by comparing their compact coordinates.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -318,9 +326,10 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
-   // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // If it does, we use it directly as the hash: distinct bins never
+   // share a hash in the open-addressing table fBins.
+   // If not we build a hash from the compact bin index; bins with the
+   // same hash are told apart by comparing their compact coordinates.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -488,6 +497,66 @@ void THnSparseArrayChunk::Sumw2()
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all entries and release the memory
+
+void THnSparseHashTable::Clear()
+{
+   std::vector<ULong64_t>().swap(fKeys);
+   std::vector<Long64_t>().swap(fValues);
+   fSize = 0;
+   fMask = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin index "value" for "hash", which must not be in the table yet.
+/// The table is grown such that at most half of the slots are occupied.
+
+void THnSparseHashTable::Insert(ULong64_t hash, Long64_t value)
+{
+   if (2 * (ULong64_t)(fSize + 1) > fKeys.size())
+      Rehash(fKeys.empty() ? 16 : 2 * fKeys.size());
+   ULong64_t slot = FirstSlot(hash);
+   while (fValues[slot] >= 0)
+      slot = NextSlot(slot);
+   fKeys[slot] = hash;
+   fValues[slot] = value;
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for n entries without further growing of the table
+
+void THnSparseHashTable::Reserve(Long64_t n)
+{
+   ULong64_t nslots = 16;
+   while (nslots < 2 * (ULong64_t)n)
+      nslots *= 2;
+   if (nslots > fKeys.size())
+      Rehash(nslots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move all entries into a table of nslots slots, a power of two
+
+void THnSparseHashTable::Rehash(ULong64_t nslots)
+{
+   std::vector<ULong64_t> keys(nslots);
+   std::vector<Long64_t> values(nslots, -1);
+   fKeys.swap(keys);
+   fValues.swap(values);
+   fMask = nslots - 1;
+   for (ULong64_t i = 0; i < keys.size(); ++i) {
+      if (values[i] < 0)
+         continue;
+      ULong64_t slot = FirstSlot(keys[i]);
+      while (fValues[slot] >= 0)
+         slot = NextSlot(slot);
+      fKeys[slot] = keys[i];
+      fValues[slot] = values[i];
+   }
+}
+
 
 /** \class THnSparse
     \ingroup Hist
@@ -569,15 +638,22 @@ chunk is represented by an object of class THnSparseArrayChunk.
 Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
-if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+if it takes less than 8 bytes, the size of a Long64_t).
+This hash is used to lookup the linear index in the open-addressing hash
+table fBins (a THnSparseHashTable), which stores the hashes and linear
+indexes in two flat arrays. Slots are probed linearly, starting from a
+mixed version of the hash, until an empty slot is reached. For each slot
+with the same hash, the coordinates of the bin it points to are compared to
+the coordinates passed to GetBin(): if the compact coordinates are larger
+than 8 bytes, two different coordinates can have the same hash.
+
+## Merging
+Merge() matches the bins of THnSparse objects with the same number of bins
+on each axis on their compact coordinates, without decoding them. The
+lookup of the bins in this histogram runs in parallel over the chunks of
+the added histogram if implicit multi-threading is enabled. The hash table
+grows with the bins actually added, instead of being sized for the sum of
+the bins of all merged histograms.
 */
 
 
@@ -652,34 +728,20 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 ////////////////////////////////////////////////////////////////////////////////
 ///We have been streamed; set up fBins
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinIndex()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
-   THnSparseCoordCompression compactCoord(*GetCompactCoord());
+   const THnSparseCompactBinCoord* compactCoord = GetCompactCoord();
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
-      Char_t* buf = chunk->fCoordinates;
+      const Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBins.Insert(compactCoord->GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -687,12 +749,10 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   if (fBins.IsEmpty() && fBinContent.GetEntriesFast()) {
+      FillBinIndex();
    }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -783,29 +843,25 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the index for fCurrentBinIndex.
-/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+/// Return the linear index of the bin with compact coordinate buf and its hash,
+/// or -1 if the bin is not filled. fBins must be set up.
 
-Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+Long64_t THnSparse::FindBinIndex(ULong64_t hash, const Char_t* buf) const
 {
-   THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
+   for (ULong64_t slot = fBins.FirstSlot(hash); ; slot = fBins.NextSlot(slot)) {
+      const Long64_t linidx = fBins.GetValue(slot);
+      if (linidx < 0)
+         return -1;
+      if (fBins.GetKey(slot) == hash && GetChunk(linidx / fChunkSize)->Matches(linidx % fChunkSize, buf))
+         return linidx;
    }
-   if (!allocate) return -1;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a new bin with compact coordinate buf and its hash, return its linear index.
+
+Long64_t THnSparse::AllocateBin(ULong64_t hash, const Char_t* buf)
+{
    ++fFilledBins;
 
    // allocate bin in chunk
@@ -815,23 +871,29 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, buf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBins.Insert(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index for fCurrentBinIndex.
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+
+Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+{
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   if (fBins.IsEmpty() && fBinContent.GetEntriesFast())
+      FillBinIndex();
+   const Long64_t linidx = FindBinIndex(cc->GetHash(), cc->GetBuffer());
+   if (linidx >= 0 || !allocate)
+      return linidx;
+   return AllocateBin(cc->GetHash(), cc->GetBuffer());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -880,7 +942,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += (sizeof(ULong64_t) + sizeof(Long64_t)) * fBins.GetCapacity() /* fBins */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -956,14 +1018,106 @@ void THnSparse::Sumw2()
       chunk->Sumw2();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bins of h, which has the same number of bins on each axis, to this
+/// histogram. The bins are matched on their compact coordinates.
+
+void THnSparse::AddSparse(const THnSparse* h)
+{
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+   const Bool_t haveErrors = GetCalculateErrors();
+
+   if (fBins.IsEmpty() && fBinContent.GetEntriesFast())
+      FillBinIndex();
+
+   const THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t coordSize = cc->GetBufferSize();
+   const Int_t nchunks = h->GetNChunks();
+   const Long64_t hChunkSize = h->GetChunkSize();
+
+   // Look up the bins of h in this histogram; the lookups only read fBins and
+   // the chunks, such that the chunks of h can be processed in parallel.
+   std::vector<Long64_t> myBins(h->GetNbins(), -1);
+   auto findChunk = [&](Int_t ichunk) {
+      const THnSparseArrayChunk* chunk = h->GetChunk(ichunk);
+      const Int_t n = chunk->GetEntries();
+      for (Int_t i = 0; i < n; ++i) {
+         const Char_t* buf = chunk->fCoordinates + i * coordSize;
+         myBins[ichunk * hChunkSize + i] = FindBinIndex(cc->GetHashFromBuffer(buf), buf);
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1 && !fBins.IsEmpty()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(findChunk, ROOT::TSeq<Int_t>(nchunks));
+   } else
+#endif
+   if (!fBins.IsEmpty()) {
+      for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk)
+         findChunk(ichunk);
+   }
+
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+      const THnSparseArrayChunk* chunk = h->GetChunk(ichunk);
+      const Int_t n = chunk->GetEntries();
+      for (Int_t i = 0; i < n; ++i) {
+         const Long64_t hbin = ichunk * hChunkSize + i;
+         Long64_t mybin = myBins[hbin];
+         if (mybin < 0) {
+            const Char_t* buf = chunk->fCoordinates + i * coordSize;
+            mybin = AllocateBin(cc->GetHashFromBuffer(buf), buf);
+         }
+         const Double_t v = chunk->fContent->GetAt(i);
+         if (haveErrors)
+            AddBinError2(mybin, chunk->fSumw2 ? chunk->fSumw2->GetAt(i) : v);
+         AddBinContent(mybin, v);
+      }
+   }
+
+   SetEntries(GetEntries() + h->GetEntries());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge this with a list of THnBase objects.
+/// THnSparse objects with the same number of bins on each axis are added with
+/// AddSparse(); all others as done by THnBase::Add().
+/// In contrast to THnBase::Merge(), the storage is not reserved for the sum of
+/// the bins of all histograms, which overestimates it if they share bins.
+
+Long64_t THnSparse::Merge(TCollection* list)
+{
+   if (!list) return 0;
+   if (list->IsEmpty()) return (Long64_t)GetEntries();
+
+   TIter iter(list);
+   const TObject* addMeObj = 0;
+   while ((addMeObj = iter())) {
+      const THnBase* addMe = dynamic_cast<const THnBase*>(addMeObj);
+      if (!addMe) {
+         Error("Merge", "Object named %s is not THnBase! Skipping it.",
+               addMeObj->GetName());
+         continue;
+      }
+      if (!CheckConsistency(addMe, "Merge"))
+         continue;
+      const THnSparse* addMeSparse = dynamic_cast<const THnSparse*>(addMe);
+      if (addMeSparse && addMeSparse->GetCompactCoord()->GetBufferSize() == GetCompactCoord()->GetBufferSize())
+         AddSparse(addMeSparse);
+      else
+         AddInternal(addMe, 1., kFALSE);
+   }
+   return (Long64_t)GetEntries();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear the histogram
 
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -22,6 +22,13 @@
 
  The algorithm is briefly described in (4). A binned version is also implemented to address the
  performance issue due to its data size dependance.
+
+ With the `Binning:FFTBinning` option the events are distributed linearly onto a grid of equidistant
+ points and are not kept. The estimate is computed on the grid by a convolution of the grid with the
+ kernel, done with a fast Fourier transform, and is interpolated linearly between the grid points.
+ The cost of an evaluation does not depend on the number of events, which can be added at any time
+ with Fill() or FillN(); the range must then be known before the first event. Only the fixed
+ iteration is supported with this option.
  */
 
 
@@ -31,6 +38,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -46,6 +54,47 @@
 
 ClassImp(TKDE);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// In-place radix-2 fast Fourier transform of a sequence whose length is a power of 2.
+/// The inverse transform includes the normalization by the length.
+
+void FFTRadix2(std::vector<std::complex<Double_t>> &a, Bool_t inverse)
+{
+   const std::size_t n = a.size();
+   // bit reversal permutation
+   for (std::size_t i = 1, j = 0; i < n; ++i) {
+      std::size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+      if (i < j)
+         std::swap(a[i], a[j]);
+   }
+   std::vector<std::complex<Double_t>> twiddles;
+   for (std::size_t len = 2; len <= n; len <<= 1) {
+      const Double_t angle = (inverse ? 2. : -2.) * TMath::Pi() / len;
+      twiddles.resize(len / 2);
+      for (std::size_t k = 0; k < len / 2; ++k)
+         twiddles[k] = std::polar(1., angle * k);
+      for (std::size_t i = 0; i < n; i += len) {
+         for (std::size_t k = 0; k < len / 2; ++k) {
+            const std::complex<Double_t> u = a[i + k];
+            const std::complex<Double_t> v = a[i + k + len / 2] * twiddles[k];
+            a[i + k] = u + v;
+            a[i + k + len / 2] = u - v;
+         }
+      }
+   }
+   if (inverse) {
+      for (auto &x : a)
+         x /= Double_t(n);
+   }
+}
+
+} // anonymous namespace
+
 
 struct TKDE::KernelIntegrand {
    enum EIntegralResult{kNorm, kMu, kSigma2, kUnitIntegration};
@@ -70,7 +119,7 @@ TKDE::TKDE() :
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
    fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
-   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
+   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0), fSumOfX(0.), fSumOfX2(0.)
 {
 }
 
@@ -111,6 +160,8 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fAdaptiveBandwidthFactor = 1.;
    fRho = rho;
    fWeightSize = 0;
+   fSumOfX = 0;
+   fSumOfX2 = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
    fSettedOptions = std::vector<Bool_t>(4, kFALSE);
@@ -259,9 +310,11 @@ void TKDE::GetOptions(std::string optionType, std::string option) {
          fBinning = kRelaxedBinning;
       } else if (option.compare("forcedbinning") == 0) {
          fBinning = kForcedBinning;
+      } else if (option.compare("fftbinning") == 0) {
+         fBinning = kFFTBinning;
       } else {
          this->Warning("GetOptions", "Unknown binning option %s: setting to RelaxedBinning", option.c_str());
-         this->Info("GetOptions", "Possible binning type options are: Unbinned, ForcedBinning, RelaxedBinning");
+         this->Info("GetOptions", "Possible binning type options are: Unbinned, ForcedBinning, RelaxedBinning, FFTBinning");
          fBinning = kRelaxedBinning;
       }
    }
@@ -273,7 +326,8 @@ void TKDE::AssureOptions() {
       fKernelType = kGaussian;
    }
    if (!fSettedOptions[1]) {
-      fIteration = kAdaptive;
+      // the adaptive iteration is not available with the FFT binning
+      fIteration = (fSettedOptions[3] && fBinning == kFFTBinning) ? kFixed : kAdaptive;
    }
    if (!fSettedOptions[2]) {
       fMirror = kNoMirror;
@@ -296,10 +350,14 @@ void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
       Warning("CheckOptions", "Illegal user mirroring type input - use default value !");
       fMirror = kNoMirror;
    }
-   if (!(fBinning >= kUnbinned && fBinning <= kForcedBinning)) {
+   if (!(fBinning >= kUnbinned && fBinning <= kFFTBinning)) {
       Warning("CheckOptions", "Illegal user binning type input - use default value !");
       fBinning = kRelaxedBinning;
    }
+   if (fBinning == kFFTBinning && fIteration == kAdaptive) {
+      Warning("CheckOptions", "Adaptive iteration is not supported with the FFT binning - use fixed iteration !");
+      fIteration = kFixed;
+   }
    if (fRho <= 0.0) {
       Warning("CheckOptions", "Tuning factor rho cannot be non-positive - use default value !");
       fRho = 1.0;
@@ -330,7 +388,8 @@ void TKDE::SetMirror(EMirror mir) {
    fMirror = mir;
    CheckOptions();
    SetMirror();
-   if (fUseMirroring) {
+   // with the FFT binning the mirrored grid is built by ComputeGridDensity
+   if (fUseMirroring && fBinning != kFFTBinning) {
       SetMirroredEvents();
    }
    fKernel.reset();
@@ -338,6 +397,10 @@ void TKDE::SetMirror(EMirror mir) {
 
 void TKDE::SetBinning(EBinning bin) {
    // Sets User option for binning the weights
+   if (fBinning == kFFTBinning && bin != kFFTBinning && fEvents.empty() && fNEvents > 0) {
+      Error("SetBinning", "The events filled with the FFT binning are not kept and cannot be binned differently.");
+      return;
+   }
    fBinning = bin;
    CheckOptions();
    SetUseBins();
@@ -349,11 +412,15 @@ void TKDE::SetNBins(UInt_t nbins) {
       Error("SetNBins", "Number of bins must be greater than zero.");
       return;
    }
+   if (fBinning == kFFTBinning && fEvents.empty() && fNEvents > 0) {
+      Error("SetNBins", "The grid of the FFT binning cannot be changed after filling.");
+      return;
+   }
 
    fNBins = nbins;
 
    SetUseBins();
-   if (!fUseBins) {
+   if (!fUseBins && fBinning != kFFTBinning) {
       if (fBinning == kUnbinned)
          Warning("SetNBins", "Bin type using SetBinning must be set for using a binned evaluation");
       else
@@ -383,9 +450,16 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
       Error("SetRange", "Minimum range cannot be bigger or equal than the maximum range! Present range values remain the same.");
       return;
    }
+   if (fBinning == kFFTBinning && fEvents.empty() && fNEvents > 0) {
+      Error("SetRange", "The grid of the FFT binning cannot be changed after filling.");
+      return;
+   }
    fXMin = xMin;
    fXMax = xMax;
    fUseMinMaxFromData = false;
+   // rebuild the grid
+   if (fBinning == kFFTBinning)
+      SetUseBins();
    fKernel.reset();
 }
 
@@ -406,9 +480,25 @@ void TKDE::SetUseBins() {
          fUseBins = kTRUE;
          break;
       case kUnbinned:
+      case kFFTBinning:
          fUseBins = kFALSE;
    }
 
+   if (fBinning == kFFTBinning) {
+      // the grid is rebuilt from the events when they are kept (the binning was changed);
+      // otherwise it can only be rebuilt while it is still empty
+      if (!fEvents.empty() || fNEvents == 0) {
+         InitGrid();
+         if (!fEvents.empty())
+            FillN(fEvents.size(), fEvents.data(), fEventWeights.empty() ? nullptr : fEventWeights.data());
+      }
+      fWeightSize = 0.;
+      fBinCount.clear();
+      fData.clear();
+      fKernel.reset();
+      return;
+   }
+
    // during initialization we don't need to recompute the bins
    // it is done within TKDE::SetData
    // in this case fEvents is empty
@@ -441,6 +531,18 @@ void TKDE::SetMirror() {
 
 void TKDE::SetData(const Double_t* data, const Double_t* wgts) {
    // Sets the data events input sample or bin centres for binned option and computes basic estimators
+   if (fBinning == kFFTBinning) {
+      // the events are only accumulated on the grid
+      const UInt_t nevents = fNEvents;
+      if (data && nevents && fUseMinMaxFromData) {
+         fXMin = *std::min_element(data, data + nevents);
+         fXMax = *std::max_element(data, data + nevents);
+      }
+      InitGrid();
+      if (data)
+         FillN(nevents, data, wgts);
+      return;
+   }
    if (!data) {
       if (fNEvents) fData.reserve(fNEvents);
       return;
@@ -484,6 +586,18 @@ void TKDE::ReInit() {
       return;
    }
 
+   if (fBinning == kFFTBinning) {
+      if (fSumOfCounts <= 0) {
+         Error("ReInit","TKDE does not contain any data in its range !");
+         return;
+      }
+      if (!fKernelFunction)
+         SetKernelFunction(nullptr);
+      else
+         SetKernel();
+      return;
+   }
+
    if (fEvents.size() == 0) {
       Error("ReInit","TKDE does not contain any data !");
       return;
@@ -599,13 +713,19 @@ void TKDE::SetKernel() {
    // it should not be fData.size() that in binned case is number of bins
    UInt_t n =  (fUseBins) ? fNBins : fNEvents;
    if (n == 0) return;
+   if (fBinning == kFFTBinning) {
+      if (fSumOfCounts <= 0) return;
+      ComputeGridStats();
+   }
    // Optimal bandwidth (Silverman's rule of thumb with assumed Gaussian density)
    Double_t weight = fCanonicalBandwidths[kGaussian] * fSigmaRob * std::pow(3. / (8. * std::sqrt(M_PI)) * n, -0.2);
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
 
    fKernel = std::make_unique<TKernel>(weight, this);
 
-   if (fIteration == kAdaptive) {
+   if (fBinning == kFFTBinning) {
+      ComputeGridDensity();
+   } else if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
    if (gDebug) {
@@ -712,6 +832,11 @@ TF1* TKDE::GetApproximateBias(UInt_t npx, Double_t xMin, Double_t xMax) {
 
 void TKDE::Fill(Double_t data) {
    // Fills data member with User input data event for the unbinned option
+   // or adds it to the grid for the FFT binning option
+   if (fBinning == kFFTBinning) {
+      FillN(1, &data);
+      return;
+   }
    if (fUseBins) {
       this->Warning("Fill", "Cannot fill data with data binned option. Data input ignored.");
       return;
@@ -723,6 +848,11 @@ void TKDE::Fill(Double_t data) {
 
 void TKDE::Fill(Double_t data, Double_t weight) {
    // Fills data member with User input data event for the unbinned option
+   // or adds it to the grid for the FFT binning option
+   if (fBinning == kFFTBinning) {
+      FillN(1, &data, &weight);
+      return;
+   }
    if (fUseBins) {
       this->Warning("Fill", "Cannot fill data with data binned option. Data input ignored.");
       return;
@@ -733,6 +863,27 @@ void TKDE::Fill(Double_t data, Double_t weight) {
    fNewData = kTRUE;
 }
 
+void TKDE::FillN(UInt_t n, const Double_t* data, const Double_t* weights) {
+   // Fills n data events, weighted if weights is given. With the FFT binning option the
+   // events are added to the grid; the estimate is recomputed at the next evaluation.
+   if (fBinning != kFFTBinning) {
+      for (UInt_t i = 0; i < n; ++i) {
+         if (weights)
+            Fill(data[i], weights[i]);
+         else
+            Fill(data[i]);
+      }
+      return;
+   }
+   if (fGridCounts.empty()) {
+      this->Warning("FillN", "The range must be set with SetRange before filling with the FFT binning option. Data input ignored.");
+      return;
+   }
+   for (UInt_t i = 0; i < n; ++i)
+      FillGrid(data[i], weights ? weights[i] : 1.);
+   fKernel.reset();
+}
+
 Double_t TKDE::operator()(const Double_t* x, const Double_t*) const {
    // The class's unary function: returns the kernel density estimate
    return (*this)(*x);
@@ -745,18 +896,22 @@ Double_t TKDE::operator()(Double_t x) const {
       // in case of failed re-initialization
       if (!fKernel) return TMath::QuietNaN();
    }
+   if (fBinning == kFFTBinning)
+      return GetGridDensity(x);
    return (*fKernel)(x);
 }
 
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   if (fBinning == kFFTBinning) (const_cast<TKDE*>(this))->ComputeGridStats();
    return fMean;
 }
 
 Double_t TKDE::GetSigma() const {
    // return the standard deviation  of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   if (fBinning == kFFTBinning) (const_cast<TKDE*>(this))->ComputeGridStats();
    return fSigma;
 }
 
@@ -813,6 +968,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
 
 Double_t TKDE::TKernel::GetWeight(Double_t x) const {
    // Returns the bandwidth
+   if (fWeights.size() == 1) return fWeights[0];
    return fWeights[fKDE->Index(x)];
 }
 
@@ -878,6 +1034,124 @@ void TKDE::SetBinCountData() {
    }
 }
 
+void TKDE::InitGrid() {
+   // Creates the empty grid of the FFT binning option: fNBins equidistant points from fXMin to fXMax
+   fGridCounts.clear();
+   fGridDensity.clear();
+   fNEvents = 0;
+   fSumOfCounts = 0;
+   fSumOfX = 0;
+   fSumOfX2 = 0;
+   if (fXMin >= fXMax) return;
+   fGridCounts.assign(std::max(fNBins, 2u), 0.0);
+}
+
+void TKDE::FillGrid(Double_t x, Double_t w) {
+   // Adds the event x with weight w to the grid, shared between its two neighbouring
+   // grid points in proportion to its distance to them (linear binning).
+   // As for the binned option, only the events in the range are used; they are also
+   // the only ones counted in fNEvents, which enters the bandwidth.
+   if (!(x >= fXMin && x <= fXMax)) return;
+   const UInt_t last = fGridCounts.size() - 1;
+   const Double_t t = (x - fXMin) / (fXMax - fXMin) * last;
+   const UInt_t j = std::min(UInt_t(t), last - 1);
+   const Double_t frac = t - j;
+   fGridCounts[j] += w * (1. - frac);
+   fGridCounts[j + 1] += w * frac;
+   fSumOfCounts += w;
+   fSumOfX += w * x;
+   fSumOfX2 += w * x * x;
+   fNEvents++;
+}
+
+void TKDE::ComputeGridStats() {
+   // Computes mean, standard deviation and its robust estimate from the events of the
+   // FFT binning option. The quartiles are taken from the grid, each grid point
+   // standing for an interval of one grid spacing around it.
+   if (fSumOfCounts <= 0) return;
+   fMean = fSumOfX / fSumOfCounts;
+   fSigma = std::sqrt(std::max(0., fSumOfX2 / fSumOfCounts - fMean * fMean));
+   const UInt_t m = fGridCounts.size();
+   const Double_t delta = (fXMax - fXMin) / (m - 1);
+   const Double_t prob[2] = {0.25, 0.75};
+   Double_t quantiles[2] = {fXMax, fXMax};
+   Double_t sum = 0;
+   UInt_t iq = 0;
+   for (UInt_t j = 0; j < m && iq < 2; ++j) {
+      const Double_t next = sum + fGridCounts[j];
+      while (iq < 2 && next >= prob[iq] * fSumOfCounts) {
+         const Double_t frac = (fGridCounts[j] > 0) ? (prob[iq] * fSumOfCounts - sum) / fGridCounts[j] : 0.;
+         quantiles[iq] = fXMin + (j - 0.5 + frac) * delta;
+         ++iq;
+      }
+      sum = next;
+   }
+   fSigmaRob = std::min(fSigma, (quantiles[1] - quantiles[0]) / 1.349); // Sigma's robust estimator
+}
+
+void TKDE::ComputeGridDensity() {
+   // Computes the estimate on the grid points of the FFT binning option, as the convolution
+   // of the grid counts with the kernel evaluated at the grid spacing. The convolution is
+   // done by FFT, on a grid padded by the kernel support to avoid wrapping around. With
+   // mirroring, the counts reflected at the range limits are added to the padded grid.
+   // The estimate is kept on the grid extended by the kernel support on both sides.
+   fGridDensity.clear();
+   const Double_t h = fKernel->GetFixedWeight();
+   if (!(h > 0)) return;
+   const Int_t m = fGridCounts.size();
+   const Double_t delta = (fXMax - fXMin) / (m - 1);
+   // number of grid spacings in the kernel support: the user defined kernels are
+   // assumed to vanish beyond the range from the grid
+   Int_t nk = m - 1;
+   if (fKernelType != kUserDefined) {
+      const Double_t support = (fKernelType == kGaussian) ? 9. : 1.;
+      nk = std::min(Double_t(4 * m), std::ceil(support * h / delta));
+   }
+   const Bool_t left = fMirrorLeft || fAsymLeft;
+   const Bool_t right = fMirrorRight || fAsymRight;
+   const Int_t offset = left ? m - 1 : 0;
+   const Int_t nMirrored = offset + m + (right ? m - 1 : 0);
+   Int_t nfft = 1;
+   while (nfft < nMirrored + 2 * nk)
+      nfft <<= 1;
+
+   std::vector<std::complex<Double_t>> counts(nfft);
+   std::vector<std::complex<Double_t>> kernel(nfft);
+   for (Int_t j = 0; j < m; ++j) {
+      counts[offset + j] += fGridCounts[j];
+      if (left)
+         counts[offset - j] += fGridCounts[j];
+      if (right)
+         counts[offset + 2 * (m - 1) - j] += fGridCounts[j];
+   }
+   for (Int_t i = -nk; i <= nk; ++i)
+      kernel[(i + nfft) % nfft] = (*fKernelFunction)(i * delta / h);
+
+   FFTRadix2(counts, kFALSE);
+   FFTRadix2(kernel, kFALSE);
+   for (Int_t i = 0; i < nfft; ++i)
+      counts[i] *= kernel[i];
+   FFTRadix2(counts, kTRUE);
+
+   const Double_t norm = 1. / (fSumOfCounts * h);
+   fGridDensity.resize(m + 2 * nk);
+   for (Int_t i = 0; i < m + 2 * nk; ++i)
+      fGridDensity[i] = counts[(offset - nk + i + nfft) % nfft].real() * norm;
+}
+
+Double_t TKDE::GetGridDensity(Double_t x) const {
+   // Returns the estimate of the FFT binning option, interpolated linearly between the grid points
+   if (fGridDensity.empty()) return TMath::QuietNaN();
+   const Int_t m = fGridCounts.size();
+   const Int_t nk = (fGridDensity.size() - m) / 2;
+   const Int_t last = fGridDensity.size() - 1;
+   const Double_t t = (x - fXMin) / (fXMax - fXMin) * (m - 1) + nk;
+   if (!(t >= 0 && t <= last)) return 0.;
+   const Int_t i = std::min(Int_t(t), last - 1);
+   const Double_t frac = t - i;
+   return (1. - frac) * fGridDensity[i] + frac * fGridDensity[i + 1];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  Draws either the KDE functions or its errors
 //    @param opt  : Drawing options:
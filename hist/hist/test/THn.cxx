@@ -1,8 +1,14 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+#include "TROOT.h"
+
+#include <map>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +117,177 @@ TEST(THn, Projection) {
    }
 
 }
+
+
+namespace {
+
+// Compact coordinates of 12 x 7 bits do not fit into 8 bytes: bins are found through their hash.
+const Int_t kSparseDim = 12;
+
+void FillSparse(THnSparse &h, Int_t first, Int_t last)
+{
+   Double_t x[kSparseDim];
+   for (Int_t i = first; i < last; ++i) {
+      for (Int_t d = 0; d < kSparseDim; ++d)
+         x[d] = ((i * (d + 3) * 7919) % 1000) / 10. * (i % 2 ? 1 : d % 3);
+      h.Fill(x, 1 + i % 4);
+   }
+}
+
+void ExpectEqualSparse(const THnSparse &expected, const THnSparse &h)
+{
+   ASSERT_EQ(expected.GetNbins(), h.GetNbins());
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), h.GetEntries());
+   Int_t coord[kSparseDim];
+   for (Long64_t i = 0; i < expected.GetNbins(); ++i) {
+      const Double_t v = expected.GetBinContent(i, coord);
+      const Long64_t bin = h.GetBin(coord);
+      ASSERT_GE(bin, 0);
+      EXPECT_DOUBLE_EQ(v, h.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(expected.GetBinError2(i), h.GetBinError2(bin));
+   }
+}
+
+} // anonymous namespace
+
+// Filling THnSparse
+TEST(THnSparse, Fill) {
+   Int_t bins[kSparseDim];
+   Double_t xmin[kSparseDim];
+   Double_t xmax[kSparseDim];
+   for (Int_t d = 0; d < kSparseDim; ++d) {
+      bins[d] = 100;
+      xmin[d] = 0.;
+      xmax[d] = 100.;
+   }
+   THnSparseD hs("hs", "hs", kSparseDim, bins, xmin, xmax, 64);
+   hs.Sumw2();
+   FillSparse(hs, 0, 5000);
+
+   std::map<std::vector<Int_t>, Double_t> expected;
+   Int_t coord[kSparseDim];
+   Double_t x[kSparseDim];
+   for (Int_t i = 0; i < 5000; ++i) {
+      for (Int_t d = 0; d < kSparseDim; ++d) {
+         x[d] = ((i * (d + 3) * 7919) % 1000) / 10. * (i % 2 ? 1 : d % 3);
+         coord[d] = hs.GetAxis(d)->FindBin(x[d]);
+      }
+      expected[std::vector<Int_t>(coord, coord + kSparseDim)] += 1 + i % 4;
+   }
+
+   ASSERT_EQ((Long64_t)expected.size(), hs.GetNbins());
+   for (const auto &bin : expected) {
+      const Long64_t idx = hs.GetBin(bin.first.data());
+      ASSERT_GE(idx, 0);
+      EXPECT_DOUBLE_EQ(bin.second, hs.GetBinContent(idx));
+   }
+   coord[0] = 0;
+   for (Int_t d = 1; d < kSparseDim; ++d)
+      coord[d] = 101;
+   EXPECT_EQ(-1, hs.GetBin(coord));
+   EXPECT_EQ((Long64_t)expected.size(), hs.GetNbins());
+
+   hs.Reset();
+   EXPECT_EQ(0, hs.GetNbins());
+   EXPECT_EQ(-1, hs.GetBin(expected.begin()->first.data()));
+}
+
+TEST(THnSparse, Merge) {
+   Int_t bins[kSparseDim];
+   Double_t xmin[kSparseDim];
+   Double_t xmax[kSparseDim];
+   for (Int_t d = 0; d < kSparseDim; ++d) {
+      bins[d] = 100;
+      xmin[d] = 0.;
+      xmax[d] = 100.;
+   }
+   // h0 and h1 share the bins of the entries 2000 to 3000
+   THnSparseD expected("expected", "expected", kSparseDim, bins, xmin, xmax, 64);
+   expected.Sumw2();
+   FillSparse(expected, 0, 3000);
+   FillSparse(expected, 2000, 6000);
+
+   for (Bool_t imt : {kFALSE, kTRUE}) {
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::EnableImplicitMT(4);
+#else
+      if (imt)
+         continue;
+#endif
+      THnSparseD h0("h0", "h0", kSparseDim, bins, xmin, xmax, 64);
+      THnSparseD h1("h1", "h1", kSparseDim, bins, xmin, xmax, 64);
+      THnSparseF h2("h2", "h2", kSparseDim, bins, xmin, xmax, 128);
+      h0.Sumw2();
+      h1.Sumw2();
+      h2.Sumw2();
+      FillSparse(h0, 0, 3000);
+      FillSparse(h1, 2000, 4000);
+      FillSparse(h2, 4000, 6000);
+
+      TList list;
+      list.Add(&h1);
+      list.Add(&h2);
+      h0.Merge(&list);
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::DisableImplicitMT();
+#endif
+      ExpectEqualSparse(expected, h0);
+   }
+}
+
+// Merging THn with the same binning, bin arrays summed in chunks
+TEST(THn, Merge) {
+   Int_t bins[3] = {40, 50, 60};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {1., 1., 1.};
+   auto fill = [](THn &h, Int_t first, Int_t last) {
+      Double_t x[3];
+      for (Int_t i = first; i < last; ++i) {
+         for (Int_t d = 0; d < 3; ++d)
+            x[d] = ((i * (d + 3) * 7919) % 1200) / 1000. - 0.1;
+         h.Fill(x, 1 + i % 3);
+      }
+   };
+
+   THnD expected("expected", "expected", 3, bins, xmin, xmax);
+   expected.Sumw2();
+   fill(expected, 0, 30000);
+
+   for (Bool_t imt : {kFALSE, kTRUE}) {
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::EnableImplicitMT(4);
+#else
+      if (imt)
+         continue;
+#endif
+      // h0 gets its errors from h1; h2 has no errors, its contents count as such
+      THnD h0("h0", "h0", 3, bins, xmin, xmax);
+      THnD h1("h1", "h1", 3, bins, xmin, xmax);
+      THnF h2("h2", "h2", 3, bins, xmin, xmax);
+      THnD h3("h3", "h3", 3, bins, xmin, xmax);
+      h1.Sumw2();
+      h3.Sumw2();
+      fill(h0, 0, 10000);
+      fill(h1, 10000, 20000);
+      fill(h2, 20000, 25000);
+      fill(h3, 25000, 30000);
+
+      TList list;
+      list.Add(&h1);
+      list.Add(&h2);
+      list.Add(&h3);
+      h0.Merge(&list);
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::DisableImplicitMT();
+#endif
+
+      EXPECT_EQ(expected.GetEntries(), h0.GetEntries());
+      for (Long64_t bin = 0; bin < expected.GetNbins(); ++bin) {
+         EXPECT_EQ(expected.GetBinContent(bin), h0.GetBinContent(bin));
+      }
+   }
+}
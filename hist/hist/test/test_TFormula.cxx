@@ -2,8 +2,44 @@
 
 #include "TFormula.h"
 
+#include <vector>
+
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Test that the evaluation at many points gives the same values as EvalPar
+TEST(TFormula, EvalParVec)
+{
+  TFormula f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]*x");
+  const double p1[] = {2., 0.5, 1.5, 0.1};
+  f1.SetParameters(p1);
+  const double p2[] = {1., -0.5, 0.7, -0.2};
+
+  const size_t n = 100;
+  std::vector<double> x(n);
+  for (size_t i = 0; i < n; ++i)
+    x[i] = -5. + 0.1 * i;
+  std::vector<double> out(n);
+
+  f1.EvalParVec(x.data(), n, p2, out.data());
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_DOUBLE_EQ(f1.EvalPar(&x[i], p2), out[i]);
+
+  // nullptr uses the parameters of the formula
+  f1.EvalParVec(x.data(), n, nullptr, out.data());
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_DOUBLE_EQ(f1.EvalPar(&x[i], p1), out[i]);
+
+  // two dimensions: points are stored one after the other
+  TFormula f2("f2", "[0]*x*y + sin(y)");
+  f2.SetParameter(0, 3.);
+  std::vector<double> xy(2 * n);
+  for (size_t i = 0; i < 2 * n; ++i)
+    xy[i] = 0.01 * i;
+  f2.EvalParVec(xy.data(), n, nullptr, out.data());
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_DOUBLE_EQ(f2.EvalPar(&xy[2 * i]), out[i]);
+}
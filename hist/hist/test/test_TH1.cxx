@@ -2,7 +2,14 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2.h"
+#include "TH3.h"
 #include "THLimitsFinder.h"
+#include "TList.h"
+#include "TROOT.h"
+
+#include <cmath>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -46,3 +53,139 @@ TEST(THLimitsFinder, Degenerate)
    EXPECT_LE(xmin, centralValue - 5.);
    EXPECT_GE(xmax, centralValue + 5.);
 }
+
+// The batched FillN must give the same result as filling the entries one by one
+TEST(TH1, FillNFixedBins)
+{
+   const int n = 1000;
+   std::vector<double> x(n), y(n), z(n), w(n);
+   for (int i = 0; i < n; ++i) {
+      // include underflows, overflows and the bin edges
+      x[i] = -0.2 + 1.4 * i / n;
+      y[i] = std::fmod(0.37 * i, 1.3) - 0.1;
+      z[i] = (i % 10) / 9.;
+      w[i] = 0.5 + (i % 3);
+   }
+
+   TH1D h1("h1", "h1", 10, 0, 1), h1n("h1n", "h1n", 10, 0, 1);
+   TH2D h2("h2", "h2", 10, 0, 1, 7, 0, 1), h2n("h2n", "h2n", 10, 0, 1, 7, 0, 1);
+   TH3D h3("h3", "h3", 10, 0, 1, 7, 0, 1, 5, 0, 1), h3n("h3n", "h3n", 10, 0, 1, 7, 0, 1, 5, 0, 1);
+   for (int i = 0; i < n; ++i) {
+      h1.Fill(x[i], w[i]);
+      h2.Fill(x[i], y[i], w[i]);
+      h3.Fill(x[i], y[i], z[i], w[i]);
+   }
+   h1n.FillN(n, x.data(), w.data());
+   h2n.FillN(n, x.data(), y.data(), w.data());
+   h3n.FillN(n, x.data(), y.data(), z.data(), w.data());
+
+   auto expectSame = [](const TH1 &a, const TH1 &b) {
+      ASSERT_EQ(a.GetNcells(), b.GetNcells());
+      for (int bin = 0; bin < a.GetNcells(); ++bin) {
+         EXPECT_EQ(a.GetBinContent(bin), b.GetBinContent(bin));
+         EXPECT_EQ(a.GetBinError(bin), b.GetBinError(bin));
+      }
+      Double_t sa[TH1::kNstat] = {}, sb[TH1::kNstat] = {};
+      a.GetStats(sa);
+      b.GetStats(sb);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         EXPECT_EQ(sa[i], sb[i]);
+      EXPECT_EQ(a.GetEntries(), b.GetEntries());
+   };
+   expectSame(h1, h1n);
+   expectSame(h2, h2n);
+   expectSame(h3, h3n);
+}
+
+// Merge of histograms with identical axes, summed array by array
+TEST(TH1, MergeSameAxes)
+{
+   const int nbins = 600;
+   const int n = 20000;
+   auto fill = [](TH2 &h, int first, int last, bool weighted) {
+      for (int i = first; i < last; ++i)
+         h.Fill(((i * 7919) % 1200) / 1000. - 0.1, ((i * 104729) % 1100) / 1000., weighted ? 1 + i % 3 : 1);
+   };
+
+   TH2D expected("expected", "expected", nbins, 0, 1, nbins, 0, 1);
+   expected.Sumw2();
+   fill(expected, 0, n, true);
+   fill(expected, n, 2 * n, false);
+   fill(expected, 2 * n, 3 * n, true);
+   fill(expected, 3 * n, 4 * n, true);
+
+   for (bool imt : {false, true}) {
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::EnableImplicitMT(4);
+#else
+      if (imt)
+         continue;
+#endif
+      TH2D h0("h0", "h0", nbins, 0, 1, nbins, 0, 1);
+      TH2D h1("h1", "h1", nbins, 0, 1, nbins, 0, 1);
+      TH2D h2("h2", "h2", nbins, 0, 1, nbins, 0, 1);
+      // a different storage type, merged bin by bin
+      TH2F h3("h3", "h3", nbins, 0, 1, nbins, 0, 1);
+      h0.Sumw2();
+      h2.Sumw2();
+      h3.Sumw2();
+      fill(h0, 0, n, true);
+      fill(h1, n, 2 * n, false);
+      fill(h2, 2 * n, 3 * n, true);
+      fill(h3, 3 * n, 4 * n, true);
+
+      TList list;
+      list.Add(&h1);
+      list.Add(&h2);
+      list.Add(&h3);
+      h0.Merge(&list);
+#ifdef R__USE_IMT
+      if (imt)
+         ROOT::DisableImplicitMT();
+#endif
+
+      for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+         EXPECT_EQ(expected.GetBinContent(bin), h0.GetBinContent(bin));
+         EXPECT_EQ(expected.GetBinError(bin), h0.GetBinError(bin));
+      }
+      EXPECT_EQ(expected.GetEntries(), h0.GetEntries());
+      Double_t se[TH1::kNstat] = {}, s0[TH1::kNstat] = {};
+      expected.GetStats(se);
+      h0.GetStats(s0);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         EXPECT_DOUBLE_EQ(se[i], s0[i]);
+   }
+}
+
+// Inputs merged array by array and bin by bin are added in the order of the list
+TEST(TH1, MergeSameAxesMixedOrder)
+{
+   TH1D h0("h0", "h0", 2, 0, 2);
+   TH1D h1("h1", "h1", 2, 0, 2);
+   // a different storage type, merged bin by bin
+   TH1F h2("h2", "h2", 2, 0, 2);
+   h0.Sumw2();
+   // the sum in double precision depends on the order of the inputs
+   h0.SetBinContent(1, 1e16);
+   h1.SetBinContent(1, 1);
+   h2.SetBinContent(1, -1e16);
+   // without sum of weights squared, the errors are the absolute values of the contents
+   h1.SetBinContent(2, -3);
+   h2.SetBinContent(2, -4);
+
+   TH1D expected(h0);
+   expected.Add(&h1);
+   expected.Add(&h2);
+
+   TList list;
+   list.Add(&h1);
+   list.Add(&h2);
+   h0.Merge(&list);
+   for (int bin = 1; bin <= 2; ++bin) {
+      EXPECT_EQ(expected.GetBinContent(bin), h0.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(expected.GetBinError(bin), h0.GetBinError(bin));
+   }
+   EXPECT_EQ(-7, h0.GetBinContent(2));
+   EXPECT_DOUBLE_EQ(std::sqrt(7.), h0.GetBinError(2));
+}
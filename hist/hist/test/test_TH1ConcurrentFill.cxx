@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include "TH1.h"
+#include "TH1ConcurrentFill.h"
+#include "TH2.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+const Int_t kNThreads = 4;
+const Int_t kNFills = 20000;
+
+// Coordinates and weights for which all sums are exact, whatever the order of the fills
+Double_t Coordinate(Int_t i, Int_t j)
+{
+   return ((i * 37 + j * 101) % 160) / 64. - 0.5;
+}
+
+Double_t Weight(Int_t i)
+{
+   return 1 + i % 3;
+}
+
+void ExpectEqualHists(const TH1 &expected, const TH1 &h)
+{
+   ASSERT_EQ(expected.GetNcells(), h.GetNcells());
+   for (Int_t bin = 0; bin < h.GetNcells(); ++bin) {
+      EXPECT_EQ(expected.GetBinContent(bin), h.GetBinContent(bin));
+      EXPECT_EQ(expected.GetBinError(bin), h.GetBinError(bin));
+   }
+   EXPECT_EQ(expected.GetEntries(), h.GetEntries());
+   Double_t expectedStats[TH1::kNstat] = {0};
+   Double_t stats[TH1::kNstat] = {0};
+   expected.GetStats(expectedStats);
+   h.GetStats(stats);
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      EXPECT_EQ(expectedStats[i], stats[i]);
+}
+
+void FillConcurrently(TH1ConcurrentFillManager &manager)
+{
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < kNThreads; ++t) {
+      threads.emplace_back([&manager, t]() {
+         auto filler = manager.MakeFiller();
+         const Int_t dim = manager.GetHist()->GetDimension();
+         for (Int_t i = t; i < kNFills; i += kNThreads) {
+            Double_t x[2] = {Coordinate(i, 0), Coordinate(i, 1)};
+            if (dim == 1)
+               filler.Fill(x[0], Weight(i));
+            else
+               filler.Fill(x, Weight(i));
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   manager.Flush();
+}
+
+} // anonymous namespace
+
+TEST(TH1ConcurrentFill, TH1D)
+{
+   TH1D expected("expected", "expected", 100, 0., 2.);
+   for (Int_t i = 0; i < kNFills; ++i)
+      expected.Fill(Coordinate(i, 0), Weight(i));
+
+   for (auto mode : {TH1ConcurrentFillManager::EMode::kDeltaBuffer, TH1ConcurrentFillManager::EMode::kAtomic}) {
+      TH1D h("h", "h", 100, 0., 2.);
+      // a small buffer, such that the fillers flush it many times
+      TH1ConcurrentFillManager manager(h, mode, 16);
+      FillConcurrently(manager);
+      ExpectEqualHists(expected, h);
+   }
+}
+
+TEST(TH1ConcurrentFill, TH2D)
+{
+   TH2D expected("expected", "expected", 20, 0., 2., 30, -0.5, 1.5);
+   for (Int_t i = 0; i < kNFills; ++i)
+      expected.Fill(Coordinate(i, 0), Coordinate(i, 1), Weight(i));
+
+   for (auto mode : {TH1ConcurrentFillManager::EMode::kDeltaBuffer, TH1ConcurrentFillManager::EMode::kAtomic}) {
+      TH2D h("h", "h", 20, 0., 2., 30, -0.5, 1.5);
+      TH1ConcurrentFillManager manager(h, mode);
+      FillConcurrently(manager);
+      ExpectEqualHists(expected, h);
+   }
+}
@@ -496,4 +496,42 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+
+/// FFT binning tests
+/// The estimate computed by FFT on the grid must agree with the unbinned one,
+/// and must not depend on how the events were added
+TEST(TKDE, tkde_fft)
+{
+   TRandom3 r(1111);
+   const int n = 20000;
+   std::vector<double> data;
+   while (data.size() < (size_t)n) {
+      double x = (r.Rndm() < 0.2) ? r.Gaus(10, 1) : r.Gaus(10, 5);
+      if (x >= 0 && x < 20.)
+         data.push_back(x);
+   }
+
+   TKDE unbinned(n, data.data(), 0., 20., "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   TKDE fft(n, data.data(), 0., 20., "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:FFTBinning");
+   EXPECT_NEAR(unbinned.GetMean(), fft.GetMean(), 1.E-10);
+   EXPECT_NEAR(unbinned.GetSigma(), fft.GetSigma(), 1.E-3);
+
+   // streaming: events added one by one and in blocks after the construction
+   TKDE stream(0, nullptr, 0., 20., "KernelType:Gaussian;Mirror:noMirror;Binning:FFTBinning");
+   stream.SetNBins(2000);
+   for (int i = 0; i < n / 2; ++i)
+      stream.Fill(data[i]);
+   EXPECT_GT(stream(10.), 0.);
+   stream.FillN(n / 2, data.data() + n / 2);
+   // events outside the range are ignored, also for the bandwidth
+   stream.Fill(-1.);
+   stream.Fill(25.);
+
+   for (int i = 0; i <= 20; ++i) {
+      double x = i;
+      double expected = unbinned(x);
+      EXPECT_NEAR(expected, fft(x), 0.02 * expected + 1.E-4) << "x = " << x;
+      EXPECT_NEAR(fft(x), stream(x), 1.E-10) << "x = " << x;
+   }
+}
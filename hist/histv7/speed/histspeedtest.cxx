@@ -1,762 +1,523 @@
 /// \file histspeedtest.cxx
 ///
+/// Benchmark of the filling of the histogram classes: `TH1`/`TH2`/`TH3` and `RHist`.
+///
+/// For each dimension (1 to 3), precision (double, float), number of bins per axis and axis type
+/// (equidistant, irregular, growable), it measures:
+///   - TH1: `Fill()`, `FillN()`, `Fill()` with a `TH1::SetBuffer()` buffer, and for each number of
+///     threads, a clone per thread merged at the end and `TH1ConcurrentFillManager` in both modes
+///     (not for growable axes, which it does not extend);
+///   - RHist: `Fill()`, `FillN()`, `RHistBufferedFill`, and for each number of threads,
+///     `RHistConcurrentFillManager`.
+///
+/// The best time of the repetitions is printed and written to a JSON file, see `histspeedtest -h`.
+/// Only the filling is timed, not the creation of the histograms.
+///
+/// Growable axes are filled with values inside the axis range: `RHist` does not grow its axes yet.
+///
 /// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
 /// is welcome!
 /// \author Axel Naumann <axel@cern.ch>
 
 #include "TRandom3.h"
-#include <vector>
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "TH1.h"
+#include "TH1ConcurrentFill.h"
 #include "TH2.h"
 #include "TH3.h"
+#include "TList.h"
 
 #include "ROOT/RHist.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
 
 using namespace ROOT;
-using namespace std;
-
-constexpr unsigned short gRepeat = 2;
-
-/* DataTypes:
-
- THistDataContent
- THistDataUncertainty
- THistDataMomentUncert
- THistDataRuntime
-and
- MyTHistDataNoStat
- MyTHistDataContent
- MyTHistDataMomentUncert
-
- /opt/build/root_builds/rootcling.cmake/include/ROOT/THistBinIter.h:53:50: error: no member named 'GetUncertainty' in
-'ROOT::Experimental::THistDataContent<2, double, ROOT::Experimental::THistDataDefaultStorage>::TBinStat<double>' auto
-GetUncertainty() const { return GetStat().GetUncertainty(); }
-
- new ones (STATCLASSES)
-
- THistStatContent
- THistStatUncertainty
- THistStatTotalSumOfWeights
- THistStatTotalSumOfSquaredWeights
- THistDataMomentUncert
-
 
+/* The statistics of the RHist can be chosen at compile time, e.g.
+   -DSTATCLASSES=Experimental::RHistStatContent
+   -DSTATCLASSES=Experimental::RHistStatContent,Experimental::RHistStatUncertainty
+   -DSTATCLASSES=Experimental::RHistStatContent,Experimental::RHistStatUncertainty,Experimental::RHistStatTotalSumOfWeights
  */
 
 #ifndef STATCLASSES
 #define STATCLASSES Experimental::RHistStatContent, Experimental::RHistStatUncertainty
 #endif
 
-struct Timer {
-   using TimePoint_t = decltype(std::chrono::high_resolution_clock::now());
+#define HISTSPEED_STRINGIFY(...) #__VA_ARGS__
+#define HISTSPEED_XSTRINGIFY(...) HISTSPEED_STRINGIFY(__VA_ARGS__)
 
-   const char *fTitle;
-   size_t fCount;
-   TimePoint_t fStart;
+namespace {
 
-   Timer(const char *title, size_t count)
-      : fTitle(title), fCount(count), fStart(std::chrono::high_resolution_clock::now())
-   {}
+/// Number of entries passed to each FillN() call
+constexpr size_t kFillNChunk = 1024;
 
-   ~Timer()
-   {
-      using namespace std::chrono;
-      auto end = high_resolution_clock::now();
-      duration<double> time_span = duration_cast<duration<double>>(end - fStart);
-      // std::cout << fCount << " * " << fTitle << ": " << time_span.count() << " seconds \n";
-      // std::cout << fCount << " * " << fTitle << ": " << fCount / (1e6) / time_span.count()
-      //    << " millions per seconds\n";
-      std::cout << fCount << " * " << fTitle << ": " << time_span.count() << " seconds, \t";
-      std::cout << fCount / (1e6) / time_span.count() << " millions per seconds \n";
-   }
-};
-
-constexpr UInt_t gStride = 32; // TH1::GetDefaultBufferSize()
-
-struct BinEdges {
-   static constexpr size_t fNBinsX = 4;
-   static constexpr size_t fNBinsY = 5;
-   double fXBins[4];
-   double fYBins[5];
-
-   BinEdges(double minValue, double maxValue)
-   {
-      if (maxValue < minValue)
-         swap(minValue, maxValue);
-      double range = maxValue - minValue;
+/// Maximum number of bins of a histogram; larger configurations are skipped
+constexpr double kMaxBins = 1e7;
 
-      double x[fNBinsX] = {0., 0.1, 0.3, 1.};
-      double y[fNBinsY] = {0., 0.1, 0.2, 0.3, 1.};
+enum class EAxisKind { kEquidistant, kIrregular, kGrowable };
 
-      for (size_t i = 0; i < fNBinsX; ++i)
-         fXBins[i] = minValue + range * x[i];
-      for (size_t i = 0; i < fNBinsY; ++i)
-         fYBins[i] = minValue + range * y[i];
-   }
-
-   using AConf_t = Experimental::RAxisConfig;
-
-   AConf_t GetConfigX() const { return AConf_t(std::span<const double>(fXBins).to_vector()); }
-   AConf_t GetConfigY() const { return AConf_t(std::span<const double>(fYBins).to_vector()); }
-};
-
-template <typename T>
-void GenerateInput(std::vector<T> &numbers, double minVal, double maxVal, UInt_t seed)
+const char *GetAxisKindName(EAxisKind kind)
 {
-   Timer t("GenerateInput", numbers.size());
-   if (minVal > maxVal) {
-      std::swap(minVal, maxVal);
-   }
-   T range = maxVal - minVal;
-   TRandom3 r(seed);
-   size_t len = numbers.size();
-   for (auto c = numbers.begin(); c != numbers.end(); ++c) {
-      *c = minVal + range * r.Rndm();
+   switch (kind) {
+   case EAxisKind::kEquidistant: return "equidistant";
+   case EAxisKind::kIrregular: return "irregular";
+   case EAxisKind::kGrowable: return "growable";
    }
+   return "";
 }
 
-std::string
-MakeTitle(std::string_view version, std::string_view histname, std::string_view title, std::string_view axis)
-{
-   std::string result =
-      std::string(version) + " " + std::string(histname) + " " + std::string(title) + " [" + std::string(axis) + "]";
-   return result;
-}
-
-template <int dim, typename type>
-const char *GetHist();
-
-template <>
-const char *GetHist<2, double>()
-{
-   return "2D";
-};
-template <>
-const char *GetHist<2, float>()
-{
-   return "2F";
+struct Config {
+   size_t fEntries = 1000000;
+   unsigned fRepeat = 3;
+   std::vector<int> fDims{1, 2, 3};
+   std::vector<int> fBins{10, 100, 1000};
+   std::vector<int> fThreads{1, 2, 4, 8};
+   std::string fOutput = "histspeedtest.json";
 };
 
-template <>
-const char *GetHist<1, double>()
-{
-   return "1D";
+/// One benchmarked configuration and its best time
+struct Result {
+   std::string fApi;
+   std::string fMethod;
+   int fDim = 1;
+   std::string fPrecision;
+   int fBinsPerAxis = 0;
+   EAxisKind fAxisKind = EAxisKind::kEquidistant;
+   int fThreads = 1;
+   size_t fEntries = 0;
+   double fSeconds = 0.;
 };
-template <>
-const char *GetHist<1, float>()
-{
-   return "1F";
-};
-
-namespace R7 {
-const char *gVersion = "R7";
-
-template <typename T, unsigned short kNDim>
-struct Dim;
-
-template <typename T>
-struct Dim<T, 2> {
-
-   constexpr static unsigned short kNDim = 2;
-   using ExpTH2 = Experimental::RHist<kNDim, T, STATCLASSES>;
-
-   using FillFunc_t = std::add_pointer_t<long(ExpTH2 &hist, std::vector<double> &input, std::string_view type)>;
-
-   struct EE {
-      static constexpr const char *const gType = "regular bin size  ";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-
-         ExpTH2 hist({100, minVal, maxVal}, {5, minVal, maxVal});
-         return filler(hist, input, gType);
-      }
-   };
-
-   struct II {
-      static constexpr const char *const gType = "irregular bin size";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
 
-         BinEdges edges(minVal, maxVal);
-         ExpTH2 hist(edges.GetConfigX(), edges.GetConfigY());
-         return filler(hist, input, gType);
-      }
-   };
-
-   inline static long fillN(ExpTH2 &hist, std::vector<double> &input, std::string_view gType)
-   {
-
-      using array_t = Experimental::Hist::RCoordArray<2>;
-      array_t *values = (array_t *)(&input[0]);
-      constexpr size_t stride = gStride;
-
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills N (stride 32)", gType);
-      {
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < (input.size() - (stride * 2 - 1)); i += (stride * 2), values += 32) {
-            std::span<array_t> coords(values, 32);
-            hist.FillN(coords);
-         }
-      }
-      return hist.GetNDim();
-   }
+/// One axis, as bin edges and whether it is equidistant or growable
+struct AxisSpec {
+   int fNBins;
+   double fMin;
+   double fMax;
+   EAxisKind fKind;
+   std::vector<double> fEdges;
 
-   inline static long fillBuffered(ExpTH2 &hist, std::vector<double> &input, std::string_view gType)
+   AxisSpec(int nbins, double min, double max, EAxisKind kind) : fNBins(nbins), fMin(min), fMax(max), fKind(kind)
    {
-      Experimental::RHistBufferedFill<ExpTH2> filler(hist);
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills (buffered)   ", gType);
-      {
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < input.size() - 1; i += 2)
-            filler.Fill({input[i], input[i + 1]});
+      // irregular: bins get wider with increasing x
+      for (int i = 0; i <= nbins; ++i) {
+         const double f = double(i) / nbins;
+         fEdges.push_back(min + (max - min) * (kind == EAxisKind::kIrregular ? f * f : f));
       }
-      return hist.GetNDim();
    }
 
-   inline static long fill(ExpTH2 &hist, std::vector<double> &input, std::string_view gType)
+   Experimental::RAxisConfig GetRAxisConfig() const
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills              ", gType);
-      {
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < input.size() - 1; i += 2)
-            hist.Fill({input[i], input[i + 1]});
+      switch (fKind) {
+      case EAxisKind::kIrregular: return Experimental::RAxisConfig(fEdges);
+      case EAxisKind::kGrowable: return Experimental::RAxisConfig(Experimental::RAxisConfig::Grow, fNBins, fMin, fMax);
+      default: return Experimental::RAxisConfig(fNBins, fMin, fMax);
       }
-      return hist.GetNDim();
    }
-}; // DimD
-
-template <typename T>
-struct Dim<T, 1> {
-
-   constexpr static unsigned short kNDim = 1;
-   using ExpTH1 = Experimental::RHist<kNDim, T, STATCLASSES>;
-
-   using FillFunc_t = std::add_pointer_t<long(ExpTH1 &hist, std::vector<double> &input, std::string_view type)>;
-
-   struct EE {
-      static constexpr const char *const gType = "regular bin size  ";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-         long result = 0;
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            ExpTH1 hist({100, minVal, maxVal});
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
-
-   struct II {
-      static constexpr const char *const gType = "irregular bin size";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-
-         long result = 0;
-         BinEdges edges(minVal, maxVal);
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            ExpTH1 hist(edges.GetConfigX());
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
-
-   inline static long fillN(ExpTH1 &hist, std::vector<double> &input, std::string_view gType)
-   {
+};
 
-      using array_t = Experimental::Hist::RCoordArray<1>;
-      array_t *values = (array_t *)(&input[0]);
-      constexpr size_t stride = gStride;
+class Benchmark {
+   const Config &fConfig;
+   std::vector<Result> fResults;
 
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills N (stride 32)", gType);
-      {
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < (input.size() - (stride - 1)); i += (stride), values += 32) {
-            std::span<array_t> coords(values, 32);
-            hist.FillN(coords);
-         }
-      }
-      return hist.GetNDim();
-   }
+public:
+   Benchmark(const Config &config) : fConfig(config) {}
 
-   inline static long fillBuffered(ExpTH1 &hist, std::vector<double> &input, std::string_view gType)
+   /// Time `fill` fConfig.fRepeat times, each after a call to `setup`, and record the best time.
+   void Run(Result result, const std::function<void()> &setup, const std::function<void()> &fill)
    {
-      Experimental::RHistBufferedFill<ExpTH1> filler(hist);
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills (buffered)   ", gType);
-      {
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < input.size(); ++i)
-            filler.Fill({input[i]});
+      using namespace std::chrono;
+      double best = -1.;
+      for (unsigned i = 0; i < fConfig.fRepeat; ++i) {
+         setup();
+         const auto start = steady_clock::now();
+         fill();
+         const duration<double> span = steady_clock::now() - start;
+         if (best < 0. || span.count() < best)
+            best = span.count();
       }
-      return hist.GetNDim();
+      result.fSeconds = best;
+      std::cout << std::left << std::setw(6) << result.fApi << std::setw(26) << result.fMethod << result.fDim << "D "
+                << std::setw(7) << result.fPrecision << std::setw(7) << result.fBinsPerAxis << std::setw(12)
+                << GetAxisKindName(result.fAxisKind) << std::setw(3) << result.fThreads << " threads: " << best
+                << " seconds, \t" << result.fEntries / 1e6 / best << " millions per second\n";
+      fResults.push_back(result);
    }
 
-   inline static long fill(ExpTH1 &hist, std::vector<double> &input, std::string_view gType)
+   void WriteJSON(std::ostream &out) const
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills              ", gType);
-      {
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < input.size(); ++i)
-            hist.Fill({input[i]});
+      out << "{\n"
+          << "  \"benchmark\": \"histspeedtest\",\n"
+          << "  \"entries\": " << fConfig.fEntries << ",\n"
+          << "  \"repeat\": " << fConfig.fRepeat << ",\n"
+          << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+          << "  \"rhist_statclasses\": \"" << HISTSPEED_XSTRINGIFY(STATCLASSES) << "\",\n"
+          << "  \"results\": [";
+      for (size_t i = 0; i < fResults.size(); ++i) {
+         const Result &r = fResults[i];
+         out << (i ? ",\n" : "\n") << "    {\"api\": \"" << r.fApi << "\", \"method\": \"" << r.fMethod
+             << "\", \"dim\": " << r.fDim << ", \"precision\": \"" << r.fPrecision
+             << "\", \"bins_per_axis\": " << r.fBinsPerAxis << ", \"axis\": \"" << GetAxisKindName(r.fAxisKind)
+             << "\", \"threads\": " << r.fThreads << ", \"entries\": " << r.fEntries
+             << ", \"seconds\": " << std::setprecision(9) << r.fSeconds
+             << ", \"fills_per_second\": " << r.fEntries / r.fSeconds << "}";
       }
-      return hist.GetNDim();
+      out << "\n  ]\n}\n";
    }
-}; // Dim1
-
-} // namespace R7
+};
 
-namespace R6 {
-const char *gVersion = "R6";
+/// Run `work(first, last)` on the entries [0, n) split over nThreads threads.
+void RunThreads(int nThreads, size_t n, const std::function<void(size_t, size_t)> &work)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t)
+      threads.emplace_back(work, n * t / nThreads, n * (t + 1) / nThreads);
+   for (auto &thread : threads)
+      thread.join();
+}
 
-template <int ndim, typename T>
-struct Redirect;
+template <int DIM, typename T>
+struct THType;
 template <>
-struct Redirect<2, float> {
-   using HistType_t = TH2F;
+struct THType<1, double> {
+   using Hist_t = TH1D;
 };
 template <>
-struct Redirect<2, double> {
-   using HistType_t = TH2D;
+struct THType<1, float> {
+   using Hist_t = TH1F;
 };
 template <>
-struct Redirect<1, float> {
-   using HistType_t = TH1F;
+struct THType<2, double> {
+   using Hist_t = TH2D;
 };
 template <>
-struct Redirect<1, double> {
-   using HistType_t = TH1D;
+struct THType<2, float> {
+   using Hist_t = TH2F;
+};
+template <>
+struct THType<3, double> {
+   using Hist_t = TH3D;
+};
+template <>
+struct THType<3, float> {
+   using Hist_t = TH3F;
 };
 
-template <typename T, int kNDim>
-struct Dim;
-
-template <typename T>
-struct Dim<T, 2> {
-
-   constexpr static unsigned short kNDim = 2;
-   using HistType_t = typename Redirect<kNDim, T>::HistType_t;
-
-   using FillFunc_t = std::add_pointer_t<long(HistType_t &hist, std::vector<double> &input, std::string_view type)>;
-
-   struct EE {
-
-      static constexpr const char *const gType = "regular bin size  ";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-
-         long result = 0;
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            HistType_t hist("a", "a hist", 100, minVal, maxVal, 5, minVal, maxVal);
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
-
-   struct II {
-
-      static constexpr const char *const gType = "irregular bin size";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-         long result = 0;
-         BinEdges edges(minVal, maxVal);
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            HistType_t hist("a", "a hist", edges.fNBinsX - 1, edges.fXBins, edges.fNBinsY - 1, edges.fYBins);
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
+/// Creation and filling of TH1, TH2 and TH3 with interleaved coordinates x0, y0, z0, x1, ...
+template <int DIM>
+struct THDim;
 
-   static long fillBuffered(HistType_t &hist, std::vector<double> &input, std::string_view gType)
+template <>
+struct THDim<1> {
+   template <class H>
+   static std::unique_ptr<H> Make(const AxisSpec &a)
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills (buffered)   ", gType);
-      hist.SetBuffer(TH1::GetDefaultBufferSize());
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < input.size() - 1; i += 2)
-            hist.Fill(input[i], input[i + 1]);
-      }
-      return (long)hist.GetEntries();
+      if (a.fKind == EAxisKind::kIrregular)
+         return std::unique_ptr<H>(new H("h", "h", a.fNBins, a.fEdges.data()));
+      return std::unique_ptr<H>(new H("h", "h", a.fNBins, a.fMin, a.fMax));
    }
+   static void Fill(TH1 &h, const double *x) { h.Fill(x[0]); }
+   static void FillN(TH1 &h, size_t n, const double *x) { h.FillN(n, x, nullptr); }
+};
 
-   static long fillN(HistType_t &hist, std::vector<double> &input, std::string_view gType)
+template <>
+struct THDim<2> {
+   template <class H>
+   static std::unique_ptr<H> Make(const AxisSpec &a)
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills N (stride 32)", gType);
-      constexpr size_t stride = gStride;
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < (input.size() - (stride * 2 - 1)); i += (stride * 2))
-            hist.FillN(gStride, &(input[i]), &(input[i + gStride]), nullptr);
-      }
-      return (long)hist.GetEntries();
+      if (a.fKind == EAxisKind::kIrregular)
+         return std::unique_ptr<H>(new H("h", "h", a.fNBins, a.fEdges.data(), a.fNBins, a.fEdges.data()));
+      return std::unique_ptr<H>(new H("h", "h", a.fNBins, a.fMin, a.fMax, a.fNBins, a.fMin, a.fMax));
    }
+   static void Fill(TH1 &h, const double *x) { h.Fill(x[0], x[1]); }
+   static void FillN(TH1 &h, size_t n, const double *x) { h.FillN(n, x, x + 1, nullptr, 2); }
+};
 
-   static long fill(HistType_t &hist, std::vector<double> &input, std::string_view gType)
+template <>
+struct THDim<3> {
+   template <class H>
+   static std::unique_ptr<H> Make(const AxisSpec &a)
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills              ", gType);
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size() / 2);
-         for (size_t i = 0; i < input.size() - 1; i += 2)
-            hist.Fill(input[i], input[i + 1]);
-      }
-      return (long)hist.GetEntries();
+      if (a.fKind == EAxisKind::kIrregular)
+         return std::unique_ptr<H>(new H("h", "h", a.fNBins, a.fEdges.data(), a.fNBins, a.fEdges.data(), a.fNBins,
+                                         a.fEdges.data()));
+      return std::unique_ptr<H>(
+         new H("h", "h", a.fNBins, a.fMin, a.fMax, a.fNBins, a.fMin, a.fMax, a.fNBins, a.fMin, a.fMax));
    }
-}; // Dim
-
-template <typename T>
-struct Dim<T, 1> {
-
-   constexpr static unsigned short kNDim = 1;
-   using HistType_t = typename Redirect<kNDim, T>::HistType_t;
-
-   using FillFunc_t = std::add_pointer_t<long(HistType_t &hist, std::vector<double> &input, std::string_view type)>;
-
-   struct EE {
-
-      static constexpr const char *const gType = "regular bin size  ";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-
-         long result = 0;
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            HistType_t hist("a", "a hist", 100, minVal, maxVal);
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
-
-   struct II {
-
-      static constexpr const char *const gType = "irregular bin size";
-
-      template <FillFunc_t filler>
-      static long Execute(std::vector<double> &input, double minVal, double maxVal)
-      {
-         long result = 0;
-         BinEdges edges(minVal, maxVal);
-         for (unsigned short i = 0; i < gRepeat; ++i) {
-            HistType_t hist("a", "a hist", edges.fNBinsX - 1, edges.fXBins);
-            result += filler(hist, input, gType);
-         }
-         return result;
-      }
-   };
-
-   static long fillBuffered(HistType_t &hist, std::vector<double> &input, std::string_view gType)
+   static void Fill(TH1 &h, const double *x) { static_cast<TH3 &>(h).Fill(x[0], x[1], x[2]); }
+   static void FillN(TH1 &h, size_t n, const double *x)
    {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills (buffered)   ", gType);
-      hist.SetBuffer(TH1::GetDefaultBufferSize());
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < input.size() - 1; ++i)
-            hist.Fill(input[i]);
-      }
-      return (long)hist.GetEntries();
+      static_cast<TH3 &>(h).FillN(n, x, x + 1, x + 2, nullptr, 3);
    }
+};
 
-   static long fillN(HistType_t &hist, std::vector<double> &input, std::string_view gType)
-   {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills N (stride 32)", gType);
-      constexpr size_t stride = gStride;
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < (input.size() - (stride - 1)); i += (stride))
-            hist.FillN(gStride, &(input[i]), nullptr);
-      }
-      return (long)hist.GetEntries();
-   }
+template <int DIM, typename T>
+void BenchmarkTH1(Benchmark &bench, const Config &config, const Result &base, const AxisSpec &axis,
+                  const std::vector<double> &input)
+{
+   using Hist_t = typename THType<DIM, T>::Hist_t;
+   const size_t n = input.size() / DIM;
+   const double *x = input.data();
+   std::unique_ptr<Hist_t> h;
+   auto setup = [&]() {
+      h = THDim<DIM>::template Make<Hist_t>(axis);
+      if (axis.fKind == EAxisKind::kGrowable)
+         h->SetCanExtend(TH1::kAllAxes);
+   };
 
-   static long fill(HistType_t &hist, std::vector<double> &input, std::string_view gType)
-   {
-      std::string title = MakeTitle(gVersion, GetHist<kNDim, T>(), "fills              ", gType);
-      {
-         // Timer t("R6 2D fills [regular bins size]",input.size()/2);
-         Timer t(title.c_str(), input.size());
-         for (size_t i = 0; i < input.size(); ++i)
-            hist.Fill(input[i]);
+   Result r = base;
+   r.fApi = "TH1";
+
+   r.fMethod = "Fill";
+   bench.Run(r, setup, [&]() {
+      for (size_t i = 0; i < n; ++i)
+         THDim<DIM>::Fill(*h, x + i * DIM);
+   });
+
+   r.fMethod = "FillN";
+   bench.Run(r, setup, [&]() {
+      for (size_t i = 0; i < n; i += kFillNChunk)
+         THDim<DIM>::FillN(*h, std::min(kFillNChunk, n - i), x + i * DIM);
+   });
+
+   r.fMethod = "Fill (SetBuffer)";
+   bench.Run(r,
+             [&]() {
+                setup();
+                h->SetBuffer(TH1::GetDefaultBufferSize());
+             },
+             [&]() {
+                for (size_t i = 0; i < n; ++i)
+                   THDim<DIM>::Fill(*h, x + i * DIM);
+                h->BufferEmpty(1);
+             });
+
+   for (int nThreads : config.fThreads) {
+      r.fThreads = nThreads;
+
+      // as RDataFrame's FillHelper: one clone per thread, merged at the end
+      r.fMethod = "Fill (clone per thread)";
+      bench.Run(r, setup, [&]() {
+         std::vector<std::unique_ptr<Hist_t>> clones(nThreads);
+         for (auto &clone : clones)
+            clone.reset(static_cast<Hist_t *>(h->Clone()));
+         std::vector<std::thread> threads;
+         for (int t = 0; t < nThreads; ++t) {
+            threads.emplace_back([&, t]() {
+               for (size_t i = n * t / nThreads; i < n * (t + 1) / nThreads; ++i)
+                  THDim<DIM>::Fill(*clones[t], x + i * DIM);
+            });
+         }
+         for (auto &thread : threads)
+            thread.join();
+         TList list;
+         for (auto &clone : clones)
+            list.Add(clone.get());
+         h->Merge(&list);
+      });
+
+      // concurrent fills do not extend the axes
+      if (axis.fKind == EAxisKind::kGrowable)
+         continue;
+      for (auto mode : {TH1ConcurrentFillManager::EMode::kDeltaBuffer, TH1ConcurrentFillManager::EMode::kAtomic}) {
+         r.fMethod = mode == TH1ConcurrentFillManager::EMode::kAtomic ? "TH1ConcurrentFill (atomic)"
+                                                                      : "TH1ConcurrentFill (delta)";
+         bench.Run(r, setup, [&]() {
+            TH1ConcurrentFillManager manager(*h, mode);
+            RunThreads(nThreads, n, [&](size_t first, size_t last) {
+               auto filler = manager.MakeFiller();
+               for (size_t i = first; i < last; ++i)
+                  filler.Fill(x + i * DIM);
+            });
+            manager.Flush();
+         });
       }
-      return (long)hist.GetEntries();
    }
-}; // Dim1
-} // namespace R6
-
-template <typename T, unsigned short kNDim>
-void speedtest(size_t count = (size_t)(1e6));
+}
 
-template <>
-void speedtest<double, 2>(size_t count)
+/// The same axis configuration for all dimensions
+template <std::size_t... I>
+std::array<Experimental::RAxisConfig, sizeof...(I)> MakeRAxisConfigs(const AxisSpec &axis, std::index_sequence<I...>)
 {
-   using DataType_t = double;
-   static constexpr unsigned short kNDim = 2;
-
-   TH1::AddDirectory(kFALSE);
-
-   std::vector<double> input; // (count);
-   input.resize(count);
-
-   double minVal = -5.0;
-   double maxVal = +5.0;
-   GenerateInput(input, minVal, maxVal, 0);
-
-   // Make sure we have some overflow.
-   minVal *= 0.9;
-   maxVal *= 0.9;
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
+   return {{((void)I, axis.GetRAxisConfig())...}};
 }
 
-// these are copy/paste to work around failure to properly instantiate the template :(
-
-template <>
-void speedtest<float, 2>(size_t count)
+template <int DIM, typename T>
+void BenchmarkRHist(Benchmark &bench, const Config &config, const Result &base, const AxisSpec &axis,
+                    const std::vector<double> &input)
 {
-   using DataType_t = float;
-   constexpr unsigned short kNDim = 2;
-
-   TH1::AddDirectory(kFALSE);
-
-   std::vector<double> input; // (count);
-   input.resize(count);
-
-   double minVal = -5.0;
-   double maxVal = +5.0;
-   GenerateInput(input, minVal, maxVal, 0);
-
-   // Make sure we have some overflow.
-   minVal *= 0.9;
-   maxVal *= 0.9;
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
+   using Hist_t = Experimental::RHist<DIM, T, STATCLASSES>;
+   using Coord_t = typename Hist_t::CoordArray_t;
+   const size_t n = input.size() / DIM;
+   // RCoordArray<DIM> has the layout of DIM doubles
+   const Coord_t *coords = reinterpret_cast<const Coord_t *>(input.data());
+   const auto axes = MakeRAxisConfigs(axis, std::make_index_sequence<DIM>());
+   std::unique_ptr<Hist_t> h;
+   auto setup = [&]() { h.reset(new Hist_t(axes)); };
+
+   Result r = base;
+   r.fApi = "RHist";
+
+   r.fMethod = "Fill";
+   bench.Run(r, setup, [&]() {
+      for (size_t i = 0; i < n; ++i)
+         h->Fill(coords[i]);
+   });
+
+   r.fMethod = "FillN";
+   bench.Run(r, setup, [&]() {
+      for (size_t i = 0; i < n; i += kFillNChunk)
+         h->FillN(std::span<const Coord_t>(coords + i, std::min(kFillNChunk, n - i)));
+   });
+
+   r.fMethod = "RHistBufferedFill";
+   bench.Run(r, setup, [&]() {
+      Experimental::RHistBufferedFill<Hist_t> filler(*h);
+      for (size_t i = 0; i < n; ++i)
+         filler.Fill(coords[i]);
+   });
+
+   for (int nThreads : config.fThreads) {
+      r.fThreads = nThreads;
+      r.fMethod = "RHistConcurrentFill";
+      bench.Run(r, setup, [&]() {
+         Experimental::RHistConcurrentFillManager<Hist_t> manager(*h);
+         RunThreads(nThreads, n, [&](size_t first, size_t last) {
+            auto filler = manager.MakeFiller();
+            for (size_t i = first; i < last; ++i)
+               filler.Fill(coords[i]);
+         });
+      });
+   }
 }
 
-template <>
-void speedtest<double, 1>(size_t count)
+template <int DIM, typename T>
+void speedtest(Benchmark &bench, const Config &config, const char *precision)
 {
-   using DataType_t = double;
-   static constexpr unsigned short kNDim = 1;
-
-   TH1::AddDirectory(kFALSE);
-
-   std::vector<double> input; // (count);
-   input.resize(count);
-
-   double minVal = -5.0;
-   double maxVal = +5.0;
-   GenerateInput(input, minVal, maxVal, 0);
-
-   // Make sure we have some overflow.
-   minVal *= 0.9;
-   maxVal *= 0.9;
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
+   // Make sure we have some overflow, except for growable axes
+   const double minVal = -5.0;
+   const double maxVal = +5.0;
+   std::vector<double> input(config.fEntries * DIM);
+   std::vector<double> inputInRange(config.fEntries * DIM);
+   TRandom3 r(0);
+   for (size_t i = 0; i < input.size(); ++i) {
+      const double rndm = r.Rndm();
+      input[i] = 1.1 * (minVal + (maxVal - minVal) * rndm);
+      inputInRange[i] = minVal + (maxVal - minVal) * rndm;
+   }
 
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
+   for (int nbins : config.fBins) {
+      if (std::pow(nbins + 2., DIM) > kMaxBins) {
+         std::cout << "Skipping " << DIM << "D histograms with " << nbins << " bins per axis\n";
+         continue;
+      }
+      for (auto kind : {EAxisKind::kEquidistant, EAxisKind::kIrregular, EAxisKind::kGrowable}) {
+         const AxisSpec axis(nbins, minVal, maxVal, kind);
+         Result base;
+         base.fDim = DIM;
+         base.fPrecision = precision;
+         base.fBinsPerAxis = nbins;
+         base.fAxisKind = kind;
+         base.fEntries = config.fEntries;
+         const std::vector<double> &in = kind == EAxisKind::kGrowable ? inputInRange : input;
+         BenchmarkTH1<DIM, T>(bench, config, base, axis, in);
+         BenchmarkRHist<DIM, T>(bench, config, base, axis, in);
+      }
+      std::cout << '\n';
+   }
 }
 
-template <>
-void speedtest<float, 1>(size_t count)
+std::vector<int> ParseList(const char *arg)
 {
-   using DataType_t = float;
-   static constexpr unsigned short kNDim = 1;
-
-   TH1::AddDirectory(kFALSE);
-
-   std::vector<double> input; // (count);
-   input.resize(count);
-
-   double minVal = -5.0;
-   double maxVal = +5.0;
-   GenerateInput(input, minVal, maxVal, 0);
-
-   // Make sure we have some overflow.
-   minVal *= 0.9;
-   maxVal *= 0.9;
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::EE::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R7::Dim<DataType_t, kNDim>::II::Execute<R7::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::EE::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-
-   cout << '\n';
-
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillBuffered>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fillN>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
-   R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
+   std::vector<int> result;
+   std::stringstream ss(arg);
+   std::string item;
+   while (std::getline(ss, item, ','))
+      result.push_back(std::stoi(item));
+   return result;
 }
 
-void histspeedtest(size_t iter = 1e6, int what = 255)
+void Usage(const char *argv0)
 {
-   if (what & 1)
-      speedtest<double, 2>(iter);
-   if (what & 2)
-      speedtest<float, 2>(iter);
-   if (what & 4)
-      speedtest<double, 1>(iter);
-   if (what & 8)
-      speedtest<float, 1>(iter);
+   std::cout << "Usage: " << argv0 << " [options]\n"
+             << "  -n <entries>     number of entries filled per benchmark (default 1e6)\n"
+             << "  -d <dims>        comma separated dimensions, out of 1,2,3 (default 1,2,3)\n"
+             << "  -b <bins>        comma separated numbers of bins per axis (default 10,100,1000)\n"
+             << "  -t <threads>     comma separated numbers of threads for concurrent filling (default 1,2,4,8)\n"
+             << "  -r <repeat>      number of repetitions, the best time is reported (default 3)\n"
+             << "  -o <file.json>   output file (default histspeedtest.json)\n";
 }
 
+} // unnamed namespace
+
 int main(int argc, char **argv)
 {
+   Config config;
+   for (int i = 1; i < argc; ++i) {
+      const std::string opt = argv[i];
+      if (opt == "-h" || opt == "--help" || i + 1 == argc) {
+         Usage(argv[0]);
+         return opt == "-h" || opt == "--help" ? 0 : 1;
+      }
+      const char *value = argv[++i];
+      if (opt == "-n")
+         config.fEntries = atof(value);
+      else if (opt == "-d")
+         config.fDims = ParseList(value);
+      else if (opt == "-b")
+         config.fBins = ParseList(value);
+      else if (opt == "-t")
+         config.fThreads = ParseList(value);
+      else if (opt == "-r")
+         config.fRepeat = std::max(1, atoi(value));
+      else if (opt == "-o")
+         config.fOutput = value;
+      else {
+         Usage(argv[0]);
+         return 1;
+      }
+   }
 
-   size_t iter = 1e7;
-   int what = 1 | 2 | 4 | 8;
-   if (argc > 1)
-      iter = atof(argv[1]);
-   if (argc > 2)
-      what = atoi(argv[2]);
+   TH1::AddDirectory(kFALSE);
+   Benchmark bench(config);
+   for (int dim : config.fDims) {
+      switch (dim) {
+      case 1:
+         speedtest<1, double>(bench, config, "double");
+         speedtest<1, float>(bench, config, "float");
+         break;
+      case 2:
+         speedtest<2, double>(bench, config, "double");
+         speedtest<2, float>(bench, config, "float");
+         break;
+      case 3:
+         speedtest<3, double>(bench, config, "double");
+         speedtest<3, float>(bench, config, "float");
+         break;
+      default: std::cerr << "Ignoring unsupported dimension " << dim << '\n';
+      }
+   }
 
-   histspeedtest(iter, what);
+   std::ofstream out(config.fOutput);
+   bench.WriteJSON(out);
+   if (!out) {
+      std::cerr << "Cannot write " << config.fOutput << '\n';
+      return 1;
+   }
+   std::cout << "Results written to " << config.fOutput << '\n';
+   return 0;
 }
@@ -1,28 +1,25 @@
 #!/bin/sh
 
-what=$1
+# Run histspeedtest for several sets of RHist statistics; the results are written to
+# histspeedtest.<statclasses>.<pid>.json. Additional arguments are passed to histspeedtest,
+# e.g. `./runall.sh -n 1e7 -t 1,4,16`.
 
 CXX=g++
-prefix="rvalgrind --tool=callgrind --callgrind-out-file=callgrind.out.$1.%p --dump-instr=yes"
 
 . ${ROOTSYS}/bin/thisroot.sh
 
 set -x
 
-function run {
-   echo "Data Class: $1" | tee $1.1e6.$$.speedlog | tee $1.1e8.$$.speedlog
-   ${CXX} -o speedtest histspeedtest.cxx `root-config --cflags --libs` -O3 "-DSTATCLASSES=$1"
-   # ${prefix} ./speedtest 1e6 > $1.1e6.$$.log
-   # rvalgrind --tool=callgrind --callgrind-out-file=callgrind.out.$1.%p --dump-instr=yes ./speedtest 1e6 > $1.1e6.$$.vallog
-   ./speedtest 1e6 $what >> $1.1e6.$$.speedlog
-   ./speedtest 1e8 $what >> $1.1e8.$$.speedlog
+run() {
+   statclasses=$1
+   tag=$2
+   shift 2
+   ${CXX} -o speedtest histspeedtest.cxx `root-config --cflags --libs` -lROOTHist -O3 "-DSTATCLASSES=$statclasses"
+   ./speedtest -o histspeedtest.$tag.$$.json "$@" | tee histspeedtest.$tag.$$.speedlog
 }
 
-run THistStatContent
-run "THistStatContent,THistStatUncertainty"
-run "THistStatContent,THistStatUncertainty,THistStatTotalSumOfWeights"
-run "THistStatContent,THistStatUncertainty,THistStatTotalSumOfWeights,THistStatTotalSumOfSquaredWeights"
-run "THistStatContent,THistStatUncertainty,THistStatTotalSumOfWeights,THistStatTotalSumOfSquaredWeights,THistDataMomentUncert"
-
-echo 'Not running with THistDataRuntime'
-# run THistDataRuntime
+run Experimental::RHistStatContent content "$@"
+run "Experimental::RHistStatContent,Experimental::RHistStatUncertainty" uncertainty "$@"
+run "Experimental::RHistStatContent,Experimental::RHistStatUncertainty,Experimental::RHistStatTotalSumOfWeights" sumw "$@"
+run "Experimental::RHistStatContent,Experimental::RHistStatUncertainty,Experimental::RHistStatTotalSumOfWeights,Experimental::RHistStatTotalSumOfSquaredWeights" sumw2 "$@"
+run "Experimental::RHistStatContent,Experimental::RHistStatUncertainty,Experimental::RHistStatTotalSumOfWeights,Experimental::RHistStatTotalSumOfSquaredWeights,Experimental::RHistDataMomentUncert" moments "$@"
@@ -0,0 +1,34 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/// \name Byte swapping copies of arrays
+/// Copy `n` elements of 2, 4 or 8 bytes from `from` to `to`, reversing the byte order of every element.
+/// Neither pointer needs to be aligned and the two ranges must not overlap.
+/// On x86-64, the copies use SSSE3 or AVX2 byte shuffles if the CPU supports them (checked once at run time).
+/// Used to convert arrays of basic types between the big-endian on-file representation and the host
+/// representation on little-endian machines.
+///@{
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+///@}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -137,6 +137,31 @@ public:
       return fCompressTemporaryKeys;
    }
 
+   /** Enables or disables the direct merging of trees (enabled by default). If enabled, a TBufferMergerFile
+    * that holds a single TTree, which already exists in the output file, is merged by appending the tree's
+    * compressed baskets directly onto the output tree. The TBufferMergerFile is neither serialized into the
+    * merge queue nor processed by TFileMerger, and its data is not unstreamed. The copying of the baskets
+    * is done by the thread that writes the TBufferMergerFile, so that merging does not cap at a single core.
+    * The direct merge is not used if auto save is set, see SetAutoSave().
+    */
+   void SetDirectTreeMerge(Bool_t enable = kTRUE)
+   {
+      fDirectTreeMerge = enable;
+   }
+
+   /** Returns whether trees are merged directly. See TBufferMerger::SetDirectTreeMerge for more details. */
+   Bool_t GetDirectTreeMerge() const
+   {
+      return fDirectTreeMerge;
+   }
+
+   /** Returns the number of TBufferMergerFiles whose tree was merged directly so far.
+    * See TBufferMerger::SetDirectTreeMerge for more details. */
+   size_t GetNDirectTreeMerges() const
+   {
+      return fNDirectTreeMerges;
+   }
+
    friend class TBufferMergerFile;
 
 private:
@@ -156,9 +181,12 @@ private:
    void Merge();
    void Push(TBufferFile *buffer);
    bool TryMerge(TBufferMergerFile *memfile);
+   bool TryDirectTreeMerge(TBufferMergerFile *memfile);
 
+   bool fDirectTreeMerge{true};                                  //< Append the baskets of trees directly to the output trees
    bool fCompressTemporaryKeys{false};                           //< Enable compression of the TKeys in the TMemFile (save memory at the expense of time, end result is unchanged)
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
+   std::atomic<size_t> fNDirectTreeMerges{0};                    //< Number of files merged by TryDirectTreeMerge
    std::atomic<size_t> fBuffered{0};                             //< Number of bytes currently buffered
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
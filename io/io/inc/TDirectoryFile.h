@@ -44,10 +44,17 @@ protected:
    Long64_t    fSeekKeys{0};             ///< Location of Keys record on file
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
+   Long64_t    fSeekKeyIndex{0};         ///<!Location of the key index on file, 0 if none
+   Int_t       fNbytesKeyIndex{0};       ///<!Number of bytes of the key index record
+   Int_t       fNKeyIndex{0};            ///<!Number of entries of the key index
+   Bool_t      fLazyKeys{kFALSE};        ///<!True if fKeys only holds the keys looked up in the key index so far
 
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
+   TList      *LookupKeys(const char *name) const;
+   Bool_t      ReadKeyIndexInfo();
+   Int_t       WriteKeyIndex();
 
 private:
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
@@ -90,10 +97,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override { return fLazyKeys ? fNKeyIndex : fKeys->GetSize(); }
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <memory>
 #include <string>
 
 #include "Compression.h"
@@ -51,6 +52,12 @@ class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
 
+namespace ROOT {
+namespace Internal {
+class RRawFile;
+}
+}
+
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
@@ -113,6 +120,10 @@ protected:
    TList           *fInfoCache{nullptr};      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases{nullptr};     ///<!Time info about open phases
 
+   std::unique_ptr<ROOT::Internal::RRawFile> fMappedFile; ///<!Provides the memory mapping of a local file opened with the "mmap" option
+   char            *fMapBegin{nullptr};       ///<!Start of the read-only mapping of the whole file, if any
+   Long64_t         fMapSize{0};              ///<!Length of the mapping
+
 #ifdef R__USE_IMT
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
    static ROOT::Internal::RConcurrentHashColl fgTsSIHashes; ///<!TS Set of hashes built from read streamer infos
@@ -137,6 +148,9 @@ protected:
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
+           Bool_t      ReadBufferViaMap(char *buf, Int_t len);
+           void        MapLocalFile();
+           void        UnmapLocalFile();
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -186,7 +200,8 @@ public:
       kWriteError    = BIT(14),
       kBinaryFile    = BIT(15),
       kRedirected    = BIT(16),
-      kReproducible  = BIT(17)
+      kReproducible  = BIT(17),
+      kKeyIndex      = BIT(18)
    };
    enum ERelativeTo { kBeg = 0, kCur = 1, kEnd = 2 };
    enum { kStartBigFile  = 2000000000 };
@@ -224,6 +239,7 @@ public:
    virtual Int_t       GetErrno() const;
    virtual void        ResetErrno() const;
            Int_t       GetFd() const { return fD; }
+           const char *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
            TObjArray  *GetListOfProcessIDs() const {return fProcessIDs;}
            TList      *GetListOfFree() const { return fFree; }
@@ -248,6 +264,7 @@ public:
    const   TList      *GetStreamerInfoCache();
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
+           Bool_t      IsMapped() const { return fMapBegin != nullptr; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
@@ -32,6 +32,7 @@ protected:
    Int_t          fReadCalls;        ///< Number of read calls for this cache
    Long64_t       fNoCacheBytesRead; ///< Number of bytes read by basket to fill cached tree
    Int_t          fNoCacheReadCalls; ///< Number of read calls by basket to fill cached tree
+   Double_t       fReadTime{0};      ///<! Wall-clock time in seconds spent in the vectored reads of the cache
 
    Bool_t         fAsyncReading;
    Bool_t         fEnablePrefetching;///< reading by prefetching asynchronously
@@ -94,6 +95,7 @@ public:
            Int_t       GetNtot() const { return fNtot; }   // Return the total size of the prefetched blocks.
    virtual Int_t       GetReadCalls() const { return fReadCalls; }
    virtual Int_t       GetNoCacheReadCalls() const { return fNoCacheReadCalls; }
+           Double_t    GetReadTime() const { return fReadTime; } // Return the time spent in the vectored reads.
    virtual Int_t       GetUnzipBuffer(char ** /*buf*/, Long64_t /*pos*/, Int_t /*len*/, Bool_t * /*free*/) { return -1; }
            Long64_t    GetPrefetchedBlocks() const { return fPrefetchedBlocks; }
    virtual Bool_t      IsAsyncReading() const { return fAsyncReading; };
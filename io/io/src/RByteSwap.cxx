@@ -0,0 +1,117 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#define R__BYTESWAP_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using SwapCopyFunc_t = void (*)(char *, const char *, std::size_t);
+
+template <std::size_t N>
+void SwapCopyScalar(char *to, const char *from, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i, to += N, from += N) {
+      for (std::size_t b = 0; b < N; ++b)
+         to[b] = from[N - 1 - b];
+   }
+}
+
+#ifdef R__BYTESWAP_SIMD
+
+/// Byte permutation reversing every group of N bytes, for a (lane of a) vector register of 16 bytes
+template <std::size_t N>
+void FillShuffleMask(char *mask)
+{
+   for (std::size_t i = 0; i < 16; ++i)
+      mask[i] = (i / N) * N + (N - 1 - i % N);
+}
+
+template <std::size_t N>
+__attribute__((target("ssse3"))) void SwapCopySSSE3(char *to, const char *from, std::size_t n)
+{
+   char maskBytes[16];
+   FillShuffleMask<N>(maskBytes);
+   const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(maskBytes));
+
+   const std::size_t nVec = n * N / 16;
+   for (std::size_t i = 0; i < nVec; ++i) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + 16 * i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + 16 * i), _mm_shuffle_epi8(v, mask));
+   }
+   const std::size_t done = nVec * 16 / N;
+   SwapCopyScalar<N>(to + done * N, from + done * N, n - done);
+}
+
+template <std::size_t N>
+__attribute__((target("avx2"))) void SwapCopyAVX2(char *to, const char *from, std::size_t n)
+{
+   // The shuffle operates within each 128 bit lane, so both lanes use the same permutation
+   char maskBytes[16];
+   FillShuffleMask<N>(maskBytes);
+   const __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i *>(maskBytes));
+   const __m256i mask = _mm256_broadcastsi128_si256(lane);
+
+   const std::size_t nVec = n * N / 32;
+   for (std::size_t i = 0; i < nVec; ++i) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + 32 * i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + 32 * i), _mm256_shuffle_epi8(v, mask));
+   }
+   const std::size_t done = nVec * 32 / N;
+   SwapCopySSSE3<N>(to + done * N, from + done * N, n - done);
+}
+
+#endif // R__BYTESWAP_SIMD
+
+template <std::size_t N>
+SwapCopyFunc_t SelectSwapCopy()
+{
+#ifdef R__BYTESWAP_SIMD
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return SwapCopyAVX2<N>;
+   if (__builtin_cpu_supports("ssse3"))
+      return SwapCopySSSE3<N>;
+#endif
+   return SwapCopyScalar<N>;
+}
+
+template <std::size_t N>
+void SwapCopy(void *to, const void *from, std::size_t n)
+{
+   // Not worth an indirect call for less than a vector register worth of data
+   if (n * N < 16) {
+      SwapCopyScalar<N>(static_cast<char *>(to), static_cast<const char *>(from), n);
+      return;
+   }
+   static const SwapCopyFunc_t swapCopy = SelectSwapCopy<N>();
+   swapCopy(static_cast<char *>(to), static_cast<const char *>(from), n);
+}
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   SwapCopy<2>(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   SwapCopy<4>(to, from, n);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   SwapCopy<8>(to, from, n);
+}
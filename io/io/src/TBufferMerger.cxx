@@ -12,7 +12,9 @@
 #include "ROOT/TBufferMerger.hxx"
 
 #include "TBufferFile.h"
+#include "TClass.h"
 #include "TError.h"
+#include "TFileMergeInfo.h"
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
@@ -144,4 +146,48 @@ bool TBufferMerger::TryMerge(ROOT::TBufferMergerFile *memfile)
       return false;
 }
 
+bool TBufferMerger::TryDirectTreeMerge(ROOT::TBufferMergerFile *memfile)
+{
+   if (!fDirectTreeMerge || fAutoSave > 0 || GetNotrees())
+      return false;
+
+   // Only a file that holds a single tree, whose baskets are all written (see TBufferMergerFile::Write),
+   // and no other objects or keys qualifies.
+   if (memfile->GetList()->GetSize() != 1 || memfile->GetListOfKeys()->GetSize() != 0)
+      return false;
+   TObject *tree = memfile->GetList()->First();
+   if (!tree->InheritsFrom("TTree"))
+      return false;
+   ROOT::MergeFunc_t merge = tree->IsA()->GetMerge();
+   if (!merge)
+      return false;
+
+   // Do not wait for a merge in progress: the file then goes through the queue like any other one.
+   std::unique_lock<std::mutex> lock(fMergeMutex, std::try_to_lock);
+   if (!lock.owns_lock())
+      return false;
+
+   // The output file and tree may only be accessed while holding the merge lock.
+   // The output tree is created by the first regular merge and then kept in memory until the
+   // TBufferMerger gets destructed.
+   TFile *output = fMerger.GetOutputFile();
+   TObject *outputTree = output ? output->GetList()->FindObject(tree->GetName()) : nullptr;
+   if (!outputTree || outputTree->IsA() != tree->IsA())
+      return false;
+
+   // With the "fast" option, TTree::Merge appends the compressed baskets without unstreaming them,
+   // in the same way as TTreeCloner. It falls back to copying entry by entry for mismatching trees.
+   TList trees;
+   trees.Add(tree);
+   TFileMergeInfo info(output);
+   info.fIsFirst = kFALSE;
+   info.fOptions = fMerger.GetMergeOptions();
+   info.fOptions.Append(" fast");
+   // On failure, the file goes through the queue, which reports the errors of the regular merge
+   if (merge(outputTree, &trees, &info) < 0)
+      return false;
+   ++fNDirectTreeMerges;
+   return true;
+}
+
 } // namespace ROOT
@@ -33,6 +33,13 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
    if (!fMerger.GetNotrees())
       TMemFile::Write(name, opt | TObject::kOnlyPrepStep, bufsize);
 
+   // If the output tree exists already, the compressed baskets are appended to it
+   // without going through TFileMerger.
+   if (fMerger.TryDirectTreeMerge(this)) {
+      ResetAfterMerge(0);
+      return 0;
+   }
+
    // Instead of Writing the TTree, doing a memcpy, Pushing to the queue
    // then Reading and then deleting, let's see if we can just merge using
    // the live TTree.
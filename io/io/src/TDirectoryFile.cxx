@@ -49,9 +49,35 @@ End_Macro
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+namespace {
+/// Size of an entry of the key index: name hash, key location and key size
+const Int_t kKeyIndexEntrySize = sizeof(ULong64_t) + sizeof(Long64_t) + sizeof(Int_t);
+/// Size of the trailer appended to the keys record if there is a key index:
+/// location and size of the index record, number of entries and kKeyIndexMagic
+const Int_t kKeyIndexTrailerSize = sizeof(Long64_t) + 3 * sizeof(Int_t);
+const Int_t kKeyIndexMagic = 0x4b494458; // "KIDX"
+/// Bytes read at once when reading a key header from the key index
+const Int_t kKeyHeaderReadSize = 256;
+
+/// Hash of a key name used by the key index; must not change, the index is persistent (64 bit FNV-1a)
+ULong64_t KeyNameHash(const char *name)
+{
+   ULong64_t hash = 14695981039346656037ULL;
+   for (const char *c = name; *c; ++c) {
+      hash ^= static_cast<unsigned char>(*c);
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+} // anonymous namespace
+
 ClassImp(TDirectoryFile);
 
 
@@ -266,7 +292,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -578,6 +604,7 @@ void TDirectoryFile::Close(Option_t *option)
    if (fKeys) {
       fKeys->Delete("slow");
    }
+   fLazyKeys = kFALSE;
 
    TDirectoryFile::CleanTargets();
 }
@@ -788,7 +815,7 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 
    DecodeNameCycle(keyname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(name));
    if (!listOfKeys) {
       Error("FindKeyAny", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -840,7 +867,7 @@ TObject *TDirectoryFile::FindObjectAny(const char *aname) const
 
    DecodeNameCycle(aname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(name));
    if (!listOfKeys) {
       Error("FindObjectAny", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -961,7 +988,7 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(namobj));
    if (!listOfKeys) {
       Error("Get", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1084,7 +1111,7 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(namobj));
    if (!listOfKeys) {
       Error("GetObjectChecked", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1125,7 +1152,7 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(name));
    if (!listOfKeys) {
       Error("GetKey", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1143,6 +1170,101 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of this directory.
+///
+/// If the keys are looked up in the key index (see the "keyindex" option of
+/// TFile::TFile), all the keys are read first.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   if (fLazyKeys)
+      const_cast<TDirectoryFile*>(this)->ReadKeys(kFALSE);
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys, which contains all the cycles of the keys named
+/// `name` that exist in this directory.
+///
+/// If the keys are looked up in the key index, only the keys with this name are
+/// read, if this was not done before. The index is sorted by the hash of the key
+/// names and is searched by reading O(log(n)) entries; only the headers of the
+/// matching keys are read.
+
+TList *TDirectoryFile::LookupKeys(const char *name) const
+{
+   if (!fLazyKeys || !fKeys || !name)
+      return fKeys;
+
+   // All the cycles of a name are read at once
+   if (fKeys->FindObject(name))
+      return fKeys;
+
+   const ULong64_t hash = KeyNameHash(name);
+   const Long64_t seekEntries = fSeekKeyIndex + fNbytesKeyIndex - (Long64_t)fNKeyIndex * kKeyIndexEntrySize;
+   char entry[kKeyIndexEntrySize];
+
+   // Find the first entry with this hash
+   Int_t first = 0;
+   Int_t count = fNKeyIndex;
+   while (count > 0) {
+      const Int_t step = count / 2;
+      char *buffer = entry;
+      ULong64_t entryHash;
+      if (fFile->ReadBuffer(entry, seekEntries + (Long64_t)(first + step) * kKeyIndexEntrySize, sizeof(ULong64_t)))
+         return fKeys;
+      frombuf(buffer, &entryHash);
+      if (entryHash < hash) {
+         first += step + 1;
+         count -= step + 1;
+      } else {
+         count = step;
+      }
+   }
+
+   // The entries with the same hash are in the order of the list of keys,
+   // i.e. the higher cycles of a name come first, as for AppendKey()
+   std::vector<char> header;
+   for (Int_t i = first; i < fNKeyIndex; ++i) {
+      char *buffer = entry;
+      if (fFile->ReadBuffer(entry, seekEntries + (Long64_t)i * kKeyIndexEntrySize, kKeyIndexEntrySize))
+         break;
+      ULong64_t entryHash;
+      Long64_t seekKey;
+      Int_t nbytes;
+      frombuf(buffer, &entryHash);
+      frombuf(buffer, &seekKey);
+      frombuf(buffer, &nbytes);
+      if (entryHash != hash)
+         break;
+
+      // Read the key header, whose length is stored after fNbytes, version, fObjlen and fDatime
+      header.resize(std::min(nbytes, kKeyHeaderReadSize));
+      if (fFile->ReadBuffer(header.data(), seekKey, header.size()))
+         break;
+      buffer = header.data() + sizeof(Int_t) + sizeof(Version_t) + 2 * sizeof(Int_t);
+      Short_t keylen;
+      frombuf(buffer, &keylen);
+      if (keylen > (Int_t)header.size()) {
+         header.resize(keylen);
+         if (fFile->ReadBuffer(header.data(), seekKey, keylen))
+            break;
+      }
+
+      TKey *key = new TKey(const_cast<TDirectoryFile*>(this));
+      buffer = header.data();
+      key->ReadKeyBuffer(buffer);
+      if (strcmp(key->GetName(), name)) {
+         // Hash collision
+         delete key;
+         continue;
+      }
+      fKeys->Add(key);
+   }
+   return fKeys;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1192,7 +1314,7 @@ void TDirectoryFile::ls(Option_t *option) const
 
    if (diskobj && fKeys) {
       //*-* Loop on all the keys
-      TObjLink *lnk = fKeys->FirstLink();
+      TObjLink *lnk = GetListOfKeys()->FirstLink();
       while (lnk) {
          TKey *key = (TKey*)lnk->GetObject();
          TString s = key->GetName();
@@ -1373,6 +1495,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    char *buffer;
    if (forceRead) {
       fKeys->Delete();
+      fLazyKeys = kFALSE;
       //In case directory was updated by another process, read new
       //position for the keys
       Int_t nbytes = fNbytesName + TDirectoryFile::Sizeof();
@@ -1407,11 +1530,20 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
    if ( fSeekKeys >  0) {
+      // With the "keyindex" option, the keys of read-only files are looked up on demand in the key index
+      if (!fLazyKeys && fKeys->IsEmpty() && fFile->TestBit(TFile::kKeyIndex) && !fFile->IsWritable()
+          && ReadKeyIndexInfo()) {
+         fLazyKeys = kTRUE;
+         return fNKeyIndex;
+      }
+
       TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
+      const char *bufferEnd = buffer + fNbytesKeys;
       headerkey->ReadKeyBuffer(buffer);
 
+      auto listOfKeys = static_cast<THashList *>(fKeys);
       TKey *key;
       frombuf(buffer, &nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
@@ -1429,14 +1561,75 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
             nkeys = i;
             break;
          }
+         if (fLazyKeys) {
+            // Skip the keys already looked up in the key index
+            Bool_t known = kFALSE;
+            if (const TList *keyList = listOfKeys->GetListForObject(key->GetName())) {
+               for (auto k : TRangeDynCast<TKey>(*keyList))
+                  known = known || (k && k->GetSeekKey() == key->GetSeekKey());
+            }
+            if (known) {
+               delete key;
+               continue;
+            }
+         }
          fKeys->Add(key);
       }
+      fLazyKeys = kFALSE;
+
+      // Remember the key index, if any, such that it can be freed when the keys are written again
+      fSeekKeyIndex = 0;
+      fNbytesKeyIndex = 0;
+      fNKeyIndex = 0;
+      if (bufferEnd - buffer == kKeyIndexTrailerSize) {
+         Int_t magic;
+         frombuf(buffer, &fSeekKeyIndex);
+         frombuf(buffer, &fNbytesKeyIndex);
+         frombuf(buffer, &fNKeyIndex);
+         frombuf(buffer, &magic);
+         if (magic != kKeyIndexMagic) {
+            fSeekKeyIndex = 0;
+            fNbytesKeyIndex = 0;
+            fNKeyIndex = 0;
+         }
+      }
       delete headerkey;
    }
 
    return nkeys;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the location of the key index from the trailer of the keys record.
+///
+/// Returns kFALSE if the directory has no key index.
+
+Bool_t TDirectoryFile::ReadKeyIndexInfo()
+{
+   if (fNbytesKeys < kKeyIndexTrailerSize)
+      return kFALSE;
+
+   char trailer[kKeyIndexTrailerSize];
+   if (fFile->ReadBuffer(trailer, fSeekKeys + fNbytesKeys - kKeyIndexTrailerSize, kKeyIndexTrailerSize))
+      return kFALSE;
+
+   char *buffer = trailer;
+   Long64_t seekIndex;
+   Int_t nbytesIndex, nindex, magic;
+   frombuf(buffer, &seekIndex);
+   frombuf(buffer, &nbytesIndex);
+   frombuf(buffer, &nindex);
+   frombuf(buffer, &magic);
+   if (magic != kKeyIndexMagic || nindex <= 0 || seekIndex < 64 || seekIndex + nbytesIndex > fFile->GetSize() ||
+       (Long64_t)nindex * kKeyIndexEntrySize > nbytesIndex)
+      return kFALSE;
+
+   fSeekKeyIndex = seekIndex;
+   fNbytesKeyIndex = nbytesIndex;
+   fNKeyIndex = nindex;
+   return kTRUE;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
@@ -1450,7 +1643,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
 {
    if (!fFile) { Error("ReadTObject","No file open"); return 0; }
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   auto listOfKeys = dynamic_cast<THashList *>(LookupKeys(keyname));
    if (!listOfKeys) {
       Error("ReadTObject", "Unexpected type of TDirectoryFile::fKeys!");
       return 0;
@@ -1490,6 +1683,10 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekDir = 0;    // updated by Init
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
+   fSeekKeyIndex = 0;
+   fNbytesKeyIndex = 0;
+   fNKeyIndex = 0;
+   fLazyKeys = kFALSE;
    // Does not change: fFile
    TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
    TClass *cl = IsA();
@@ -1667,6 +1864,10 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 {
    TDirectory::TContext ctxt(this);
 
+   // All the keys are needed to write them again
+   if (writable && fLazyKeys)
+      ReadKeys(kFALSE);
+
    fWritable = writable;
 
    // recursively set all sub-directories
@@ -2163,6 +2364,16 @@ void TDirectoryFile::WriteKeys()
    if (fSeekKeys != 0) {
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
+   if (fSeekKeyIndex != 0) {
+      f->MakeFree(fSeekKeyIndex, fSeekKeyIndex + fNbytesKeyIndex -1);
+      fSeekKeyIndex = 0;
+      fNbytesKeyIndex = 0;
+      fNKeyIndex = 0;
+   }
+//*-* Write the key index, whose location is appended to the keys record
+   if (f->TestBit(TFile::kKeyIndex)) {
+      fNKeyIndex = WriteKeyIndex();
+   }
 //*-* Write new keys record
    TIter next(fKeys);
    TKey *key;
@@ -2172,6 +2383,7 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+   if (fNKeyIndex > 0) nbytes += kKeyIndexTrailerSize;
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
@@ -2183,9 +2395,60 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       key->FillBuffer(buffer);
    }
+   if (fNKeyIndex > 0) {
+      tobuf(buffer, fSeekKeyIndex);
+      tobuf(buffer, fNbytesKeyIndex);
+      tobuf(buffer, fNKeyIndex);
+      tobuf(buffer, kKeyIndexMagic);
+   }
 
    fSeekKeys     = headerkey->GetSeekKey();
    fNbytesKeys   = headerkey->GetNbytes();
    headerkey->WriteFile();
    delete headerkey;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the key index on the file.
+///
+/// The index is a table of the keys sorted by the hash of their name, with the
+/// location and size of each key. It is written as a single data record; the
+/// entries are at the end of the record. Returns the number of entries.
+
+Int_t TDirectoryFile::WriteKeyIndex()
+{
+   const Int_t nkeys = fKeys->GetSize();
+   if (nkeys == 0)
+      return 0;
+
+   std::vector<std::pair<ULong64_t, TKey *>> entries;
+   entries.reserve(nkeys);
+   TIter next(fKeys);
+   TKey *key;
+   while ((key = (TKey*)next())) {
+      entries.emplace_back(KeyNameHash(key->GetName()), key);
+   }
+   // Keep the order of the list of keys for equal hashes, i.e. the higher cycles first
+   std::stable_sort(entries.begin(), entries.end(),
+                    [](const std::pair<ULong64_t, TKey *> &a, const std::pair<ULong64_t, TKey *> &b) {
+                       return a.first < b.first;
+                    });
+
+   TKey *indexkey = new TKey(fName.Data(), "KeyIndex", IsA(), nkeys * kKeyIndexEntrySize, this);
+   if (indexkey->GetSeekKey() == 0) {
+      delete indexkey;
+      return 0;
+   }
+   char *buffer = indexkey->GetBuffer();
+   for (const auto &entry : entries) {
+      tobuf(buffer, entry.first);
+      tobuf(buffer, entry.second->GetSeekKey());
+      tobuf(buffer, entry.second->GetNbytes());
+   }
+
+   fSeekKeyIndex   = indexkey->GetSeekKey();
+   fNbytesKeyIndex = indexkey->GetNbytes();
+   indexkey->WriteFile();
+   delete indexkey;
+   return nkeys;
+}
@@ -138,6 +138,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TThreadSlots.h"
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "ROOT/RRawFile.hxx"
 #include <memory>
 
 using std::sqrt;
@@ -312,6 +313,28 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// ~~~{.cpp}
 ///   TFile *f = TFile::Open("tmpname.root?reproducible=fixedname","RECREATE","File title");
 /// ~~~
+///
+/// A local file opened in read mode with the `"mmap"` url option is mapped
+/// read-only into memory:
+/// ~~~{.cpp}
+///   TFile *f = TFile::Open("name.root?mmap");
+/// ~~~
+/// Reads are then served from the page cache without system calls, and
+/// compressed baskets and keys are decompressed directly from the mapped memory
+/// (see TFile::GetMappedBuffer). If the file cannot be mapped, it is read as usual.
+///
+/// With the `"keyindex"` url option, each directory written to the file stores,
+/// next to its list of keys, an index of the keys sorted by the hash of their name.
+/// When such a file is opened in read mode with the same option, the keys of a
+/// directory are not read when the directory is opened; instead, a key is looked
+/// up in the index by binary search when the object is requested:
+/// ~~~{.cpp}
+///   TFile *f = TFile::Open("name.root?keyindex");
+///   auto h = f->Get<TH1>("channel123456");
+/// ~~~
+/// This makes opening directories with a very large number of keys cheap. The full
+/// list of keys is read as soon as it is requested, e.g. by GetListOfKeys() or ls().
+/// Files written with the index can be read by any ROOT version.
 
 TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t compress)
            : TDirectoryFile(), fCompress(compress), fUrl(fname1,kTRUE)
@@ -344,6 +367,9 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    if (fUrl.HasOption("reproducible"))
       SetBit(kReproducible);
 
+   if (fUrl.HasOption("keyindex"))
+      SetBit(kKeyIndex);
+
    // We are opening synchronously
    fAsyncOpenStatus = kAOSNotAsync;
 
@@ -493,6 +519,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      if (fUrl.HasOption("mmap"))
+         MapLocalFile();
    }
 
    // calling virtual methods from constructor not a good idea, but it is how code was developed
@@ -537,6 +565,7 @@ TFile::~TFile()
    SafeDelete(fArchive);
    SafeDelete(fInfoCache);
    SafeDelete(fOpenPhases);
+   UnmapLocalFile();
 
    {
       R__LOCKGUARD(gROOTMutex);
@@ -844,7 +873,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file."
                               " The file was produced with version %d.%02d/%02d of ROOT.",
                               GetName(),  fVersion / 10000, (fVersion / 100) % (100), fVersion  % 100);
@@ -854,7 +883,12 @@ void TFile::Init(Bool_t create)
    }
 
    // Count number of TProcessIDs in this file
-   {
+   if (fLazyKeys) {
+      // The TProcessIDs are numbered consecutively, see WriteProcessID()
+      while (GetKey(TString::Format("ProcessID%d", fNProcessIDs)))
+         fNProcessIDs++;
+      fProcessIDs = new TObjArray(fNProcessIDs+1);
+   } else {
       TIter next(fKeys);
       TKey *key;
       while ((key = (TKey*)next())) {
@@ -897,6 +931,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapLocalFile();
       SysClose(fD);
       fD = -1;
 
@@ -952,6 +987,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      UnmapLocalFile();
       SysClose(fD);
       fD = -1;
    }
@@ -1660,6 +1696,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMapBegin)
+         return ReadBufferViaMap(buf, len);
+
       Seek(pos);
       ssize_t siz;
 
@@ -1705,6 +1744,9 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (fMapBegin)
+         return ReadBufferViaMap(buf, len);
+
       ssize_t siz;
       Double_t start = 0;
 
@@ -1757,6 +1799,18 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   if (fMapBegin) {
+      // The blocks are copied directly from the mapped memory, without read-ahead buffer
+      Int_t k = 0;
+      for (Int_t i = 0; i < nbuf; i++) {
+         SetOffset(pos[i]);
+         if (ReadBufferViaMap(&buf[k], len[i]))
+            return kTRUE;
+         k += len[i];
+      }
+      return kFALSE;
+   }
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1842,6 +1896,93 @@ Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read a buffer from the memory mapped file at the current offset and
+/// advance the offset. Returns kTRUE in case of failure.
+
+Bool_t TFile::ReadBufferViaMap(char *buf, Int_t len)
+{
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
+
+   const char *src = GetMappedBuffer(GetRelOffset(), len);
+   if (!src) {
+      Error("ReadBuffer", "error reading %d bytes at offset %lld from file %s, beyond its end",
+            len, GetRelOffset(), GetName());
+      return kTRUE;
+   }
+   memcpy(buf, src, len);
+   fOffset += len;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the len bytes at offset pos of a file that is memory
+/// mapped (see the "mmap" option in the TFile constructor), or nullptr if the
+/// file is not mapped or the range is outside of the file.
+///
+/// The memory is read-only and remains valid until the file is closed. It allows
+/// e.g. to decompress baskets and keys without copying the compressed data first.
+/// The bytes are accounted for as read from the file.
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   pos += fArchiveOffset;
+   if (!fMapBegin || pos < 0 || len < 0 || pos + len > fMapSize)
+      return nullptr;
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+   return fMapBegin + pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the whole file read-only into memory. If the mapping is not supported
+/// or fails, the file is read through system calls as usual.
+
+void TFile::MapLocalFile()
+{
+   ROOT::Internal::RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   try {
+      auto rawFile = ROOT::Internal::RRawFile::Create(fRealName.Data(), options);
+      if (!(rawFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap)) {
+         Warning("MapLocalFile", "memory mapping is not supported for %s", GetName());
+         return;
+      }
+      const auto size = rawFile->GetSize();
+      if (size == 0)
+         return;
+      std::uint64_t mapdOffset = 0;
+      fMapBegin = static_cast<char *>(rawFile->Map(size, 0, mapdOffset));
+      fMapSize = size;
+      fMappedFile = std::move(rawFile);
+   } catch (const std::exception &e) {
+      Warning("MapLocalFile", "cannot map %s into memory, using regular reads: %s", GetName(), e.what());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file, if any.
+
+void TFile::UnmapLocalFile()
+{
+   if (!fMapBegin)
+      return;
+   fMappedFile->Unmap(fMapBegin, fMapSize);
+   fMapBegin = nullptr;
+   fMapSize = 0;
+   fMappedFile.reset();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read the FREE linked list.
 ///
@@ -2145,8 +2286,9 @@ Int_t TFile::ReOpen(Option_t *mode)
    } else {
       // switch to UPDATE mode
 
-      // close readonly file
+      // close readonly file; the mapping would not see the updates
       if (IsOpen()) {
+         UnmapLocalFile();
          SysClose(fD);
          fD = -1;
       }
@@ -2208,6 +2350,11 @@ void TFile::Seek(Long64_t offset, ERelativeTo pos)
          break;
       case kCur:
          whence = SEEK_CUR;
+         // In mapped mode, reads do not move the file descriptor
+         if (fMapBegin) {
+            whence = SEEK_SET;
+            offset += fOffset;
+         }
          break;
       case kEnd:
          whence = SEEK_END;
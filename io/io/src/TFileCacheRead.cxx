@@ -32,6 +32,8 @@
 #include "TFilePrefetch.h"
 #include "TMathBase.h"
 
+#include <chrono>
+
 ClassImp(TFileCacheRead);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -459,9 +461,11 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
       // If ReadBufferAsync is not supported by this implementation...
       if (!fAsyncReading) {
          // Then we use the vectored read to read everything now
+         const auto start = std::chrono::steady_clock::now();
          if (fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
             return -1;
          }
+         fReadTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
          fIsTransferred = kTRUE;
       } else {
          // In any case, we'll start to request the chunks.
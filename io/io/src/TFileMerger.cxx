@@ -54,6 +54,7 @@ to be merged, like the standalone hadd program.
 ClassImp(TFileMerger);
 
 TClassRef R__TH1_Class("TH1");
+TClassRef R__THnBase_Class("THnBase");
 TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
@@ -374,16 +375,23 @@ Bool_t TFileMerger::Merge(Bool_t)
 
 namespace {
 
-/// Merge a list of RNTuples
-Long64_t MergeRNTuples(TClass* rntupleHandle, const TString& /* target */, const TList& /* sources */) {
-   if (!rntupleHandle) {
+/// Merge the RNTuple called ntupleName from the given source files into the target file.  The merge function of
+/// the RNTuple anchor class expects the ntuple name (as TObjString) followed by the source files in the input list.
+/// On success, the anchor object is updated to point to the merged ntuple.
+Long64_t MergeRNTuples(TClass *rntupleHandle, void *anchor, const char *ntupleName, TList &sources,
+                       TFileMergeInfo &info)
+{
+   if (!rntupleHandle || !anchor) {
       return Long64_t(-1);
    }
-   // todo(max) implement rntuple merger
-   // [ ] build complete list of sources (some sources may actually be a directory with RNTuples inside)
-   // [ ] merge them
+   TObjString name(ntupleName);
+   TList inputs;
+   inputs.Add(&name);
+   TIter next(&sources);
+   while (auto source = next())
+      inputs.Add(source);
    ROOT::MergeFunc_t func = rntupleHandle->GetMerge();
-   return func(static_cast<void*>(rntupleHandle), nullptr, nullptr);
+   return func(anchor, &inputs, &info);
 }
 
 Bool_t IsMergeable(TClass *cl)
@@ -596,10 +604,20 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
    } else if (!cl->IsTObject() && cl->GetMerge()) {
       // merge objects that don't derive from TObject
       if (std::string(keyclassname) == "ROOT::Experimental::RNTuple") {
+         if (alreadyseen) return kTRUE;
          Warning("MergeRecursive", "merging RNTuples is experimental");
-         // todo(max): check if this works when a TDirectory is passed as the first
-         // input argument
-         Long64_t mergeResult = MergeRNTuples(cl, *path, *sourcelist);
+         if (!current_file || target != target->GetFile()) {
+            Error("MergeRecursive", "RNTuple %s: only non-incremental merging of top-level RNTuples is supported",
+                  keyname);
+            return kFALSE;
+         }
+         // Collect all the source files, starting with the current one, that contain the RNTuple
+         TList rntupleSources;
+         for (TFile *nextsource = current_file; nextsource; nextsource = (TFile*)sourcelist->After(nextsource)) {
+            if (nextsource->GetListOfKeys()->FindObject(keyname))
+               rntupleSources.Add(nextsource);
+         }
+         Long64_t mergeResult = MergeRNTuples(cl, obj, keyname, rntupleSources, info);
          if (mergeResult < 0) {
             Error("MergeRecursive", "error merging RNTuples");
             return kFALSE;
@@ -616,7 +634,8 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
 
       TList inputs;
       TList todelete;
-      Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+      // histograms with identical binning sum all inputs at once, in parallel chunks of bins
+      Bool_t oneGo = fHistoOneGo && (cl->InheritsFrom(R__TH1_Class) || cl->InheritsFrom(R__THnBase_Class));
 
       // Loop over all source files and merge same-name object
       TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
@@ -769,16 +769,22 @@ TObject *TKey::ReadObj()
    bufferRef.SetPidOffset(fPidOffset);
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      if( !ReadFile() )                    //Read object structure from file
-      {
-        fBuffer = 0;
-        return 0;
+      // For memory mapped files, decompress in place
+      compressed = GetFile()->GetMappedBuffer(fSeekKey, fNbytes);
+      if (!compressed) {
+         compressedBuffer.reset(new char[fNbytes]);
+         fBuffer = compressedBuffer.get();
+         if( !ReadFile() )                    //Read object structure from file
+         {
+           fBuffer = 0;
+           return 0;
+         }
+         compressed = fBuffer;
       }
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       if( !ReadFile() ) {                   //Read object structure from file
@@ -816,7 +822,7 @@ TObject *TKey::ReadObj()
 
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1024,12 +1030,18 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    bufferRef.SetPidOffset(fPidOffset);
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      // For memory mapped files, decompress in place
+      compressed = GetFile()->GetMappedBuffer(fSeekKey, fNbytes);
+      if (!compressed) {
+         compressedBuffer.reset(new char[fNbytes]);
+         fBuffer = compressedBuffer.get();
+         ReadFile();                    //Read object structure from file
+         compressed = fBuffer;
+      }
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       ReadFile();                    //Read object structure from file
@@ -1085,7 +1097,7 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
 
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1158,12 +1170,18 @@ Int_t TKey::Read(TObject *obj)
       bufferRef.MapObject(obj);  //register obj in map to handle self reference
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      // For memory mapped files, decompress in place
+      compressed = GetFile()->GetMappedBuffer(fSeekKey, fNbytes);
+      if (!compressed) {
+         compressedBuffer.reset(new char[fNbytes]);
+         fBuffer = compressedBuffer.get();
+         ReadFile();                    //Read object structure from file
+         compressed = fBuffer;
+      }
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       ReadFile();                    //Read object structure from file
@@ -1173,7 +1191,7 @@ Int_t TKey::Read(TObject *obj)
    bufferRef.SetBufferOffset(fKeylen);
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -210,6 +210,16 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t ReadBasicArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      // Fixed size array or group of consecutive data members of the same type: convert all the
+      // values at once rather than element by element.
+      T *x = (T*)( ((char*)addr) + config->fOffset );
+      buf.ReadFastArray(x, config->fCompInfo->fLength);
+      return 0;
+   }
+
    void HandleReferencedTObject(TBuffer &buf, void *addr, const TConfiguration *config) {
       TBitsConfiguration *conf = (TBitsConfiguration*)config;
       UShort_t pidf;
@@ -3108,17 +3118,19 @@ void TStreamerInfo::Compile()
       fComp[fNdata].fClassName = TString(element->GetTypeName()).Strip(TString::kTrailing, '*');
       fComp[fNdata].fStreamer = element->GetStreamer();
 
-      // try to group consecutive members of the same type
+      // try to group consecutive members of the same type, including fixed size arrays,
+      // such that they are read and converted as a single contiguous array
       if (!TestBit(kCannotOptimize)
           && (keep >= 0)
           && (element->GetType() > 0)
-          && (element->GetType() < 10)
+          && ((element->GetType() < 10)
+              || ((element->GetType() > kOffsetL) && (element->GetType() < kOffsetL + 10) && (element->GetArrayLength() > 0)))
           && (fComp[fNdata].fType == fComp[fNdata].fNewType)
           && (fComp[keep].fMethod == 0)
-          && (element->GetArrayDim() == 0)
           && (fComp[keep].fType < kObject)
           && (fComp[keep].fType != kCharStar) /* do not optimize char* */
-          && (element->GetType() == (fComp[keep].fType%kRegrouped))
+          && (fComp[keep].fType != kCharStar + kOffsetL)
+          && ((element->GetType()%kRegrouped) == (fComp[keep].fType%kRegrouped))
           && ((element->GetOffset()-fComp[keep].fOffset) == (fComp[keep].fLength)*asize)
           && ((fOldVersion<6) || !previous || /* In version of TStreamerInfo less than 6, the Double32_t were merged even if their annotation (aka factor) were different */
               ((element->GetFactor() == previous->GetFactor())
@@ -3145,8 +3157,8 @@ void TStreamerInfo::Compile()
          if (fComp[keep].fLength == 0) {
             fComp[keep].fLength++;
          }
-         fComp[keep].fLength++;
-         fComp[keep].fType = element->GetType() + kRegrouped;
+         fComp[keep].fLength += element->GetArrayLength() ? element->GetArrayLength() : 1;
+         fComp[keep].fType = (element->GetType()%kRegrouped) + kRegrouped;
          isOptimized = kTRUE;
          previousOptimized = kTRUE;
       } else if (element->GetType() < 0) {
@@ -3282,6 +3294,20 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
       case TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
       case TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
       case TStreamerInfo::kBits:    readSequence->AddAction( ReadBasicType<BitsMarker>, new TBitsConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
+      // read arrays of basic types and regrouped consecutive data members
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool:    readSequence->AddAction( ReadBasicArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar:    readSequence->AddAction( ReadBasicArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort:   readSequence->AddAction( ReadBasicArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt:     readSequence->AddAction( ReadBasicArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong:    readSequence->AddAction( ReadBasicArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64:  readSequence->AddAction( ReadBasicArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat:   readSequence->AddAction( ReadBasicArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble:  readSequence->AddAction( ReadBasicArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar:   readSequence->AddAction( ReadBasicArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort:  readSequence->AddAction( ReadBasicArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );  break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt:    readSequence->AddAction( ReadBasicArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
             readSequence->AddAction( ReadBasicType_WithFactor<float>, new TConfWithFactor(this,i,compinfo,compinfo->fOffset,element->GetFactor(),element->GetXmin()) );
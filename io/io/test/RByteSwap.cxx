@@ -0,0 +1,161 @@
+#include "ROOT/RByteSwap.hxx"
+#include "RegroupedArrays.h"
+#include "TAttAxis.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TStreamerInfo.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+TEST(RByteSwap, Kernels)
+{
+   // Cover the vector kernels as well as the scalar remainders
+   for (std::size_t n = 0; n < 70; ++n) {
+      std::vector<std::uint16_t> in16(n), out16(n);
+      std::vector<std::uint32_t> in32(n), out32(n);
+      std::vector<std::uint64_t> in64(n), out64(n);
+      for (std::size_t i = 0; i < n; ++i) {
+         in16[i] = 0x0102 * (i + 1);
+         in32[i] = 0x01020304u * (i + 1);
+         in64[i] = 0x0102030405060708ull * (i + 1);
+      }
+      ROOT::Internal::ByteSwapCopy16(out16.data(), in16.data(), n);
+      ROOT::Internal::ByteSwapCopy32(out32.data(), in32.data(), n);
+      ROOT::Internal::ByteSwapCopy64(out64.data(), in64.data(), n);
+      for (std::size_t i = 0; i < n; ++i) {
+         EXPECT_EQ(static_cast<std::uint16_t>((in16[i] >> 8) | (in16[i] << 8)), out16[i]);
+         EXPECT_EQ(in32[i], (out32[i] >> 24) | ((out32[i] >> 8) & 0xff00) | ((out32[i] << 8) & 0xff0000) |
+                               (out32[i] << 24));
+         std::uint64_t back = 0;
+         for (int b = 0; b < 8; ++b)
+            back |= ((out64[i] >> (8 * b)) & 0xff) << (8 * (7 - b));
+         EXPECT_EQ(in64[i], back);
+      }
+   }
+}
+
+TEST(RByteSwap, FastArrayRoundTrip)
+{
+   for (Int_t n : {1, 3, 8, 17, 100}) {
+      std::vector<Float_t> f(n), fr(n);
+      std::vector<Double_t> d(n), dr(n);
+      std::vector<Short_t> h(n), hr(n);
+      for (Int_t i = 0; i < n; ++i) {
+         f[i] = 0.5f * i - 3;
+         d[i] = 1e10 * i - 7;
+         h[i] = -3 * i;
+      }
+      TBufferFile buf(TBuffer::kWrite);
+      buf.WriteFastArray(f.data(), n);
+      buf.WriteFastArray(d.data(), n);
+      buf.WriteFastArray(h.data(), n);
+      buf.SetReadMode();
+      buf.SetBufferOffset(0);
+      buf.ReadFastArray(fr.data(), n);
+      buf.ReadFastArray(dr.data(), n);
+      buf.ReadFastArray(hr.data(), n);
+      EXPECT_EQ(f, fr);
+      EXPECT_EQ(d, dr);
+      EXPECT_EQ(h, hr);
+   }
+}
+
+// Consecutive data members of the same type are read as one array
+TEST(RByteSwap, RegroupedMembers)
+{
+   TAttAxis att;
+   att.SetNdivisions(504);
+   att.SetAxisColor(2);
+   att.SetLabelColor(3);
+   att.SetLabelFont(42);
+   att.SetLabelOffset(0.01);
+   att.SetLabelSize(0.05);
+   att.SetTickLength(0.02);
+   att.SetTitleOffset(1.3);
+   att.SetTitleSize(0.06);
+   att.SetTitleColor(4);
+   att.SetTitleFont(62);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.StreamObject(&att, TAttAxis::Class());
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   TAttAxis read;
+   buf.StreamObject(&read, TAttAxis::Class());
+
+   EXPECT_EQ(att.GetNdivisions(), read.GetNdivisions());
+   EXPECT_EQ(att.GetAxisColor(), read.GetAxisColor());
+   EXPECT_EQ(att.GetLabelColor(), read.GetLabelColor());
+   EXPECT_EQ(att.GetLabelFont(), read.GetLabelFont());
+   EXPECT_FLOAT_EQ(att.GetLabelOffset(), read.GetLabelOffset());
+   EXPECT_FLOAT_EQ(att.GetLabelSize(), read.GetLabelSize());
+   EXPECT_FLOAT_EQ(att.GetTickLength(), read.GetTickLength());
+   EXPECT_FLOAT_EQ(att.GetTitleOffset(), read.GetTitleOffset());
+   EXPECT_FLOAT_EQ(att.GetTitleSize(), read.GetTitleSize());
+   EXPECT_EQ(att.GetTitleColor(), read.GetTitleColor());
+   EXPECT_EQ(att.GetTitleFont(), read.GetTitleFont());
+}
+
+// Fixed size arrays are regrouped with the neighbouring scalars of the same type
+TEST(RByteSwap, RegroupedArrays)
+{
+   auto info = static_cast<TStreamerInfo *>(RegroupedArrays::Class()->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+   EXPECT_EQ(10, info->GetNelement());
+   ASSERT_EQ(5, info->GetNdata());
+   EXPECT_EQ(TStreamerInfo::kOffsetL + TStreamerInfo::kFloat, info->GetType(0));
+   EXPECT_EQ(5, info->GetLength(0));
+   EXPECT_EQ(TStreamerInfo::kOffsetL + TStreamerInfo::kInt, info->GetType(1));
+   EXPECT_EQ(6, info->GetLength(1));
+   EXPECT_EQ(TStreamerInfo::kOffsetL + TStreamerInfo::kDouble, info->GetType(2));
+   EXPECT_EQ(5, info->GetLength(2));
+   EXPECT_EQ(TStreamerInfo::kOffsetL + TStreamerInfo::kShort, info->GetType(3));
+   EXPECT_EQ(4, info->GetLength(3));
+   EXPECT_EQ(TStreamerInfo::kOffsetL + TStreamerInfo::kLong64, info->GetType(4));
+   EXPECT_EQ(4, info->GetLength(4));
+
+   RegroupedArrays obj;
+   obj.fFirst = 1.5f;
+   for (int i = 0; i < 3; ++i)
+      obj.fFloats[i] = -0.25f * (i + 1);
+   obj.fLast = 1e7f;
+   for (int i = 0; i < 5; ++i)
+      obj.fInts[i] = -100000 * (i + 1);
+   obj.fInt = 123456789;
+   obj.fDouble = -1e-300;
+   for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+         obj.fDoubles[i][j] = 1e100 * (2 * i + j + 1);
+   for (int i = 0; i < 3; ++i)
+      obj.fShorts[i] = -300 * (i + 1);
+   obj.fShort = 32000;
+   for (int i = 0; i < 4; ++i)
+      obj.fLongs[i] = -0x0102030405060708ll * (i + 1);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.StreamObject(&obj, RegroupedArrays::Class());
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   RegroupedArrays read;
+   buf.StreamObject(&read, RegroupedArrays::Class());
+
+   EXPECT_EQ(obj.fFirst, read.fFirst);
+   for (int i = 0; i < 3; ++i)
+      EXPECT_EQ(obj.fFloats[i], read.fFloats[i]);
+   EXPECT_EQ(obj.fLast, read.fLast);
+   for (int i = 0; i < 5; ++i)
+      EXPECT_EQ(obj.fInts[i], read.fInts[i]);
+   EXPECT_EQ(obj.fInt, read.fInt);
+   EXPECT_EQ(obj.fDouble, read.fDouble);
+   for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+         EXPECT_EQ(obj.fDoubles[i][j], read.fDoubles[i][j]);
+   for (int i = 0; i < 3; ++i)
+      EXPECT_EQ(obj.fShorts[i], read.fShorts[i]);
+   EXPECT_EQ(obj.fShort, read.fShort);
+   for (int i = 0; i < 4; ++i)
+      EXPECT_EQ(obj.fLongs[i], read.fLongs[i]);
+}
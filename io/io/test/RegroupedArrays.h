@@ -0,0 +1,26 @@
+#ifndef ROOT_IO_TEST_REGROUPEDARRAYS
+#define ROOT_IO_TEST_REGROUPEDARRAYS
+
+#include "Rtypes.h"
+
+// Fixed size arrays next to scalar data members of the same basic type. TStreamerInfo::Compile
+// regroups each run into a single element that is read with one ReadFastArray call.
+class RegroupedArrays {
+public:
+   virtual ~RegroupedArrays() {} // to make dictionary generation happy
+
+   Float_t fFirst = 0;
+   Float_t fFloats[3] = {0, 0, 0};
+   Float_t fLast = 0;
+   Int_t fInts[5] = {0, 0, 0, 0, 0};
+   Int_t fInt = 0;
+   Double_t fDouble = 0;
+   Double_t fDoubles[2][2] = {{0, 0}, {0, 0}};
+   Short_t fShorts[3] = {0, 0, 0};
+   Short_t fShort = 0;
+   Long64_t fLongs[4] = {0, 0, 0, 0};
+
+   ClassDef(RegroupedArrays, 1)
+};
+
+#endif
@@ -0,0 +1,5 @@
+#ifdef __ROOTCLING__
+
+#pragma link C++ class RegroupedArrays+;
+
+#endif
@@ -266,3 +266,52 @@ TEST(TBufferMerger, SetMaxTreeSize)
 
    RemoveFile("tbuffermerger_setmaxtreesize.root");
 }
+
+TEST(TBufferMerger, DirectTreeMerge)
+{
+   ROOT::EnableThreadSafety();
+
+   for (bool direct : {true, false}) {
+      {
+         TBufferMerger merger("tbuffermerger_direct.root");
+         merger.SetDirectTreeMerge(direct);
+         EXPECT_EQ(direct, merger.GetDirectTreeMerge());
+
+         auto myfile = merger.GetFile();
+         auto mytree = new TTree("mytree", "mytree");
+         mytree->SetAutoFlush(0);
+
+         int n = 0;
+         mytree->Branch("n", &n, "n/I");
+
+         // The first write creates the output tree, the following ones are appended to it
+         for (int i = 0; i < 1024; ++i) {
+            n = i;
+            mytree->Fill();
+            if (i % 256 == 255)
+               myfile->Write();
+         }
+         mytree->ResetBranchAddresses();
+
+         // The first write creates the output tree through the regular merge
+         EXPECT_EQ(direct ? 3u : 0u, merger.GetNDirectTreeMerges());
+      }
+
+      TFile f("tbuffermerger_direct.root");
+      auto t = f.Get<TTree>("mytree");
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(1024, t->GetEntries());
+
+      int n = 0, sum = 0;
+      t->SetBranchAddress("n", &n);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         EXPECT_EQ(i, n);
+         sum += n;
+      }
+      EXPECT_EQ(523776, sum);
+      delete t;
+   }
+
+   RemoveFile("tbuffermerger_direct.root");
+}
@@ -1,3 +1,5 @@
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -85,3 +87,82 @@ TEST(TFile, ReadFromSameFile)
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
 }
+
+TEST(TFile, ReadMapped)
+{
+   const auto filename = "tfile_readmapped.root";
+   const std::string title(10000, 'x'); // Compressible, such that the key is read in place
+   {
+      TFile f(filename, "RECREATE");
+      TNamed named("named", title.c_str());
+      f.WriteObject(&named, "named");
+   }
+
+   TFile f((std::string(filename) + "?mmap").c_str());
+   ASSERT_FALSE(f.IsZombie());
+#ifndef R__WIN32
+   EXPECT_TRUE(f.IsMapped());
+   auto header = f.GetMappedBuffer(0, 4);
+   ASSERT_TRUE(header != nullptr);
+   EXPECT_EQ(0, memcmp(header, "root", 4));
+   EXPECT_EQ(nullptr, f.GetMappedBuffer(f.GetSize() - 2, 4));
+#endif
+
+   auto bytesRead = f.GetBytesRead();
+   auto named = f.Get<TNamed>("named");
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_EQ(title, named->GetTitle());
+   EXPECT_GT(f.GetBytesRead(), bytesRead);
+
+   f.Close();
+   EXPECT_FALSE(f.IsMapped());
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, KeyIndex)
+{
+   const auto filename = "tfile_keyindex.root";
+   const int nKeys = 1000;
+   {
+      TFile f((std::string(filename) + "?keyindex").c_str(), "RECREATE");
+      for (int i = 0; i < nKeys; ++i) {
+         TNamed named("named", std::to_string(i).c_str());
+         f.WriteObject(&named, ("named" + std::to_string(i)).c_str());
+      }
+      // Second cycle
+      TNamed named("named", "cycle2");
+      f.WriteObject(&named, "named7");
+      auto dir = f.mkdir("dir");
+      dir->WriteObject(&named, "inner");
+   }
+
+   // Files with a key index are readable as usual
+   {
+      TFile f(filename);
+      EXPECT_EQ(nKeys + 2, f.GetNkeys());
+      EXPECT_STREQ("42", f.Get<TNamed>("named42")->GetTitle());
+   }
+
+   TFile f((std::string(filename) + "?keyindex").c_str());
+   ASSERT_FALSE(f.IsZombie());
+   EXPECT_EQ(nKeys + 2, f.GetNkeys());
+
+   auto bytesRead = f.GetBytesRead();
+   auto named = f.Get<TNamed>("named123");
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_STREQ("123", named->GetTitle());
+   // Only a few index entries and one key header are read, not the list of all keys
+   EXPECT_LT(f.GetBytesRead() - bytesRead, 1000);
+
+   EXPECT_STREQ("cycle2", f.Get<TNamed>("named7")->GetTitle());
+   EXPECT_STREQ("7", f.Get<TNamed>("named7;1")->GetTitle());
+   EXPECT_EQ(nullptr, f.Get<TNamed>("nonexistent"));
+   EXPECT_STREQ("cycle2", f.Get<TNamed>("dir/inner")->GetTitle());
+
+   // The full list of keys does not contain the keys looked up before twice
+   EXPECT_EQ(nKeys + 2, f.GetListOfKeys()->GetSize());
+   EXPECT_STREQ("999", f.Get<TNamed>("named999")->GetTitle());
+
+   f.Close();
+   gSystem->Unlink(filename);
+}
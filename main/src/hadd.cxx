@@ -27,6 +27,8 @@
   \param -O   Re-optimize basket size when merging TTree
   \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default
   \param -j   Parallelise the execution in multiple processes
+  \param -mt  Parallelise the execution in multiple threads of the hadd process (optionally followed by the number
+              of threads); the partial results are stored and merged like for -j
   \param -dbg  Parallelise the execution in multiple processes in debug mode (Does not delete  partial  files  stored
               inside working directory)
   \param -d   Carry out the partial multiprocess execution in the specified directory
@@ -80,6 +82,13 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  With -j or -mt, the source files are split into groups which are merged concurrently into
+  partial files. The partial files are then merged into the target file. Compared to -j,
+  -mt avoids starting one process per group, and thus the initialization of ROOT in each of
+  them, which matters when merging many small files. As all the groups are merged within
+  one process, -n limits the number of files opened by all the groups together; by default,
+  the system limit is shared by the groups.
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -98,6 +107,7 @@
 */
 #include "Compression.h"
 #include <ROOT/RConfig.hxx>
+#include "RConfigure.h"
 #include "ROOT/TIOFeatures.hxx"
 #include "TFile.h"
 #include "THashList.h"
@@ -108,6 +118,7 @@
 #include "ROOT/StringConv.hxx"
 #include "snprintf.h"
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -120,6 +131,10 @@
 #ifndef R__WIN32
 #include "ROOT/TProcessExecutor.hxx"
 #endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -139,6 +154,7 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -213,6 +229,38 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-mt") == 0) {
+         // If the number of threads is not specified, use the default.
+         // The following argument is the target file if it is not made only of digits, e.g. 2018_merged.root
+         Bool_t hasFollowupNumber = a + 1 != argc && argv[a + 1][0] != '\0';
+         if (hasFollowupNumber) {
+            for (char *c = argv[a + 1]; *c != '\0'; ++c) {
+               if (!isdigit(*c)) {
+                  hasFollowupNumber = kFALSE;
+                  break;
+               }
+            }
+         }
+         if (hasFollowupNumber) {
+            Long_t request = strtol(argv[a + 1], 0, 10);
+            if (request < kMaxLong && request > 0) {
+               nProcesses = (Int_t)request;
+               ++a;
+               ++ffirst;
+               std::cout << "Parallelizing  with " << nProcesses << " threads.\n";
+            } else {
+               std::cerr << "Error: could not parse the number of threads to use passed after -mt: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+#ifdef R__USE_IMT
+         multithread = kTRUE;
+#else
+         std::cerr << "Warning: hadd was built without support for multi-threading;"
+                   << " parallelizing in multiple processes instead.\n";
+#endif
+         multiproc = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -361,6 +409,11 @@ int main( int argc, char **argv )
       }
    }
 
+#if defined(R__WIN32) && defined(R__USE_IMT)
+   // Multiple processes are not supported on Windows
+   multithread = multiproc;
+#endif
+
    gSystem->Load("libTreePlayer");
 
    const char *targetname = 0;
@@ -430,18 +483,20 @@ int main( int argc, char **argv )
       // At least 3 files per process
       step = 3;
       nProcesses = (filesToProcess + step - 1) / step;
-      std::cout << "Each process should handle at least 3 files for efficiency.";
-      std::cout << " Setting the number of processes to: " << nProcesses << std::endl;
+      const char *workers = multithread ? "thread" : "process";
+      std::cout << "Each " << workers << " should handle at least 3 files for efficiency.";
+      std::cout << " Setting the number of " << (multithread ? "threads" : "processes") << " to: " << nProcesses
+                << std::endl;
    }
    if (nProcesses == 1)
       multiproc = kFALSE;
 
    std::vector<std::string> partialFiles;
 
-#ifndef R__WIN32
+#if !defined(R__WIN32) || defined(R__USE_IMT)
    // this is commented out only to try to prevent false positive detection
-   // from several anti-virus engines on Windows, and multiproc is not
-   // supported on Windows anyway
+   // from several anti-virus engines on Windows, and multiproc is only
+   // supported with threads on Windows
    if (multiproc) {
       auto uuid = TUUID();
       auto partialTail = uuid.AsString();
@@ -507,6 +562,9 @@ int main( int argc, char **argv )
       mergerP.SetPrintLevel(verbosity - 1);
       if (maxopenedfiles > 0) {
          mergerP.SetMaxOpenedFiles(maxopenedfiles / nProcesses);
+      } else if (multithread) {
+         // All the threads share the limit of the process
+         mergerP.SetMaxOpenedFiles(std::max(mergerP.GetMaxOpenedFiles() / nProcesses, 2));
       }
       if (!mergerP.OutputFile(partialFiles[(start - ffirst) / step].c_str(), newcomp)) {
          std::cerr << "hadd error opening target partial file" << std::endl;
@@ -524,10 +582,23 @@ int main( int argc, char **argv )
 
    Bool_t status;
 
-#ifndef R__WIN32
+#if !defined(R__WIN32) || defined(R__USE_IMT)
    if (multiproc) {
-      ROOT::TProcessExecutor p(nProcesses);
-      auto res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
+      std::vector<Bool_t> res;
+#ifdef R__USE_IMT
+      if (multithread) {
+         // The groups of files are merged by independent TFileMergers, each with its own output file
+         ROOT::EnableThreadSafety();
+         ROOT::TThreadExecutor pool(nProcesses);
+         res = pool.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
+      }
+#endif
+#ifndef R__WIN32
+      if (!multithread) {
+         ROOT::TProcessExecutor p(nProcesses);
+         res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
+      }
+#endif
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
       if (status) {
          status = reductionFunc();
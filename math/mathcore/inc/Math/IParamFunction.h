@@ -127,6 +127,17 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+            Evaluate the function at the n points x and for given parameters p, storing the values in out.
+            The coordinates of the points are stored one point after the other, i.e. the point i
+            starts at x + i * NDim().
+            Use the virtual function DoEvalParVec to implement it
+         */
+         void EvalParVec(const T *x, std::size_t n, const double *p, T *out) const
+         {
+            DoEvalParVec(x, n, p, out);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -134,6 +145,17 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the evaluation at many points. By default DoEvalPar is called for each point;
+            derived classes can re-implement it with a faster loop
+         */
+         virtual void DoEvalParVec(const T *x, std::size_t n, const double *p, T *out) const
+         {
+            const unsigned int ndim = this->NDim();
+            for (std::size_t i = 0; i < n; ++i)
+               out[i] = DoEvalPar(x + i * ndim, p);
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
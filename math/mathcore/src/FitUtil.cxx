@@ -195,6 +195,33 @@ namespace ROOT {
          }
 
 
+         // evaluate the model function at the n points of one-dimensional data, whose coordinates x are contiguous.
+         // The points are passed by chunks to IModelFunction::EvalParVec, which can evaluate them in a
+         // vectorized loop (e.g. for a TFormula); the chunks are evaluated in parallel in the multi-thread case
+         void EvaluateModelValues(const IModelFunction &func, const double *x, unsigned int n, const double *p,
+                                  double *fval, ROOT::EExecutionPolicy executionPolicy, unsigned nChunks)
+         {
+#ifdef R__USE_IMT
+            if (executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
+               auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(n);
+               unsigned int step = (n + chunks - 1) / chunks;
+               auto evalChunk = [&](unsigned int ichunk) {
+                  unsigned int begin = ichunk * step;
+                  unsigned int end = std::min(n, begin + step);
+                  if (begin < end)
+                     func.EvalParVec(x + begin, end - begin, p, fval + begin);
+               };
+               ROOT::TThreadExecutor pool;
+               pool.Foreach(evalChunk, ROOT::TSeq<unsigned>(0, chunks));
+               return;
+            }
+#else
+            (void)executionPolicy;
+            (void)nChunks;
+#endif
+            func.EvalParVec(x, n, p, fval);
+         }
+
          // calculation of the integral of the gradient functions
          // for a function providing derivative w.r.t parameters
          // x1 and x2 defines the integration interval , p the parameters
@@ -275,6 +302,10 @@ namespace ROOT {
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
+   // function values of all points, used instead of evaluating the function point by point
+   // when the data are one-dimensional and neither the bin integral nor the bin volume are used
+   std::vector<double> fvalues;
+
    auto mapFunction = [&](const unsigned i){
 
       double chi2{};
@@ -313,7 +344,11 @@ namespace ROOT {
       }
 
 
-      if (!useBinIntegral) {
+      if (!fvalues.empty()) {
+         // function values computed before for all points
+         fval = fvalues[i];
+      }
+      else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
          fval = func ( x );
 #else
@@ -391,6 +426,11 @@ namespace ROOT {
   }
 #endif
 
+  if (!useBinIntegral && !useBinVolume && data.NDim() == 1 && n > 0) {
+     fvalues.resize(n);
+     EvaluateModelValues(func, data.GetCoordComponent(0, 0), n, p, fvalues.data(), executionPolicy, nChunks);
+  }
+
   double res{};
   if(executionPolicy == ROOT::EExecutionPolicy::kSequential){
     for (unsigned int i=0; i<n; ++i) {
@@ -972,12 +1012,19 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
 
          // needed to compue effective global weight in case of extended likelihood
 
+         // function values of all points, used instead of evaluating the function point by point
+         // when the data are one-dimensional
+         std::vector<double> fvalues;
+
          auto mapFunction = [&](const unsigned i) {
             double W = 0;
             double W2 = 0;
             double fval = 0;
 
-            if (data.NDim() > 1) {
+            if (!fvalues.empty()) {
+               // function values computed before for all points
+               fval = fvalues[i];
+            } else if (data.NDim() > 1) {
                std::vector<double> x(data.NDim());
                for (unsigned int j = 0; j < data.NDim(); ++j)
                   x[j] = *data.GetCoordComponent(i, j);
@@ -1043,6 +1090,11 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   }
 #endif
 
+  if (data.NDim() == 1 && n > 0) {
+     fvalues.resize(n);
+     EvaluateModelValues(func, data.GetCoordComponent(0, 0), n, p, fvalues.data(), executionPolicy, nChunks);
+  }
+
   double logl{};
   double sumW{};
   double sumW2{};
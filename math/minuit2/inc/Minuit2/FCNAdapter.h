@@ -33,7 +33,7 @@ template <class Function>
 class FCNAdapter : public FCNBase {
 
 public:
-   FCNAdapter(const Function &f, double up = 1.) : fFunc(f), fUp(up) {}
+   FCNAdapter(const Function &f, double up = 1.) : fFunc(f), fUp(up), fThreadSafe(false) {}
 
    ~FCNAdapter() {}
 
@@ -43,6 +43,10 @@ public:
 
    void SetErrorDef(double up) { fUp = up; }
 
+   // declare that the wrapped function can be evaluated concurrently
+   void SetThreadSafe(bool on) { fThreadSafe = on; }
+   bool IsThreadSafe() const { return fThreadSafe; }
+
    // virtual std::vector<double> Gradient(const std::vector<double>&) const;
 
    // forward interface
@@ -51,6 +55,7 @@ public:
 private:
    const Function &fFunc;
    double fUp;
+   bool fThreadSafe;
 };
 
 } // end namespace Minuit2
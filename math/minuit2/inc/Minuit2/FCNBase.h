@@ -104,6 +104,13 @@ public:
        Re-implement this function if needed.
    */
    virtual void SetErrorDef(double){};
+
+   /**
+       Return true if the function can be evaluated concurrently from several threads.
+       Re-implement it to allow the parallel computation of the numerical gradient
+       (see MnStrategy::SetParallelGradient).
+   */
+   virtual bool IsThreadSafe() const { return false; }
 };
 
 } // namespace Minuit2
@@ -34,7 +34,10 @@ template <class Function>
 class FCNGradAdapter : public FCNGradientBase {
 
 public:
-   FCNGradAdapter(const Function &f, double up = 1.) : fFunc(f), fUp(up), fGrad(std::vector<double>(fFunc.NDim())) {}
+   FCNGradAdapter(const Function &f, double up = 1.)
+      : fFunc(f), fUp(up), fGrad(std::vector<double>(fFunc.NDim())), fThreadSafe(false)
+   {
+   }
 
    ~FCNGradAdapter() {}
 
@@ -43,6 +46,10 @@ public:
 
    double Up() const override { return fUp; }
 
+   // declare that the wrapped function can be evaluated concurrently
+   void SetThreadSafe(bool on) { fThreadSafe = on; }
+   bool IsThreadSafe() const override { return fThreadSafe; }
+
    std::vector<double> Gradient(const std::vector<double> &v) const override
    {
       fFunc.Gradient(&v[0], &fGrad[0]);
@@ -82,6 +89,7 @@ private:
    const Function &fFunc;
    double fUp;
    mutable std::vector<double> fGrad;
+   bool fThreadSafe;
 };
 
 } // end namespace Minuit2
@@ -47,6 +47,7 @@ public:
    unsigned int HessianGradientNCycles() const { return fHessGradNCyc; }
 
    int StorageLevel() const { return fStoreLevel; }
+   bool ParallelGradient() const { return fParallelGradient; }
 
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
@@ -69,6 +70,10 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // compute the numerical gradient with the components spread over the ROOT implicit multi-threading
+   // thread pool; used only if the FCN declares itself thread safe (FCNBase::IsThreadSafe)
+   void SetParallelGradient(bool on = true) { fParallelGradient = on; }
+
 private:
    unsigned int fStrategy;
 
@@ -80,6 +85,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   bool fParallelGradient;
 };
 
 } // namespace Minuit2
@@ -499,6 +499,19 @@ bool Minuit2Minimizer::Minimize()
       if (ret)
          SetStorageLevel(storageLevel);
 
+      // compute the numerical gradient in parallel with implicit multi-threading: setting this option
+      // declares that the function can be evaluated concurrently from several threads
+      int parallelGradient = 0;
+      minuit2Opt->GetValue("ParallelGradient", parallelGradient);
+      if (parallelGradient != 0) {
+         strategy.SetParallelGradient(true);
+         if (auto adapter = dynamic_cast<ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> *>(fMinuitFCN))
+            adapter->SetThreadSafe(true);
+         else if (auto gradAdapter =
+                     dynamic_cast<ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> *>(fMinuitFCN))
+            gradAdapter->SetThreadSafe(true);
+      }
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
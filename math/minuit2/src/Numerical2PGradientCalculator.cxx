@@ -10,6 +10,7 @@
 #include "Minuit2/Numerical2PGradientCalculator.h"
 #include "Minuit2/InitialGradientCalculator.h"
 #include "Minuit2/MnFcn.h"
+#include "Minuit2/FCNBase.h"
 #include "Minuit2/MnUserTransformation.h"
 #include "Minuit2/MnMachinePrecision.h"
 #include "Minuit2/MinimumParameters.h"
@@ -21,6 +22,15 @@
 #include <omp.h>
 #endif
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h" // for R__USE_IMT
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <mutex>
+#endif
+
 #include <cmath>
 #include <cassert>
 #include <iomanip>
@@ -97,35 +107,9 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 
    print.Debug("Calculating gradient around value", fcnmin, "at point", par.Vec());
 
-#ifndef _OPENMP
-
-   MPIProcess mpiproc(n, 0);
-
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
-   // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-   //#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for (int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef _OPENMP
-      // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
+   // compute the gradient component i, changing temporarily the i-th element of x
+   // (printer must be a thread-local MnPrint instance when called inside threads)
+   auto computeComponent = [&](unsigned int i, MnAlgebraicVector &x, MnPrint &printer) {
       double xtf = x(i);
       double epspri = eps2 + std::fabs(grd(i) * eps2);
       double stepb4 = 0.;
@@ -173,26 +157,14 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 #pragma omp critical
 #endif
          {
-#ifdef _OPENMP
-            // must create thread-local MnPrint instances when printing inside threads
-            MnPrint printtl("Numerical2PGradientCalculator[OpenMP]");
-#endif
             if (i == 0 && j == 0) {
-#ifdef _OPENMP
-               printtl.Debug([&](std::ostream &os) {
-#else
-               print.Debug([&](std::ostream &os) {
-#endif
+               printer.Debug([&](std::ostream &os) {
                   os << std::setw(10) << "parameter" << std::setw(6) << "cycle" << std::setw(15) << "x" << std::setw(15)
                      << "step" << std::setw(15) << "f1" << std::setw(15) << "f2" << std::setw(15) << "grd"
                      << std::setw(15) << "g2" << std::endl;
                });
             }
-#ifdef _OPENMP
-            printtl.Debug([&](std::ostream &os) {
-#else
-            print.Debug([&](std::ostream &os) {
-#endif
+            printer.Debug([&](std::ostream &os) {
                const int pr = os.precision(13);
                const int iext = Trafo().ExtOfInt(i);
                os << std::setw(10) << Trafo().Name(iext) << std::setw(5) << j << "  " << x(i) << " " << step << " "
@@ -209,17 +181,68 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
             break;
          }
       }
-
-      //     vgrd(i) = grd;
-      //     vgrd2(i) = g2;
-      //     vgstp(i) = gstep;
-   }
+   };
+
+#ifdef R__USE_IMT
+   // spread the components over the implicit multi-threading thread pool. Each component
+   // is written by a single task, and the function must support concurrent evaluations
+   if (Strategy().ParallelGradient() && n > 1 && ROOT::IsImplicitMTEnabled() && Fcn().Fcn().IsThreadSafe()) {
+      std::mutex printMutex;
+      auto task = [&](unsigned int i) {
+         // create in the task since each thread will use its own copy
+         MnAlgebraicVector x = par.Vec();
+         if (print.Level() < static_cast<int>(MnPrint::Verbosity::Debug)) {
+            computeComponent(i, x, print);
+            return;
+         }
+         // must create thread-local MnPrint instances when printing inside threads; the global print
+         // level is thread local, so the level of the calling thread is passed explicitly
+         std::lock_guard<std::mutex> lock(printMutex);
+         MnPrint printtl("Numerical2PGradientCalculator[IMT]", print.Level());
+         computeComponent(i, x, printtl);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(task, ROOT::TSeq<unsigned int>(n));
+   } else
+#endif
+   {
 
 #ifndef _OPENMP
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(g2);
-   mpiproc.SyncVector(gstep);
+
+      MPIProcess mpiproc(n, 0);
+
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+
+      unsigned int startElementIndex = mpiproc.StartElementIndex();
+      unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
+         computeComponent(i, x, print);
+      }
+
+      mpiproc.SyncVector(grd);
+      mpiproc.SyncVector(g2);
+      mpiproc.SyncVector(gstep);
+
+#else
+
+      // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+      //#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+      for (int i = 0; i < int(n); i++) {
+         // create in loop since each thread will use its own copy
+         MnAlgebraicVector x = par.Vec();
+         // must create thread-local MnPrint instances when printing inside threads
+         MnPrint printtl("Numerical2PGradientCalculator[OpenMP]");
+         computeComponent(i, x, printtl);
+      }
+
 #endif
+   }
 
    // print after parallel processing to avoid synchronization issues
    print.Debug([&](std::ostream &os) {
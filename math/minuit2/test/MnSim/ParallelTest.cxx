@@ -16,6 +16,13 @@
 #include "Minuit2/MnPlot.h"
 #include "Minuit2/MinosError.h"
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/MnStrategy.h"
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
 #include <cmath>
 #include <iostream>
 
@@ -23,6 +30,8 @@
 // to speed up the result
 // define the environment variable OMP_NUM_THREADS to the number of desired threads
 // By default it will have thenumber of core of the machine
+// When ROOT is built with implicit multi-threading, the numerical gradient is instead computed
+// in parallel using the ROOT thread pool (MnStrategy::SetParallelGradient)
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
 // One can change the dimension and the number of events by doing:
 // ./test_Minuit2_Parallel    ndim  nevents
@@ -69,6 +78,8 @@ struct LogLikeFCN : public FCNBase {
       return logl;
    }
    double Up() const { return 0.5; }
+   // the function only reads the data, it can be called concurrently
+   bool IsThreadSafe() const { return true; }
    const Data &fData;
 };
 
@@ -113,8 +124,15 @@ int doFit(int ndim, int ndata)
    // create minimizer (default constructor)
    VariableMetricMinimizer fMinimizer;
 
+   MnUserParameters upar(init_par, init_err);
+   MnStrategy strategy(1);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   strategy.SetParallelGradient();
+#endif
+
    // Minimize
-   FunctionMinimum min = fMinimizer.Minimize(fcn, init_par, init_err);
+   FunctionMinimum min = fMinimizer.Minimize(fcn, upar, strategy);
 
    // output
    std::cout << "minimum: " << min << std::endl;
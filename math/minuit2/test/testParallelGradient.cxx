@@ -0,0 +1,114 @@
+// test of the numerical gradient computed in parallel with ROOT implicit multi-threading
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserParameters.h"
+
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+namespace {
+
+// Rosenbrock function in N dimensions, recording the threads it is called from
+class RosenbrockFCN : public FCNBase {
+public:
+   RosenbrockFCN(bool threadSafe) : fThreadSafe(threadSafe) {}
+
+   double operator()(const std::vector<double> &x) const override
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fThreads.insert(std::this_thread::get_id());
+      }
+      double f = 0;
+      for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+         const double a = x[i + 1] - x[i] * x[i];
+         const double b = 1. - x[i];
+         f += 100. * a * a + b * b;
+      }
+      return f;
+   }
+   double Up() const override { return 1.; }
+   bool IsThreadSafe() const override { return fThreadSafe; }
+
+   const std::set<std::thread::id> &Threads() const { return fThreads; }
+
+private:
+   bool fThreadSafe;
+   mutable std::mutex fMutex;
+   mutable std::set<std::thread::id> fThreads;
+};
+
+FunctionMinimum Minimize(const FCNBase &fcn, bool parallel)
+{
+   MnUserParameters upar;
+   for (int i = 0; i < 6; ++i)
+      upar.Add("x" + std::to_string(i), -1. + 0.1 * i, 0.1);
+   MnStrategy strategy(1);
+   strategy.SetParallelGradient(parallel);
+   MnMigrad migrad(fcn, MnUserParameterState(upar), strategy);
+   return migrad();
+}
+
+void ExpectSameMinimum(const FunctionMinimum &serial, const FunctionMinimum &parallel)
+{
+   ASSERT_TRUE(serial.IsValid());
+   ASSERT_TRUE(parallel.IsValid());
+   EXPECT_EQ(serial.Fval(), parallel.Fval());
+   EXPECT_EQ(serial.NFcn(), parallel.NFcn());
+   const auto &gserial = serial.Grad().Vec();
+   const auto &gparallel = parallel.Grad().Vec();
+   ASSERT_EQ(gserial.size(), gparallel.size());
+   for (unsigned int i = 0; i < gserial.size(); ++i)
+      EXPECT_EQ(gserial(i), gparallel(i));
+   for (unsigned int i = 0; i < 6; ++i)
+      EXPECT_EQ(serial.UserState().Value(i), parallel.UserState().Value(i));
+}
+
+} // namespace
+
+TEST(ParallelGradient, SameResultAsSerial)
+{
+   ROOT::EnableImplicitMT(4);
+
+   RosenbrockFCN serialFcn(true);
+   FunctionMinimum serial = Minimize(serialFcn, false);
+   EXPECT_EQ(1u, serialFcn.Threads().size());
+
+   RosenbrockFCN parallelFcn(true);
+   FunctionMinimum parallel = Minimize(parallelFcn, true);
+
+   ExpectSameMinimum(serial, parallel);
+
+   ROOT::DisableImplicitMT();
+}
+
+TEST(ParallelGradient, NotThreadSafeStaysSerial)
+{
+   ROOT::EnableImplicitMT(4);
+
+   RosenbrockFCN serialFcn(false);
+   FunctionMinimum serial = Minimize(serialFcn, false);
+
+   // the parallel gradient is requested, but the function does not support concurrent calls
+   RosenbrockFCN fcn(false);
+   FunctionMinimum parallel = Minimize(fcn, true);
+
+   ExpectSameMinimum(serial, parallel);
+   ASSERT_EQ(1u, fcn.Threads().size());
+   EXPECT_EQ(std::this_thread::get_id(), *fcn.Threads().begin());
+
+   ROOT::DisableImplicitMT();
+}
@@ -116,6 +116,128 @@ inline uint64_t NextPowerOf2(uint64_t A)
    return A + 1;
 }
 
+/// Sine, cosine and exponential used by the kinematics kernels: the Vdt approximations if available,
+/// which can be inlined and vectorized by the compiler, the standard functions otherwise.
+template <typename T>
+T FastSin(T x)
+{
+   return std::sin(x);
+}
+
+template <typename T>
+T FastCos(T x)
+{
+   return std::cos(x);
+}
+
+template <typename T>
+T FastExp(T x)
+{
+   return std::exp(x);
+}
+
+#ifdef R__HAS_VDT
+inline float FastSin(float x)
+{
+   return vdt::fast_sinf(x);
+}
+
+inline double FastSin(double x)
+{
+   return vdt::fast_sin(x);
+}
+
+inline float FastCos(float x)
+{
+   return vdt::fast_cosf(x);
+}
+
+inline double FastCos(double x)
+{
+   return vdt::fast_cos(x);
+}
+
+inline float FastExp(float x)
+{
+   return vdt::fast_expf(x);
+}
+
+inline double FastExp(double x)
+{
+   return vdt::fast_exp(x);
+}
+#endif
+
+template <typename T>
+T FastSinh(T x)
+{
+   const T e = FastExp(x);
+   return T(0.5) * (e - T(1) / e);
+}
+
+/// Bring the angle difference dphi to the range [-c, c] without branches.
+/// The result is the one of ROOT::VecOps::DeltaPhi as long as |dphi| < 2c, which is checked by the callers.
+template <typename T>
+T WrapDeltaPhi(T dphi, T c)
+{
+   dphi -= dphi > c ? T(2) * c : T(0);
+   dphi += dphi < -c ? T(2) * c : T(0);
+   return dphi;
+}
+
+/// Convert n four-vectors from the (pt, eta, phi, mass) to the (px, py, pz, e) coordinate system.
+template <typename T>
+void PtEtaPhiMToPxPyPzE(const T *pt, const T *eta, const T *phi, const T *mass, std::size_t n, T *px, T *py, T *pz,
+                        T *e)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      const T x = pt[i] * FastCos(phi[i]);
+      const T y = pt[i] * FastSin(phi[i]);
+      const T z = pt[i] * FastSinh(eta[i]);
+      px[i] = x;
+      py[i] = y;
+      pz[i] = z;
+      e[i] = std::sqrt(x * x + y * y + z * z + mass[i] * mass[i]);
+   }
+}
+
+/// Compute the invariant masses of the npairs pairs of four-vectors, the pair k being made of the element
+/// pairs[2k] of the first collection and the element pairs[2k+1] of the second one.
+template <typename T>
+void PairInvariantMasses(const T *px1, const T *py1, const T *pz1, const T *e1, const T *px2, const T *py2,
+                         const T *pz2, const T *e2, const std::size_t *pairs, std::size_t npairs, T *out)
+{
+   for (std::size_t k = 0; k < npairs; ++k) {
+      const std::size_t i = pairs[2 * k];
+      const std::size_t j = pairs[2 * k + 1];
+      const T e = e1[i] + e2[j];
+      const T x = px1[i] + px2[j];
+      const T y = py1[i] + py2[j];
+      const T z = pz1[i] + pz2[j];
+      out[k] = std::sqrt(e * e - x * x - y * y - z * z);
+   }
+}
+
+/// Compute the distances on the eta-phi plane of the npairs pairs of elements, with the layout of pairs
+/// of PairInvariantMasses. Return false if some angle difference is too large for WrapDeltaPhi, in which
+/// case the results must be recomputed with ROOT::VecOps::DeltaR.
+template <typename T>
+bool PairDeltaR(const T *eta1, const T *phi1, const T *eta2, const T *phi2, const std::size_t *pairs,
+                std::size_t npairs, T c, T *out)
+{
+   bool outOfRange = false;
+   for (std::size_t k = 0; k < npairs; ++k) {
+      const std::size_t i = pairs[2 * k];
+      const std::size_t j = pairs[2 * k + 1];
+      const T deta = eta1[i] - eta2[j];
+      const T dphi = phi2[j] - phi1[i];
+      outOfRange |= std::abs(dphi) >= T(2) * c;
+      const T wrapped = WrapDeltaPhi(dphi, c);
+      out[k] = std::sqrt(deta * deta + wrapped * wrapped);
+   }
+   return !outOfRange;
+}
+
 /// This is all the stuff common to all SmallVectors.
 class R__CLING_PTRCHECK(off) SmallVectorBase {
 public:
@@ -2508,6 +2630,77 @@ RVec<RVec<typename RVec<T>::size_type>> Combinations(const RVec<T>& v, const typ
    }
 }
 
+/// Return the index pairs of all combinations of the elements of two RVecs.
+///
+/// Contrary to Combinations, the pairs are stored one after the other in a single flat
+/// RVec, { i0, j0, i1, j1, ... }, where i indexes the first RVec and j the second one.
+/// The result can be passed directly to the kinematics functions taking index pairs,
+/// e.g. InvariantMasses and DeltaR.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// auto pairs = CombinationPairs(3, 2);
+/// pairs
+/// // (ROOT::VecOps::RVec<unsigned long> &) { 0, 0, 0, 1, 1, 0, 1, 1, 2, 0, 2, 1 }
+/// ~~~
+inline RVec<std::size_t> CombinationPairs(const std::size_t size1, const std::size_t size2)
+{
+   RVec<std::size_t> r(2 * size1 * size2);
+   std::size_t c = 0;
+   for (std::size_t i = 0; i < size1; i++) {
+      for (std::size_t j = 0; j < size2; j++) {
+         r[c++] = i;
+         r[c++] = j;
+      }
+   }
+   return r;
+}
+
+/// Return the index pairs of all combinations of the elements of two RVecs.
+///
+/// See CombinationPairs(std::size_t, std::size_t) for the layout of the result.
+template <typename T1, typename T2>
+RVec<std::size_t> CombinationPairs(const RVec<T1> &v1, const RVec<T2> &v2)
+{
+   return CombinationPairs(v1.size(), v2.size());
+}
+
+/// Return the index pairs of all unique combinations of two elements of a collection
+/// of the given size.
+///
+/// The pairs (i, j), with i < j, are stored one after the other in a single flat RVec,
+/// { i0, j0, i1, j1, ... }, in the same order as the ones returned by Combinations(v, 2).
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// auto pairs = UniqueCombinationPairs(4);
+/// pairs
+/// // (ROOT::VecOps::RVec<unsigned long> &) { 0, 1, 0, 2, 0, 3, 1, 2, 1, 3, 2, 3 }
+/// ~~~
+inline RVec<std::size_t> UniqueCombinationPairs(const std::size_t size)
+{
+   RVec<std::size_t> r(size > 1 ? size * (size - 1) : 0);
+   std::size_t c = 0;
+   for (std::size_t i = 0; i < size; i++) {
+      for (std::size_t j = i + 1; j < size; j++) {
+         r[c++] = i;
+         r[c++] = j;
+      }
+   }
+   return r;
+}
+
+/// Return the index pairs of all unique combinations of two elements of an RVec.
+///
+/// See UniqueCombinationPairs(std::size_t) for the layout of the result.
+template <typename T>
+RVec<std::size_t> UniqueCombinationPairs(const RVec<T> &v)
+{
+   return UniqueCombinationPairs(v.size());
+}
+
 /// Return the indices of the elements which are not zero
 ///
 /// Example code, at the ROOT prompt:
@@ -2783,8 +2976,26 @@ RVec<T> DeltaPhi(T v1, const RVec<T>& v2, const T c = M_PI)
 template <typename T>
 RVec<T> DeltaR2(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = M_PI)
 {
-   const auto dphi = DeltaPhi(phi1, phi2, c);
-   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+   const auto size = ::ROOT::Internal::VecOps::GetVectorsSize("DeltaR2", eta1, eta2, phi1, phi2);
+   RVec<T> r(size);
+   // single pass without branches, which the compiler can vectorize
+   bool outOfRange = false;
+   for (std::size_t i = 0; i < size; i++) {
+      const T deta = eta1[i] - eta2[i];
+      const T dphi = phi2[i] - phi1[i];
+      outOfRange |= std::abs(dphi) >= T(2) * c;
+      const T wrapped = ::ROOT::Internal::VecOps::WrapDeltaPhi(dphi, c);
+      r[i] = deta * deta + wrapped * wrapped;
+   }
+   // angles far outside of [-c, c] need the full reduction of DeltaPhi
+   if (outOfRange) {
+      for (std::size_t i = 0; i < size; i++) {
+         const T deta = eta1[i] - eta2[i];
+         const T dphi = DeltaPhi(phi1[i], phi2[i], c);
+         r[i] = deta * deta + dphi * dphi;
+      }
+   }
+   return r;
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -2797,7 +3008,10 @@ RVec<T> DeltaR2(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, c
 template <typename T>
 RVec<T> DeltaR(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = M_PI)
 {
-   return sqrt(DeltaR2(eta1, eta2, phi1, phi2, c));
+   auto r = DeltaR2(eta1, eta2, phi1, phi2, c);
+   for (auto &x : r)
+      x = std::sqrt(x);
+   return r;
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -2889,6 +3103,129 @@ T InvariantMass(const RVec<T>& pt, const RVec<T>& eta, const RVec<T>& phi, const
    return std::sqrt(e_sum * e_sum - x_sum * x_sum - y_sum * y_sum - z_sum * z_sum);
 }
 
+/// Return the invariant masses of pairs of particles taken from two collections given the
+/// quantities transverse momentum (pt), rapidity (eta), azimuth (phi) and mass.
+///
+/// The pairs are given as a flat RVec of indices { i0, j0, i1, j1, ... }, as returned by
+/// CombinationPairs, where i indexes the first collection and j the second one.
+/// Each particle is converted only once to the (px, py, pz, e) coordinate system, stored
+/// as a structure of arrays, and the loop over the pairs then vectorizes. If ROOT is built
+/// with Vdt, the fast Vdt trigonometric and exponential functions are used for the conversion.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVecF ele_pt {30.f, 20.f}, ele_eta {0.1f, -1.2f}, ele_phi {0.5f, 2.5f}, ele_m {0.000511f, 0.000511f};
+/// RVecF mu_pt {40.f}, mu_eta {0.6f}, mu_phi {-2.f}, mu_m {0.1057f};
+/// auto masses = InvariantMasses(ele_pt, ele_eta, ele_phi, ele_m, mu_pt, mu_eta, mu_phi, mu_m,
+///                               CombinationPairs(ele_pt, mu_pt));
+/// ~~~
+template <typename T>
+RVec<T> InvariantMasses(const RVec<T> &pt1, const RVec<T> &eta1, const RVec<T> &phi1, const RVec<T> &mass1,
+                        const RVec<T> &pt2, const RVec<T> &eta2, const RVec<T> &phi2, const RVec<T> &mass2,
+                        const RVec<std::size_t> &pairs)
+{
+   const std::size_t size1 = ::ROOT::Internal::VecOps::GetVectorsSize("InvariantMasses", pt1, eta1, phi1, mass1);
+   const std::size_t size2 = ::ROOT::Internal::VecOps::GetVectorsSize("InvariantMasses", pt2, eta2, phi2, mass2);
+   R__ASSERT(pairs.size() % 2 == 0);
+
+   RVec<T> p(4 * (size1 + size2));
+   T *px1 = p.data();
+   T *py1 = px1 + size1;
+   T *pz1 = py1 + size1;
+   T *e1 = pz1 + size1;
+   T *px2 = e1 + size1;
+   T *py2 = px2 + size2;
+   T *pz2 = py2 + size2;
+   T *e2 = pz2 + size2;
+   ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(pt1.data(), eta1.data(), phi1.data(), mass1.data(), size1, px1, py1,
+                                                 pz1, e1);
+   ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(pt2.data(), eta2.data(), phi2.data(), mass2.data(), size2, px2, py2,
+                                                 pz2, e2);
+
+   RVec<T> r(pairs.size() / 2);
+   ::ROOT::Internal::VecOps::PairInvariantMasses(px1, py1, pz1, e1, px2, py2, pz2, e2, pairs.data(), r.size(),
+                                                 r.data());
+   return r;
+}
+
+/// Return the invariant masses of pairs of particles of a single collection given the
+/// quantities transverse momentum (pt), rapidity (eta), azimuth (phi) and mass.
+///
+/// The pairs are given as a flat RVec of indices { i0, j0, i1, j1, ... }, typically the
+/// result of UniqueCombinationPairs. See the overload for two collections for the details.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVecF pt {40.f, 30.f, 20.f}, eta {0.5f, -1.f, 2.f}, phi {0.1f, 3.f, -1.5f}, m {0.1057f, 0.1057f, 0.1057f};
+/// auto masses = InvariantMasses(pt, eta, phi, m, UniqueCombinationPairs(pt));
+/// ~~~
+template <typename T>
+RVec<T> InvariantMasses(const RVec<T> &pt, const RVec<T> &eta, const RVec<T> &phi, const RVec<T> &mass,
+                        const RVec<std::size_t> &pairs)
+{
+   const std::size_t size = ::ROOT::Internal::VecOps::GetVectorsSize("InvariantMasses", pt, eta, phi, mass);
+   R__ASSERT(pairs.size() % 2 == 0);
+
+   RVec<T> p(4 * size);
+   T *px = p.data();
+   T *py = px + size;
+   T *pz = py + size;
+   T *e = pz + size;
+   ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(pt.data(), eta.data(), phi.data(), mass.data(), size, px, py, pz, e);
+
+   RVec<T> r(pairs.size() / 2);
+   ::ROOT::Internal::VecOps::PairInvariantMasses(px, py, pz, e, px, py, pz, e, pairs.data(), r.size(), r.data());
+   return r;
+}
+
+/// Return the distances on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) of pairs of
+/// elements taken from the collections (eta1, phi1) and (eta2, phi2).
+///
+/// The pairs are given as a flat RVec of indices { i0, j0, i1, j1, ... }, as returned by
+/// CombinationPairs, where i indexes the first collection and j the second one. The angle
+/// \f$\phi\f$ can be set to radian or degrees using the optional argument c, see the
+/// documentation of the DeltaPhi helper.
+template <typename T>
+RVec<T> DeltaR(const RVec<T> &eta1, const RVec<T> &eta2, const RVec<T> &phi1, const RVec<T> &phi2,
+               const RVec<std::size_t> &pairs, const T c = M_PI)
+{
+   ::ROOT::Internal::VecOps::GetVectorsSize("DeltaR", eta1, phi1);
+   ::ROOT::Internal::VecOps::GetVectorsSize("DeltaR", eta2, phi2);
+   R__ASSERT(pairs.size() % 2 == 0);
+
+   const std::size_t npairs = pairs.size() / 2;
+   RVec<T> r(npairs);
+   if (!::ROOT::Internal::VecOps::PairDeltaR(eta1.data(), phi1.data(), eta2.data(), phi2.data(), pairs.data(),
+                                             npairs, c, r.data())) {
+      for (std::size_t k = 0; k < npairs; ++k) {
+         const std::size_t i = pairs[2 * k];
+         const std::size_t j = pairs[2 * k + 1];
+         r[k] = DeltaR(eta1[i], eta2[j], phi1[i], phi2[j], c);
+      }
+   }
+   return r;
+}
+
+/// Return the distances on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) of pairs of
+/// elements of a single collection (eta, phi).
+///
+/// The pairs are given as a flat RVec of indices { i0, j0, i1, j1, ... }, typically the
+/// result of UniqueCombinationPairs.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVecF eta {0.5f, -1.f, 2.f}, phi {0.1f, 3.f, -1.5f};
+/// auto dr = DeltaR(eta, phi, UniqueCombinationPairs(eta));
+/// ~~~
+template <typename T>
+RVec<T> DeltaR(const RVec<T> &eta, const RVec<T> &phi, const RVec<std::size_t> &pairs, const T c = M_PI)
+{
+   return DeltaR(eta, eta, phi, phi, pairs, c);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 /// \brief Build an RVec of objects starting from RVecs of input to their constructors.
 /// \tparam T Type of the objects contained in the created RVec.
@@ -962,6 +962,36 @@ TEST(VecOps, UniqueCombinationsSingleVector)
    EXPECT_EQ(idx5.size(), 0u);
 }
 
+TEST(VecOps, CombinationPairs)
+{
+   RVec<int> v1{1, 2, 3};
+   RVec<int> v2{-4, -5};
+
+   // Same combinations as the nested version, stored as flat pairs
+   auto idx = Combinations(v1, v2);
+   auto pairs = CombinationPairs(v1, v2);
+   ASSERT_EQ(pairs.size(), 2 * idx[0].size());
+   for (std::size_t k = 0; k < idx[0].size(); ++k) {
+      EXPECT_EQ(pairs[2 * k], idx[0][k]);
+      EXPECT_EQ(pairs[2 * k + 1], idx[1][k]);
+   }
+
+   RVec<int> v3{1, 2, 3, 4};
+   auto uidx = Combinations(v3, 2);
+   auto upairs = UniqueCombinationPairs(v3);
+   ASSERT_EQ(upairs.size(), 2 * uidx[0].size());
+   for (std::size_t k = 0; k < uidx[0].size(); ++k) {
+      EXPECT_EQ(upairs[2 * k], uidx[0][k]);
+      EXPECT_EQ(upairs[2 * k + 1], uidx[1][k]);
+   }
+
+   // Corner-cases: empty collection and collection with a single element
+   RVec<int> empty_int{};
+   EXPECT_EQ(CombinationPairs(v1, empty_int).size(), 0u);
+   EXPECT_EQ(UniqueCombinationPairs(empty_int).size(), 0u);
+   EXPECT_EQ(UniqueCombinationPairs(1).size(), 0u);
+}
+
 TEST(VecOps, PrintCollOfNonPrintable)
 {
    auto code = "class A{};ROOT::RVec<A> v(1);v";
@@ -1208,6 +1238,54 @@ TEST(VecOps, DeltaR)
    }
 }
 
+TEST(VecOps, PairKinematics)
+{
+   RVec<double> pt = {10, 25, 5, 40};
+   RVec<double> eta = {0.1, -1.0, 2.2, 0.0};
+   RVec<double> phi = {1.0, 5.0, -3.0, -0.5};
+   RVec<double> mass = {0.1, 0.5, 5, 91};
+
+   RVec<float> ptf = {12, 30};
+   RVec<float> etaf = {-0.5, 1.5};
+   RVec<float> phif = {2.5, -2.5};
+   RVec<float> massf = {1, 0.2};
+   RVec<float> pt2f = {20, 8};
+   RVec<float> eta2f = {0.7, -2.0};
+   RVec<float> phi2f = {-0.5, 1.0};
+   RVec<float> mass2f = {0.5, 3};
+
+   // Unique pairs of a single collection, compared to the element-wise functions on the selected elements
+   const auto pairs = UniqueCombinationPairs(pt);
+   const auto idx = Combinations(pt, 2);
+   const auto masses = InvariantMasses(pt, eta, phi, mass, pairs);
+   const auto refMasses = InvariantMasses(Take(pt, idx[0]), Take(eta, idx[0]), Take(phi, idx[0]), Take(mass, idx[0]),
+                                          Take(pt, idx[1]), Take(eta, idx[1]), Take(phi, idx[1]), Take(mass, idx[1]));
+   ASSERT_EQ(masses.size(), refMasses.size());
+   for (std::size_t k = 0; k < masses.size(); ++k)
+      EXPECT_NEAR(masses[k], refMasses[k], 1e-4 * refMasses[k]);
+
+   // phi values outside of [-pi, pi] use the full reduction
+   const auto dr = DeltaR(eta, phi, pairs);
+   const auto refDr = DeltaR(Take(eta, idx[0]), Take(eta, idx[1]), Take(phi, idx[0]), Take(phi, idx[1]));
+   CheckEqual(dr, refDr);
+
+   // Pairs across two collections, in single precision
+   const auto pairs2 = CombinationPairs(ptf, pt2f);
+   const auto masses2 = InvariantMasses(ptf, etaf, phif, massf, pt2f, eta2f, phi2f, mass2f, pairs2);
+   const auto dr2 = DeltaR(etaf, eta2f, phif, phi2f, pairs2);
+   ASSERT_EQ(masses2.size(), 4u);
+   ASSERT_EQ(dr2.size(), 4u);
+   for (std::size_t k = 0; k < masses2.size(); ++k) {
+      const auto i = pairs2[2 * k];
+      const auto j = pairs2[2 * k + 1];
+      TLorentzVector p1, p2;
+      p1.SetPtEtaPhiM(ptf[i], etaf[i], phif[i], massf[i]);
+      p2.SetPtEtaPhiM(pt2f[j], eta2f[j], phi2f[j], mass2f[j]);
+      EXPECT_NEAR((p1 + p2).M(), masses2[k], 1e-4 * (p1 + p2).M());
+      EXPECT_FLOAT_EQ(DeltaR(etaf[i], eta2f[j], phif[i], phi2f[j]), dr2[k]);
+   }
+}
+
 TEST(VecOps, Map)
 {
    RVec<float> a({1.f, 2.f, 3.f});
@@ -57,6 +57,9 @@
 #include <iomanip>
 #include <numeric> // std::accumulate in MeanHelper
 
+class TH2D;
+class TH3D;
+
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
@@ -352,10 +355,84 @@ extern template void FillHelper::Exec(unsigned int, const std::vector<int> &, co
 extern template void
 FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+/// Number of axes of the histogram types that FillParHelper fills in batches through FillN, 0 for the other types
+template <typename HIST>
+struct FillNDim : std::integral_constant<std::size_t, 0> {
+};
+template <>
+struct FillNDim<::TH1D> : std::integral_constant<std::size_t, 1> {
+};
+template <>
+struct FillNDim<::TH2D> : std::integral_constant<std::size_t, 2> {
+};
+template <>
+struct FillNDim<::TH3D> : std::integral_constant<std::size_t, 3> {
+};
+
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
    std::vector<HIST *> fObjects;
 
+   // For the histogram types with a batched FillN, the entries are buffered per slot, each entry taking
+   // FillNDim + 1 values (the coordinates and the weight), and filled once the buffer is full.
+   static constexpr std::size_t kFillNDim = FillNDim<HIST>::value;
+   static constexpr std::size_t kBufferEntries = 1024;
+   std::vector<std::vector<double>> fBuffers;
+
+   template <typename... Ts>
+   using CanBuffer_t = std::integral_constant<
+      bool, kFillNDim != 0 && (sizeof...(Ts) == kFillNDim || sizeof...(Ts) == kFillNDim + 1) &&
+               !Disjunction<std::integral_constant<bool, !std::is_arithmetic<Ts>::value>...>::value>;
+
+   template <typename... Ts>
+   void FillOrBuffer(std::true_type, unsigned int slot, const Ts &...x)
+   {
+      auto &buffer = fBuffers[slot];
+      // the weight is 1 unless given as last value
+      const double values[] = {static_cast<double>(x)..., 1.};
+      buffer.insert(buffer.end(), values, values + kFillNDim + 1);
+      if (buffer.size() >= kBufferEntries * (kFillNDim + 1))
+         FlushBuffer(slot);
+   }
+
+   template <typename... Ts>
+   void FillOrBuffer(std::false_type, unsigned int slot, const Ts &...x)
+   {
+      fObjects[slot]->Fill(x...);
+   }
+
+   template <typename H>
+   static void FillN(H *, std::integral_constant<std::size_t, 0>, std::vector<double> &)
+   {
+   }
+
+   template <typename H>
+   static void FillN(H *h, std::integral_constant<std::size_t, 1>, std::vector<double> &b)
+   {
+      h->FillN(b.size() / 2, b.data(), b.data() + 1, 2);
+   }
+
+   template <typename H>
+   static void FillN(H *h, std::integral_constant<std::size_t, 2>, std::vector<double> &b)
+   {
+      h->FillN(b.size() / 3, b.data(), b.data() + 1, b.data() + 2, 3);
+   }
+
+   template <typename H>
+   static void FillN(H *h, std::integral_constant<std::size_t, 3>, std::vector<double> &b)
+   {
+      h->FillN(b.size() / 4, b.data(), b.data() + 1, b.data() + 2, b.data() + 3, 4);
+   }
+
+   void FlushBuffer(unsigned int slot)
+   {
+      auto &buffer = fBuffers[slot];
+      if (buffer.empty())
+         return;
+      FillN(fObjects[slot], std::integral_constant<std::size_t, kFillNDim>{}, buffer);
+      buffer.clear();
+   }
+
    void UnsetDirectoryIfPossible(TH1 *h) {
       h->SetDirectory(nullptr);
    }
@@ -444,7 +521,7 @@ class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
       // TODO this could be simplified with fold expressions or std::apply in C++17
       auto nop = [](auto &&...) {};
       for (; GetNthElement<ColIdx>(its...) != end; nop(++its...)) {
-         thisSlotH->Fill(*its...);
+         FillOrBuffer(CanBuffer_t<std::decay_t<decltype(*its)>...>{}, slot, *its...);
       }
    }
 
@@ -452,7 +529,8 @@ public:
    FillParHelper(FillParHelper &&) = default;
    FillParHelper(const FillParHelper &) = delete;
 
-   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fObjects(nSlots, nullptr), fBuffers(kFillNDim ? nSlots : 0)
    {
       fObjects[0] = h.get();
       // Initialise all other slots
@@ -469,7 +547,7 @@ public:
              typename std::enable_if<!Disjunction<IsDataContainer<ValTypes>...>::value, int>::type = 0>
    void Exec(unsigned int slot, const ValTypes &...x)
    {
-      fObjects[slot]->Fill(x...);
+      FillOrBuffer(CanBuffer_t<ValTypes...>{}, slot, x...);
    }
 
    // at least one container argument
@@ -503,6 +581,9 @@ public:
 
    void Finalize()
    {
+      for (unsigned int slot = 0; slot < fBuffers.size(); ++slot)
+         FlushBuffer(slot);
+
       if (fObjects.size() == 1)
          return;
 
@@ -513,7 +594,12 @@ public:
          delete *it;
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      if (kFillNDim)
+         FlushBuffer(slot);
+      return *fObjects[slot];
+   }
 
    // Helper functions for RMergeableValue
    std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
@@ -0,0 +1,332 @@
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RLOGLIKELIHOODFCN
+#define ROOT_RDF_RLOGLIKELIHOODFCN
+
+#include "ROOT/RDF/RInterface.hxx"
+#include "Math/FitMethodFunction.h"
+#include "Math/IParamFunction.h"
+#include "Math/Util.h"
+#include "TError.h"
+#include "TROOT.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RLogLikelihoodFCN
+\ingroup dataframe
+\brief Negative log-likelihood of an unbinned fit to the entries of an RDataFrame.
+
+The likelihood is reduced directly over the entries of the data frame, without copying them into a
+ROOT::Fit::UnBinData. ColumnTypes are the (arithmetic) types of the columns holding the coordinates passed to the
+model function, which must be normalized. The optional weight column must be of type double.
+
+Two modes are available:
+- EMode::kCache (default): the columns are read once, when the FCN is constructed, into per-slot buffers which are
+  shared by all copies of the FCN and all its evaluations. At each evaluation the buffers are processed in chunks with
+  ROOT::Math::IParamMultiFunction::EvalParVec, in parallel if implicit multi-threading is enabled.
+- EMode::kEventLoop: nothing is kept in memory and each evaluation runs the event loop of the data frame, in parallel
+  if implicit multi-threading is enabled. Use it for samples which do not fit in memory.
+
+The FCN can be minimized with ROOT::Fit::Fitter::FitFCN. Remember to set the error definition of a likelihood fit:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+TF1 f("f", "gausn", -10, 10);
+ROOT::Math::WrappedMultiTF1 model(f, 1);
+ROOT::RDF::Experimental::RLogLikelihoodFCN<double> fcn(df, model, {"x"});
+ROOT::Fit::Fitter fitter;
+double p0[] = {1, 0, 1};
+fitter.Config().SetParamsSettings(3, p0);
+fitter.Config().ParSettings(0).Fix();
+fitter.Config().MinimizerOptions().SetErrorDef(0.5);
+fitter.FitFCN(fcn);
+~~~
+*/
+template <typename... ColumnTypes>
+class RLogLikelihoodFCN final : public ROOT::Math::FitMethodFunction {
+   static_assert(sizeof...(ColumnTypes) > 0, "RLogLikelihoodFCN needs at least one coordinate column");
+
+public:
+   /// Where the entries are read from at each evaluation
+   enum class EMode {
+      kCache,    ///< From buffers filled once when the FCN is constructed
+      kEventLoop ///< From the data frame, running its event loop
+   };
+
+private:
+   using ModelFunc_t = ROOT::Math::IParamMultiFunction;
+
+   static constexpr unsigned int kNDim = sizeof...(ColumnTypes);
+   /// Number of points passed at once to the model function
+   static constexpr std::size_t kChunkSize = 4096;
+
+   /// Coordinates (one point after the other) and weights of the entries processed by one slot
+   struct RSlotData {
+      std::vector<double> fCoords;
+      std::vector<double> fWeights;
+   };
+
+   /// Entries read in kCache mode
+   struct RCache {
+      std::vector<RSlotData> fSlots;
+      std::vector<std::pair<unsigned int, std::size_t>> fChunks; ///< Slot and first point of each chunk
+   };
+
+   mutable RNode fDataFrame;
+   std::unique_ptr<ModelFunc_t> fModel;
+   ColumnNames_t fColumns; ///< Coordinate columns, followed by the weight column if any
+   bool fWeighted;
+   EMode fMode;
+   unsigned int fNPoints = 0;
+   std::shared_ptr<const RCache> fCache; ///< Shared by the copies of the FCN
+
+   /// Call f(slot, coords, weight) for each entry of the data frame
+   template <typename F>
+   void ForEachEntry(F &&f) const
+   {
+      if (fWeighted) {
+         fDataFrame.ForeachSlot(
+            [&f](unsigned int slot, ColumnTypes... x, double w) {
+               const double coords[] = {static_cast<double>(x)...};
+               f(slot, coords, w);
+            },
+            fColumns);
+      } else {
+         fDataFrame.ForeachSlot(
+            [&f](unsigned int slot, ColumnTypes... x) {
+               const double coords[] = {static_cast<double>(x)...};
+               f(slot, coords, 1.);
+            },
+            fColumns);
+      }
+   }
+
+   /// Sum of the weighted logarithms of the model at the n points coords; fval must hold n values
+   double SumLog(const double *coords, const double *weights, std::size_t n, const double *p, double *fval) const
+   {
+      fModel->EvalParVec(coords, n, p, fval);
+      double sum = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+         // EvalLog protects against negative or too small values of the function
+         const double logval = ROOT::Math::Util::EvalLog(fval[i]);
+         sum += weights ? weights[i] * logval : logval;
+      }
+      return sum;
+   }
+
+   void FillCache()
+   {
+      auto cache = std::make_shared<RCache>();
+      cache->fSlots.resize(fDataFrame.GetNSlots());
+      auto &slots = cache->fSlots;
+      const bool weighted = fWeighted;
+      ForEachEntry([&slots, weighted](unsigned int slot, const double *coords, double w) {
+         auto &data = slots[slot];
+         data.fCoords.insert(data.fCoords.end(), coords, coords + kNDim);
+         if (weighted)
+            data.fWeights.push_back(w);
+      });
+
+      std::size_t npoints = 0;
+      for (unsigned int slot = 0; slot < slots.size(); ++slot) {
+         slots[slot].fCoords.shrink_to_fit();
+         slots[slot].fWeights.shrink_to_fit();
+         const std::size_t n = slots[slot].fCoords.size() / kNDim;
+         for (std::size_t first = 0; first < n; first += kChunkSize)
+            cache->fChunks.emplace_back(slot, first);
+         npoints += n;
+      }
+      fNPoints = npoints;
+      fCache = std::move(cache);
+   }
+
+   double EvalCache(const double *p) const
+   {
+      const RCache &cache = *fCache;
+      auto evalChunk = [&](unsigned int ichunk) {
+         const auto &chunk = cache.fChunks[ichunk];
+         const RSlotData &data = cache.fSlots[chunk.first];
+         const std::size_t n = std::min(kChunkSize, data.fCoords.size() / kNDim - chunk.second);
+         const double *weights = fWeighted ? data.fWeights.data() + chunk.second : nullptr;
+         std::vector<double> fval(n);
+         return SumLog(data.fCoords.data() + chunk.second * kNDim, weights, n, p, fval.data());
+      };
+
+      const unsigned int nchunks = cache.fChunks.size();
+      std::vector<double> sums;
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && nchunks > 1) {
+         ROOT::TThreadExecutor pool;
+         sums = pool.Map(evalChunk, ROOT::TSeq<unsigned int>(nchunks));
+      }
+#endif
+      if (sums.empty()) {
+         sums.reserve(nchunks);
+         for (unsigned int ichunk = 0; ichunk < nchunks; ++ichunk)
+            sums.push_back(evalChunk(ichunk));
+      }
+
+      // sum the chunks in a fixed order, such that the result does not depend on the scheduling
+      double logl = 0;
+      for (double sum : sums)
+         logl += sum;
+      return -logl;
+   }
+
+   double EvalEventLoop(const double *p) const
+   {
+      struct RSlotState {
+         RSlotData fData;
+         std::vector<double> fValues;
+         double fSum = 0;
+      };
+      std::vector<RSlotState> states(fDataFrame.GetNSlots());
+
+      auto flush = [&](RSlotState &state) {
+         auto &data = state.fData;
+         const std::size_t n = data.fCoords.size() / kNDim;
+         if (n == 0)
+            return;
+         state.fValues.resize(n);
+         state.fSum += SumLog(data.fCoords.data(), fWeighted ? data.fWeights.data() : nullptr, n, p,
+                              state.fValues.data());
+         data.fCoords.clear();
+         data.fWeights.clear();
+      };
+
+      const bool weighted = fWeighted;
+      ForEachEntry([&](unsigned int slot, const double *coords, double w) {
+         auto &state = states[slot];
+         auto &data = state.fData;
+         data.fCoords.insert(data.fCoords.end(), coords, coords + kNDim);
+         if (weighted)
+            data.fWeights.push_back(w);
+         if (data.fCoords.size() >= kChunkSize * kNDim)
+            flush(state);
+      });
+
+      double logl = 0;
+      for (auto &state : states) {
+         flush(state);
+         logl += state.fSum;
+      }
+      return -logl;
+   }
+
+   double DoEval(const double *p) const final
+   {
+      this->UpdateNCalls();
+      return (fMode == EMode::kCache) ? EvalCache(p) : EvalEventLoop(p);
+   }
+
+public:
+   /// Construct the negative log-likelihood of the (normalized) model for the entries of df.
+   /// \param[in] df The data frame, or any node of its computation graph
+   /// \param[in] model The model function; it is copied
+   /// \param[in] columns The columns passed as coordinates to the model, one per dimension of the model
+   /// \param[in] weightColumn The column of type double with the weights of the entries, if any
+   /// \param[in] mode Whether the entries are cached in memory or read by an event loop at each evaluation
+   ///
+   /// The constructor runs one event loop: it caches the entries in kCache mode and counts them in kEventLoop mode.
+   RLogLikelihoodFCN(RNode df, const ModelFunc_t &model, const ColumnNames_t &columns,
+                     std::string_view weightColumn = "", EMode mode = EMode::kCache)
+      : ROOT::Math::FitMethodFunction(model.NPar(), 0), fDataFrame(std::move(df)),
+        fModel(dynamic_cast<ModelFunc_t *>(model.Clone())), fColumns(columns), fWeighted(!weightColumn.empty()),
+        fMode(mode)
+   {
+      if (fColumns.size() != kNDim)
+         throw std::runtime_error("RLogLikelihoodFCN: " + std::to_string(kNDim) + " coordinate columns are needed, " +
+                                  std::to_string(fColumns.size()) + " were given.");
+      if (model.NDim() != kNDim)
+         throw std::runtime_error("RLogLikelihoodFCN: the model has " + std::to_string(model.NDim()) +
+                                  " dimensions but there are " + std::to_string(kNDim) + " coordinate columns.");
+      if (fWeighted)
+         fColumns.emplace_back(weightColumn);
+
+      if (fMode == EMode::kCache)
+         FillCache();
+      else
+         fNPoints = *fDataFrame.Count();
+   }
+
+   RLogLikelihoodFCN(const RLogLikelihoodFCN &other)
+      : ROOT::Math::FitMethodFunction(other), fDataFrame(other.fDataFrame),
+        fModel(dynamic_cast<ModelFunc_t *>(other.fModel->Clone())), fColumns(other.fColumns),
+        fWeighted(other.fWeighted), fMode(other.fMode), fNPoints(other.fNPoints), fCache(other.fCache)
+   {
+   }
+
+   RLogLikelihoodFCN &operator=(const RLogLikelihoodFCN &) = delete;
+
+   BaseFunction *Clone() const final { return new RLogLikelihoodFCN(*this); }
+
+   unsigned int NPoints() const final { return fNPoints; }
+
+   Type_t Type() const final { return kLogLikelihood; }
+
+   /// Logarithm of the model for the parameters p at the i-th entry, multiplied by the weight of the entry if any,
+   /// and its gradient with respect to the parameters in g if it is not nullptr and the model provides it. This is
+   /// the contribution of the entry to the log-likelihood, as used e.g. by Fumili. Only available in kCache mode.
+   double DataElement(const double *p, unsigned int i, double *g = nullptr) const final
+   {
+      if (fMode != EMode::kCache) {
+         Error("RLogLikelihoodFCN::DataElement", "The entries are only accessible in kCache mode");
+         return 0;
+      }
+      std::size_t ipoint = i;
+      for (const auto &data : fCache->fSlots) {
+         const std::size_t n = data.fCoords.size() / kNDim;
+         if (ipoint < n) {
+            const double *x = data.fCoords.data() + ipoint * kNDim;
+            const double w = fWeighted ? data.fWeights[ipoint] : 1.;
+            const double fval = (*fModel)(x, p);
+            if (g) {
+               const unsigned int npar = fModel->NPar();
+               auto gradModel = dynamic_cast<const ROOT::Math::IParamMultiGradFunction *>(fModel.get());
+               if (gradModel) {
+                  gradModel->ParameterGradient(x, p, g);
+                  // gradient of the logarithm
+                  for (unsigned int ipar = 0; ipar < npar; ++ipar)
+                     g[ipar] *= w / fval;
+               } else {
+                  Error("RLogLikelihoodFCN::DataElement", "The model does not provide a parameter gradient");
+                  std::fill(g, g + npar, 0.);
+               }
+            }
+            // EvalLog protects against negative or too small values of the function
+            return w * ROOT::Math::Util::EvalLog(fval);
+         }
+         ipoint -= n;
+      }
+      Error("RLogLikelihoodFCN::DataElement", "Entry %u is out of range", i);
+      return 0;
+   }
+
+   EMode GetMode() const { return fMode; }
+   const ModelFunc_t &ModelFunction() const { return *fModel; }
+};
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace ROOT {
@@ -53,6 +54,15 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    std::vector<std::string> fColumnNames;
    std::vector<std::string> fColumnTypes;
    std::vector<size_t> fActiveColumns;
+   /// The on-disk columns backing the RDF columns booked since the last event loop.  They are announced to the
+   /// page sources in Initialise(), so that the first clusters are loaded with all of the booked columns.
+   std::unordered_set<DescriptorId_t> fBookedColumns;
+
+   /// The entry ranges handed out by the last call to GetEntryRanges()
+   std::vector<std::pair<ULong64_t, ULong64_t>> fRanges;
+   /// For every slot, the end of the entry range that it is currently processing.  The column readers of the slot
+   /// use it to not read ahead into the entries of other slots.
+   std::vector<ULong64_t> fSlotEntryEnds;
 
    unsigned fNSlots = 0;
    bool fHasSeenAllRanges = false;
@@ -81,6 +91,7 @@ public:
    std::string GetLabel() final { return "RNTupleDS"; }
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) final;
 
    void Initialise() final;
    void Finalise() final;
@@ -25,6 +25,8 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -104,9 +106,56 @@ class RNTupleColumnReader : public ROOT::Detail::RDF::RColumnReaderBase {
    using RFieldValue = ROOT::Experimental::Detail::RFieldValue;
    using RPageSource = ROOT::Experimental::Detail::RPageSource;
 
+   /// Number of entries read at once for simple fields
+   static constexpr Long64_t kBulkSize = 1024;
+
    std::unique_ptr<RFieldBase> fField; ///< The field backing the RDF column
    RFieldValue fValue;                 ///< The memory location used to read from fField
    Long64_t fLastEntry;                ///< Last entry number that was read
+   /// For simple fields, the values of the entries [fBulkFirst, fBulkFirst + fBulkSize) read in one go
+   std::unique_ptr<unsigned char[]> fBulkValues;
+   Long64_t fBulkFirst = -1;
+   Long64_t fBulkSize = 0;
+   /// The page source the field is connected to, used to find the cluster boundaries
+   RPageSource *fSource = nullptr;
+   /// The end of the entry range processed by the slot of this reader, owned by the data source
+   const ULong64_t *fSlotEntryEnd = nullptr;
+   /// The entries [fClusterFirst, fClusterEnd) of the cluster of the last bulk read
+   Long64_t fClusterFirst = -1;
+   Long64_t fClusterEnd = -1;
+
+   /// Returns the end of the cluster that contains the entry; simple fields have one column element per entry
+   Long64_t GetClusterEnd(Long64_t entry)
+   {
+      if (entry >= fClusterFirst && entry < fClusterEnd)
+         return fClusterEnd;
+      const auto &desc = fSource->GetDescriptor();
+      const auto columnId = desc.FindColumnId(fField->GetOnDiskId(), 0);
+      const auto clusterId = desc.FindClusterId(columnId, entry);
+      if (clusterId == kInvalidDescriptorId)
+         return fField->GetNElements();
+      const auto &columnRange = desc.GetClusterDescriptor(clusterId).GetColumnRange(columnId);
+      fClusterFirst = columnRange.fFirstElementIndex;
+      fClusterEnd = columnRange.fFirstElementIndex + columnRange.fNElements;
+      return fClusterEnd;
+   }
+
+   void *GetBulkValue(Long64_t entry)
+   {
+      if (entry < fBulkFirst || entry >= fBulkFirst + fBulkSize) {
+         if (!fBulkValues)
+            fBulkValues = std::make_unique<unsigned char[]>(kBulkSize * fField->GetValueSize());
+         // Do not read beyond the entry range of the slot, whose entries may belong to the ranges of other
+         // slots, nor beyond the current cluster, which would trigger loading the next one
+         Long64_t end = GetClusterEnd(entry);
+         if (fSlotEntryEnd && *fSlotEntryEnd > static_cast<ULong64_t>(entry))
+            end = std::min(end, static_cast<Long64_t>(*fSlotEntryEnd));
+         fBulkFirst = entry;
+         fBulkSize = std::min(kBulkSize, end - entry);
+         fField->ReadBulk(fBulkFirst, fBulkSize, fBulkValues.get());
+      }
+      return fBulkValues.get() + (entry - fBulkFirst) * fField->GetValueSize();
+   }
 
 public:
    RNTupleColumnReader(std::unique_ptr<RFieldBase> f)
@@ -121,16 +170,42 @@ public:
       return std::make_unique<RNTupleColumnReader>(fField->Clone(fField->GetName()));
    }
 
-   /// Connect the field and its subfields to the page source
-   void Connect(RPageSource &source)
+   /// Connect the field and its subfields to the page source. The reader of a slot does not read ahead beyond
+   /// slotEntryEnd, if given.
+   void Connect(RPageSource &source, const ULong64_t *slotEntryEnd = nullptr)
    {
+      fSource = &source;
+      fSlotEntryEnd = slotEntryEnd;
       fField->ConnectPageSource(source);
       for (auto &f : *fField)
          f.ConnectPageSource(source);
    }
 
+   /// Adds the on-disk columns of the field and its subfields to `columns`. The on-disk IDs are set on the
+   /// prototype, so this does not require the reader to be connected.
+   void CollectColumnIds(const RNTupleDescriptor &desc, std::unordered_set<DescriptorId_t> &columns) const
+   {
+      auto fnAddColumns = [&desc, &columns](const RFieldBase &field) {
+         if (field.GetOnDiskId() == kInvalidDescriptorId)
+            return;
+         for (std::uint32_t i = 0;; ++i) {
+            auto columnId = desc.FindColumnId(field.GetOnDiskId(), i);
+            if (columnId == kInvalidDescriptorId)
+               break;
+            columns.insert(columnId);
+         }
+      };
+      fnAddColumns(*fField);
+      for (auto &f : *fField)
+         fnAddColumns(f);
+   }
+
    void *GetImpl(Long64_t entry) final
    {
+      // Values of simple fields are bitwise copies of the column elements and can be read in bulk
+      if (fField->IsSimple())
+         return GetBulkValue(entry);
+
       if (entry != fLastEntry) {
          fField->Read(entry, &fValue);
          fLastEntry = entry;
@@ -264,8 +339,14 @@ RNTupleDS::RNTupleDS(std::unique_ptr<Detail::RPageSource> pageSource)
    AddField(descriptor, "", descriptor.GetFieldZeroId(), std::vector<DescriptorId_t>());
 }
 
-RDF::RDataSource::Record_t RNTupleDS::GetColumnReadersImpl(std::string_view /* name */, const std::type_info & /* ti */)
+RDF::RDataSource::Record_t RNTupleDS::GetColumnReadersImpl(std::string_view name, const std::type_info & /* ti */)
 {
+   // RDataFrame calls this overload when it books a column of the data source, i.e. before the event loop that
+   // reads it.  Remember the column such that Initialise() can announce it to the page sources.
+   const auto index = std::distance(fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), name));
+   if (static_cast<std::size_t>(index) < fColumnNames.size())
+      fColumnReaderPrototypes[index]->CollectColumnIds(fSources[0]->GetDescriptor(), fBookedColumns);
+
    // This datasource uses the GetColumnReaders2 API instead (better name in the works)
    return {};
 }
@@ -277,7 +358,7 @@ RNTupleDS::GetColumnReaders(unsigned int slot, std::string_view name, const std:
    // TODO(jblomer): check incoming type
    const auto index = std::distance(fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), name));
    auto clone = fColumnReaderPrototypes[index]->Clone();
-   clone->Connect(*fSources[slot]);
+   clone->Connect(*fSources[slot], &fSlotEntryEnds[slot]);
    return clone;
 }
 
@@ -286,6 +367,19 @@ bool RNTupleDS::SetEntry(unsigned int, ULong64_t)
    return true;
 }
 
+void RNTupleDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
+{
+   // In the sequential event loop, slot 0 processes all the ranges in a row
+   ULong64_t end = fSources[slot]->GetNEntries();
+   if (fNSlots > 1) {
+      auto itr = std::find_if(fRanges.begin(), fRanges.end(),
+                              [firstEntry](const std::pair<ULong64_t, ULong64_t> &r) { return r.first == firstEntry; });
+      if (itr != fRanges.end())
+         end = itr->second;
+   }
+   fSlotEntryEnds[slot] = end;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
    // TODO(jblomer): use cluster boundaries for the entry ranges
@@ -306,6 +400,7 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
    }
    ranges.back().second += reminder;
    fHasSeenAllRanges = true;
+   fRanges = ranges;
    return ranges;
 }
 
@@ -323,6 +418,13 @@ bool RNTupleDS::HasColumn(std::string_view colName) const
 void RNTupleDS::Initialise()
 {
    fHasSeenAllRanges = false;
+
+   // The columns booked for this event loop are known before its first cluster is scheduled.  Columns of filters
+   // and defines booked for an earlier event loop are added to the active columns of the page sources as their
+   // readers get connected, before the slots read their first entry.
+   for (auto &source : fSources)
+      source->SetExpectedColumns(fBookedColumns);
+   fBookedColumns.clear();
 }
 
 void RNTupleDS::Finalise() {}
@@ -338,6 +440,7 @@ void RNTupleDS::SetNSlots(unsigned int nSlots)
       assert(i == (fSources.size() - 1));
       fSources[i]->Attach();
    }
+   fSlotEntryEnds.resize(fNSlots, fSources[0]->GetNEntries());
 }
 } // namespace Experimental
 } // namespace ROOT
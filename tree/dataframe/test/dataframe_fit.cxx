@@ -0,0 +1,164 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/RLogLikelihoodFCN.hxx"
+#include "Fit/Fitter.h"
+#include "Math/WrappedMultiTF1.h"
+#include "TF1.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using ROOT::RDF::Experimental::RLogLikelihoodFCN;
+using FCN_t = RLogLikelihoodFCN<double>;
+
+// Fixture for all tests in this file. If parameter is true, run with implicit MT, else run sequentially
+class RDFFitTests : public ::testing::TestWithParam<bool> {
+protected:
+   RDFFitTests() : NSLOTS(GetParam() ? 4u : 1u)
+   {
+      if (GetParam())
+         ROOT::EnableImplicitMT(NSLOTS);
+   }
+   ~RDFFitTests()
+   {
+      if (GetParam())
+         ROOT::DisableImplicitMT();
+   }
+   const unsigned int NSLOTS;
+};
+
+namespace {
+const ULong64_t kNEntries = 20000;
+
+ROOT::RDF::RNode MakeDataFrame()
+{
+   ROOT::RDataFrame df(kNEntries);
+   return df
+      .Define("x",
+              [](ULong64_t entry) {
+                 TRandom3 r(entry + 1);
+                 return r.Gaus(1., 2.);
+              },
+              {"rdfentry_"})
+      .Define("w", [](ULong64_t entry) { return 0.5 + (entry % 3); }, {"rdfentry_"});
+}
+
+// Negative log-likelihood computed entry by entry
+double ExpectedNLL(const std::vector<double> &x, const std::vector<double> *w, const double *p)
+{
+   double nll = 0;
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      const double logval = std::log(p[0] * TMath::Gaus(x[i], p[1], p[2], true));
+      nll -= w ? (*w)[i] * logval : logval;
+   }
+   return nll;
+}
+} // namespace
+
+TEST_P(RDFFitTests, NLL)
+{
+   auto df = MakeDataFrame();
+   auto x = df.Take<double>("x");
+   auto w = df.Take<double>("w");
+
+   TF1 f("f", "gausn", -20, 20);
+   ROOT::Math::WrappedMultiTF1 model(f, 1);
+   const double p[] = {1., 0.5, 1.5};
+
+   for (auto mode : {FCN_t::EMode::kCache, FCN_t::EMode::kEventLoop}) {
+      FCN_t fcn(df, model, {"x"}, "", mode);
+      EXPECT_EQ(fcn.NPoints(), kNEntries);
+      EXPECT_NEAR(fcn(p), ExpectedNLL(*x, nullptr, p), 1e-8 * std::abs(fcn(p)));
+
+      FCN_t weightedFcn(df, model, {"x"}, "w", mode);
+      EXPECT_NEAR(weightedFcn(p), ExpectedNLL(*x, &*w, p), 1e-8 * std::abs(weightedFcn(p)));
+
+      // copies share the cached entries
+      std::unique_ptr<ROOT::Math::IMultiGenFunction> clone(fcn.Clone());
+      EXPECT_DOUBLE_EQ((*clone)(p), fcn(p));
+   }
+}
+
+TEST_P(RDFFitTests, Fitter)
+{
+   auto df = MakeDataFrame();
+   TF1 f("f", "gausn", -20, 20);
+   ROOT::Math::WrappedMultiTF1 model(f, 1);
+
+   for (auto mode : {FCN_t::EMode::kCache, FCN_t::EMode::kEventLoop}) {
+      FCN_t fcn(df, model, {"x"}, "", mode);
+      ROOT::Fit::Fitter fitter;
+      double p0[] = {1., 0., 1.};
+      fitter.Config().SetParamsSettings(3, p0);
+      fitter.Config().ParSettings(0).Fix();
+      fitter.Config().MinimizerOptions().SetErrorDef(0.5);
+      ASSERT_TRUE(fitter.FitFCN(fcn));
+      const auto &result = fitter.Result();
+      // true values are 1 and 2, the statistical errors about 0.014 and 0.01
+      EXPECT_NEAR(result.Parameter(1), 1., 0.06);
+      EXPECT_NEAR(result.Parameter(2), 2., 0.04);
+      EXPECT_NEAR(result.ParError(1), 2. / std::sqrt(kNEntries), 0.002);
+   }
+}
+
+TEST_P(RDFFitTests, DataElement)
+{
+   auto df = MakeDataFrame();
+   TF1 f("f", "gausn", -20, 20);
+   ROOT::Math::WrappedMultiTF1 model(f, 1);
+   double p[] = {1., 0.5, 1.5};
+
+   // the data elements are the weighted logarithms of the pdf, which sum up to minus the likelihood
+   FCN_t fcn(df, model, {"x"}, "w");
+   double sum = 0;
+   std::vector<double> g(3);
+   for (unsigned int i = 0; i < fcn.NPoints(); ++i)
+      sum += fcn.DataElement(p, i, g.data());
+   EXPECT_NEAR(-sum, fcn(p), 1e-8 * std::abs(sum));
+
+   // the gradient is the one of the weighted logarithm
+   for (unsigned int i : {0u, 1u, 2u}) {
+      fcn.DataElement(p, i, g.data());
+      for (unsigned int ipar = 1; ipar < 3; ++ipar) {
+         const double h = 1e-5;
+         const double p0 = p[ipar];
+         p[ipar] = p0 + h;
+         const double up = fcn.DataElement(p, i);
+         p[ipar] = p0 - h;
+         const double down = fcn.DataElement(p, i);
+         p[ipar] = p0;
+         EXPECT_NEAR(g[ipar], (up - down) / (2 * h), 1e-4 * (1 + std::abs(g[ipar])));
+      }
+   }
+}
+
+TEST_P(RDFFitTests, Fumili)
+{
+   auto df = MakeDataFrame();
+   TF1 f("f", "gausn", -20, 20);
+   ROOT::Math::WrappedMultiTF1 model(f, 1);
+
+   // Fumili builds the Hessian from the data elements
+   FCN_t fcn(df, model, {"x"});
+   ROOT::Fit::Fitter fitter;
+   double p0[] = {1., 0., 1.};
+   fitter.Config().SetParamsSettings(3, p0);
+   fitter.Config().ParSettings(0).Fix();
+   fitter.Config().SetMinimizer("Minuit2", "Fumili");
+   fitter.Config().MinimizerOptions().SetErrorDef(0.5);
+   ASSERT_TRUE(fitter.FitFCN(fcn));
+   const auto &result = fitter.Result();
+   EXPECT_NEAR(result.Parameter(1), 1., 0.06);
+   EXPECT_NEAR(result.Parameter(2), 2., 0.04);
+   EXPECT_NEAR(result.ParError(1), 2. / std::sqrt(kNEntries), 0.002);
+}
+
+INSTANTIATE_TEST_SUITE_P(Seq, RDFFitTests, ::testing::Values(false));
+
+#ifdef R__USE_IMT
+INSTANTIATE_TEST_SUITE_P(MT, RDFFitTests, ::testing::Values(true));
+#endif
@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
+
 using ROOT::Experimental::RNTupleDS;
 using ROOT::Experimental::RNTupleWriter;
 using ROOT::Experimental::RNTupleModel;
@@ -125,3 +128,43 @@ TEST_F(RNTupleDSTest, ReadMT)
 
    ReadTest(fNtplName, fFileName);
 }
+
+TEST(RNTupleDS, ReadBulkMT)
+{
+   // Neither the entry ranges of the slots nor the clusters are aligned with the windows of entries that the
+   // column readers of simple fields read in one go
+   const std::string fileName = "RNTupleDS_test_bulk.root";
+   const std::uint64_t nEntries = 10007;
+   {
+      auto model = RNTupleModel::Create();
+      auto id = model->MakeField<std::uint64_t>("id");
+      auto x = model->MakeField<float>("x");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName);
+      for (std::uint64_t i = 0; i < nEntries; ++i) {
+         *id = i;
+         *x = 0.5f * i;
+         ntuple->Fill();
+         if (i % 700 == 699)
+            ntuple->CommitCluster();
+      }
+   }
+
+   {
+      ROOT::EnableImplicitMT(3);
+      auto df = ROOT::Experimental::MakeNTupleDataFrame("ntuple", fileName);
+      auto count = df.Count();
+      auto nMismatches = df.Filter([](std::uint64_t id, float x) { return x != 0.5f * id; }, {"id", "x"}).Count();
+      auto ids = df.Take<std::uint64_t>("id");
+
+      EXPECT_EQ(nEntries, *count);
+      EXPECT_EQ(0u, *nMismatches);
+      auto sortedIds = *ids;
+      std::sort(sortedIds.begin(), sortedIds.end());
+      ASSERT_EQ(nEntries, sortedIds.size());
+      for (std::uint64_t i = 0; i < nEntries; ++i)
+         EXPECT_EQ(i, sortedIds[i]);
+      ROOT::DisableImplicitMT();
+   }
+
+   std::remove(fileName.c_str());
+}
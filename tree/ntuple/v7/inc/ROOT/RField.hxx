@@ -27,15 +27,21 @@
 #include <ROOT/TypeTraits.hxx>
 
 #include <TGenericClassInfo.h>
+#include <TVirtualCollectionProxy.h>
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 #if __cplusplus >= 201703L
 #include <variant>
 #endif
@@ -224,6 +230,11 @@ public:
       fPrincipalColumn->Read(clusterIndex, &value->fMappedElement);
    }
 
+   /// Populate the `nValues` consecutive values starting at `globalIndex` into the contiguous array `values`, which
+   /// has to hold `nValues` constructed objects of the fitting type.  Simple fields copy the values directly
+   /// from the pages, i.e. with one memcpy per page; other fields read the values one by one.
+   void ReadBulk(NTupleSize_t globalIndex, NTupleSize_t nValues, void *values);
+
    /// Ensure that all received items are written from page buffers to the storage.
    void Flush() const;
    /// Perform housekeeping tasks for global to cluster-local index translation
@@ -340,15 +351,23 @@ class RRecordField : public Detail::RFieldBase {
 private:
    std::size_t fMaxAlignment = 1;
    std::size_t fSize = 0;
+   /// The in-memory offset of every item in `fSubFields`
+   std::vector<std::size_t> fOffsets;
 
    std::size_t GetItemPadding(std::size_t baseOffset, std::size_t itemAlignment) const;
 
 protected:
-   std::unique_ptr<Detail::RFieldBase> CloneImpl(std::string_view newName) const final;
+   /// Used by derived classes that map to a C++ type with a given memory layout, such as std::pair
+   RRecordField(std::string_view fieldName, std::vector<std::unique_ptr<Detail::RFieldBase>> &&itemFields,
+                const std::vector<std::size_t> &offsets, std::string_view typeName = "");
+
+   std::unique_ptr<Detail::RFieldBase> CloneImpl(std::string_view newName) const override;
    std::size_t AppendImpl(const Detail::RFieldValue& value) final;
    void ReadGlobalImpl(NTupleSize_t globalIndex, Detail::RFieldValue *value) final;
    void ReadInClusterImpl(const RClusterIndex &clusterIndex, Detail::RFieldValue *value) final;
 
+   const std::vector<std::size_t> &GetOffsets() const { return fOffsets; }
+
 public:
    RRecordField(std::string_view fieldName, std::vector<std::unique_ptr<Detail::RFieldBase>> &itemFields);
    RRecordField(RRecordField&& other) = default;
@@ -367,6 +386,31 @@ public:
    void AcceptVisitor(Detail::RFieldVisitor &visitor) const final;
 };
 
+/// The generic field for std::pair<T1, T2>; it is stored as a record with the items "_0" (first) and "_1" (second)
+class RPairField : public RRecordField {
+private:
+   static std::string GetTypeName(const std::array<std::unique_ptr<Detail::RFieldBase>, 2> &itemFields);
+   static std::array<std::size_t, 2> GetMemberOffsets(const std::string &typeName);
+
+   RPairField(std::string_view fieldName, const std::string &typeName,
+              std::array<std::unique_ptr<Detail::RFieldBase>, 2> &&itemFields,
+              const std::array<std::size_t, 2> &offsets);
+
+protected:
+   std::unique_ptr<Detail::RFieldBase> CloneImpl(std::string_view newName) const override;
+
+   /// Used by the typed RField<std::pair<T1, T2>>, which knows the member offsets at compile time
+   RPairField(std::string_view fieldName, std::array<std::unique_ptr<Detail::RFieldBase>, 2> &&itemFields,
+              const std::array<std::size_t, 2> &offsets);
+
+public:
+   /// The member offsets are taken from the dictionary of the corresponding std::pair type
+   RPairField(std::string_view fieldName, std::array<std::unique_ptr<Detail::RFieldBase>, 2> &itemFields);
+   RPairField(RPairField &&other) = default;
+   RPairField &operator=(RPairField &&other) = default;
+   ~RPairField() = default;
+};
+
 /// The generic field for a (nested) std::vector<Type> except for std::vector<bool>
 class RVectorField : public Detail::RFieldBase {
 private:
@@ -403,6 +447,51 @@ public:
    }
 };
 
+/// The generic field for associative STL containers, i.e. std::set, std::unordered_set, std::map and
+/// std::unordered_map.  Like std::vector, the container is stored as an offset column plus the item field;
+/// the items of (unordered) maps are std::pair records.  Since the memory layout of these containers is
+/// implementation defined, the container is accessed through the TVirtualCollectionProxy of its dictionary.
+class RProxiedCollectionField : public Detail::RFieldBase {
+private:
+   std::unique_ptr<TVirtualCollectionProxy> fProxy;
+   std::size_t fItemSize;
+   ClusterSize_t fNWritten;
+   /// Staging area for the items read from disk before they are inserted in the container
+   std::vector<unsigned char> fReadBuffer;
+
+protected:
+   std::unique_ptr<Detail::RFieldBase> CloneImpl(std::string_view newName) const final;
+   std::size_t AppendImpl(const Detail::RFieldValue &value) final;
+   void ReadGlobalImpl(NTupleSize_t globalIndex, Detail::RFieldValue *value) final;
+
+public:
+   RProxiedCollectionField(std::string_view fieldName, std::string_view typeName,
+                           std::unique_ptr<Detail::RFieldBase> itemField);
+   RProxiedCollectionField(RProxiedCollectionField &&other) = default;
+   RProxiedCollectionField &operator=(RProxiedCollectionField &&other) = default;
+   ~RProxiedCollectionField() = default;
+
+   void GenerateColumnsImpl() final;
+   void GenerateColumnsImpl(const RNTupleDescriptor &desc) final;
+   using Detail::RFieldBase::GenerateValue;
+   Detail::RFieldValue GenerateValue(void *where) override;
+   void DestroyValue(const Detail::RFieldValue &value, bool dtorOnly = false) final;
+   Detail::RFieldValue CaptureValue(void *where) override;
+   std::vector<Detail::RFieldValue> SplitValue(const Detail::RFieldValue &value) const final;
+   size_t GetValueSize() const override;
+   size_t GetAlignment() const final { return alignof(std::max_align_t); }
+   void CommitCluster() final;
+   void AcceptVisitor(Detail::RFieldVisitor &visitor) const final;
+   void GetCollectionInfo(NTupleSize_t globalIndex, RClusterIndex *collectionStart, ClusterSize_t *size) const
+   {
+      fPrincipalColumn->GetCollectionInfo(globalIndex, collectionStart, size);
+   }
+   void GetCollectionInfo(const RClusterIndex &clusterIndex, RClusterIndex *collectionStart, ClusterSize_t *size) const
+   {
+      fPrincipalColumn->GetCollectionInfo(clusterIndex, collectionStart, size);
+   }
+};
+
 
 /// The generic field for fixed size arrays, which do not need an offset column
 class RArrayField : public Detail::RFieldBase {
@@ -1365,6 +1454,158 @@ public:
 };
 
 
+template <typename T1, typename T2>
+class RField<std::pair<T1, T2>> : public RPairField {
+   using ContainerT = typename std::pair<T1, T2>;
+private:
+   static std::array<std::unique_ptr<Detail::RFieldBase>, 2> BuildItemFields()
+   {
+      return {std::make_unique<RField<T1>>("_0"), std::make_unique<RField<T2>>("_1")};
+   }
+   static std::array<std::size_t, 2> BuildItemOffsets()
+   {
+      // offsetof is only conditionally supported for pairs of non-standard-layout types: take the addresses of
+      // the members in storage for a pair instead, without constructing it
+      alignas(ContainerT) unsigned char storage[sizeof(ContainerT)];
+      auto pair = reinterpret_cast<ContainerT *>(storage);
+      auto offsetOf = [&storage](const void *member) {
+         return static_cast<std::size_t>(static_cast<const unsigned char *>(member) - storage);
+      };
+      return {offsetOf(std::addressof(pair->first)), offsetOf(std::addressof(pair->second))};
+   }
+
+public:
+   static std::string TypeName() { return "std::pair<" + RField<T1>::TypeName() + "," + RField<T2>::TypeName() + ">"; }
+   explicit RField(std::string_view name) : RPairField(name, BuildItemFields(), BuildItemOffsets()) {}
+   RField(RField &&other) = default;
+   RField &operator=(RField &&other) = default;
+   ~RField() = default;
+
+   using Detail::RFieldBase::GenerateValue;
+   template <typename... ArgsT>
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where, ArgsT &&...args)
+   {
+      return Detail::RFieldValue(this, static_cast<ContainerT *>(where), std::forward<ArgsT>(args)...);
+   }
+};
+
+template <typename ItemT>
+class RField<std::set<ItemT>> : public RProxiedCollectionField {
+   using ContainerT = typename std::set<ItemT>;
+public:
+   static std::string TypeName() { return "std::set<" + RField<ItemT>::TypeName() + ">"; }
+   explicit RField(std::string_view name)
+      : RProxiedCollectionField(name, TypeName(), std::make_unique<RField<ItemT>>("_0"))
+   {}
+   RField(RField &&other) = default;
+   RField &operator=(RField &&other) = default;
+   ~RField() = default;
+
+   using Detail::RFieldBase::GenerateValue;
+   template <typename... ArgsT>
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where, ArgsT &&...args)
+   {
+      return Detail::RFieldValue(this, static_cast<ContainerT *>(where), std::forward<ArgsT>(args)...);
+   }
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where) final
+   {
+      return GenerateValue(where, ContainerT());
+   }
+   Detail::RFieldValue CaptureValue(void *where) final
+   {
+      return Detail::RFieldValue(true /* captureFlag */, this, where);
+   }
+   size_t GetValueSize() const final { return sizeof(ContainerT); }
+};
+
+template <typename ItemT>
+class RField<std::unordered_set<ItemT>> : public RProxiedCollectionField {
+   using ContainerT = typename std::unordered_set<ItemT>;
+public:
+   static std::string TypeName() { return "std::unordered_set<" + RField<ItemT>::TypeName() + ">"; }
+   explicit RField(std::string_view name)
+      : RProxiedCollectionField(name, TypeName(), std::make_unique<RField<ItemT>>("_0"))
+   {}
+   RField(RField &&other) = default;
+   RField &operator=(RField &&other) = default;
+   ~RField() = default;
+
+   using Detail::RFieldBase::GenerateValue;
+   template <typename... ArgsT>
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where, ArgsT &&...args)
+   {
+      return Detail::RFieldValue(this, static_cast<ContainerT *>(where), std::forward<ArgsT>(args)...);
+   }
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where) final
+   {
+      return GenerateValue(where, ContainerT());
+   }
+   Detail::RFieldValue CaptureValue(void *where) final
+   {
+      return Detail::RFieldValue(true /* captureFlag */, this, where);
+   }
+   size_t GetValueSize() const final { return sizeof(ContainerT); }
+};
+
+template <typename KeyT, typename ValueT>
+class RField<std::map<KeyT, ValueT>> : public RProxiedCollectionField {
+   using ContainerT = typename std::map<KeyT, ValueT>;
+public:
+   static std::string TypeName() { return "std::map<" + RField<KeyT>::TypeName() + "," + RField<ValueT>::TypeName() + ">"; }
+   explicit RField(std::string_view name)
+      : RProxiedCollectionField(name, TypeName(), std::make_unique<RField<std::pair<KeyT, ValueT>>>("_0"))
+   {}
+   RField(RField &&other) = default;
+   RField &operator=(RField &&other) = default;
+   ~RField() = default;
+
+   using Detail::RFieldBase::GenerateValue;
+   template <typename... ArgsT>
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where, ArgsT &&...args)
+   {
+      return Detail::RFieldValue(this, static_cast<ContainerT *>(where), std::forward<ArgsT>(args)...);
+   }
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where) final
+   {
+      return GenerateValue(where, ContainerT());
+   }
+   Detail::RFieldValue CaptureValue(void *where) final
+   {
+      return Detail::RFieldValue(true /* captureFlag */, this, where);
+   }
+   size_t GetValueSize() const final { return sizeof(ContainerT); }
+};
+
+template <typename KeyT, typename ValueT>
+class RField<std::unordered_map<KeyT, ValueT>> : public RProxiedCollectionField {
+   using ContainerT = typename std::unordered_map<KeyT, ValueT>;
+public:
+   static std::string TypeName() { return "std::unordered_map<" + RField<KeyT>::TypeName() + "," + RField<ValueT>::TypeName() + ">"; }
+   explicit RField(std::string_view name)
+      : RProxiedCollectionField(name, TypeName(), std::make_unique<RField<std::pair<KeyT, ValueT>>>("_0"))
+   {}
+   RField(RField &&other) = default;
+   RField &operator=(RField &&other) = default;
+   ~RField() = default;
+
+   using Detail::RFieldBase::GenerateValue;
+   template <typename... ArgsT>
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where, ArgsT &&...args)
+   {
+      return Detail::RFieldValue(this, static_cast<ContainerT *>(where), std::forward<ArgsT>(args)...);
+   }
+   ROOT::Experimental::Detail::RFieldValue GenerateValue(void *where) final
+   {
+      return GenerateValue(where, ContainerT());
+   }
+   Detail::RFieldValue CaptureValue(void *where) final
+   {
+      return Detail::RFieldValue(true /* captureFlag */, this, where);
+   }
+   size_t GetValueSize() const final { return sizeof(ContainerT); }
+};
+
+
 /**
  * The RVec type has different layouts depending on the item type, therefore we cannot go with a generic
  * RVec implementation as we can with std::vector
@@ -332,8 +332,14 @@ public:
    /// }
    /// ntuple->PrintInfo(ENTupleInfo::kMetrics);
    /// ~~~
+   /// For further processing, the metrics can be exported with `GetMetrics().PrintJSON()` or
+   /// `GetMetrics().PrintPrometheus()`.  Per-column counters and the I/O timeline require in addition
+   /// RNTupleReadOptions::SetDetailedMetrics().
    void EnableMetrics() { fMetrics.Enable(); }
    const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
+   /// Returns the timeline of cluster reading, decompression, and consumption or nullptr if the reader was not
+   /// opened with detailed metrics
+   const Detail::RNTupleTimeline *GetTimeline() const { return fSource->GetTimeline(); }
 };
 
 // clang-format off
@@ -19,6 +19,13 @@
 #include <ROOT/RError.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RSpan.hxx>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -35,7 +42,70 @@ private:
    /// The merged field descriptor
    RFieldDescriptor fMergedField = RFieldDescriptor();
 public:
+   /// Fields can be merged if they have the same name, type, structure and number of repetitions.  Sub fields are
+   /// not considered; the caller is responsible for merging the entire field tree.
    static RResult<RFieldMerger> Merge(const RFieldDescriptor &lhs, const RFieldDescriptor &rhs);
+
+   const RFieldDescriptor &GetMergedField() const { return fMergedField; }
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleMerger
+\ingroup NTuple
+\brief Given a set of RPageSources merge them into an RPageSink
+
+The merger copies the sealed (packed and compressed) pages of the sources cluster by cluster into the destination,
+like the fast cloning of TTree baskets.  Only the page lists as well as the header and the footer are rewritten.
+Pages are copied verbatim if the compression settings of the source column match the destination's compression
+settings; otherwise, they are decompressed and compressed again with the destination's settings.  The schema of the
+destination is taken from the first source.  All other sources need to provide the same fields and columns; their
+order in the descriptor, however, may differ.
+*/
+// clang-format on
+class RNTupleMerger {
+private:
+   /// Maps the columns of a source to the columns of the destination by their qualified name
+   struct RColumnInfo {
+      /// The qualified field name and the column index, e.g. `jets.pt.0`
+      std::string fColumnName;
+      DescriptorId_t fColumnInputId = kInvalidDescriptorId;
+      DescriptorId_t fColumnOutputId = kInvalidDescriptorId;
+      EColumnType fColumnType = EColumnType::kUnknown;
+   };
+
+   /// Column name --> column descriptor id, collected recursively for all sub fields of fieldId
+   using ColumnIdMap_t = std::unordered_map<std::string, DescriptorId_t>;
+   static void CollectColumns(const RNTupleDescriptor &descriptor, DescriptorId_t fieldId, ColumnIdMap_t &columns);
+
+   /// Checks that the field trees of both descriptors can be merged, starting from the given fields
+   static RResult<void> MergeFieldTrees(const RNTupleDescriptor &lhs, DescriptorId_t lhsFieldId,
+                                        const RNTupleDescriptor &rhs, DescriptorId_t rhsFieldId);
+
+   /// Creates the list of columns of the source that need to be copied to the destination
+   static RResult<std::vector<RColumnInfo>>
+   MatchColumns(const RNTupleDescriptor &source, const RNTupleDescriptor &destination);
+
+   /// Copies all the clusters of the given source into the destination
+   void MergeSource(Detail::RPageSource &source, const std::vector<RColumnInfo> &columns,
+                    Detail::RPageSink &destination);
+
+   /// Used for recompressing pages whose compression settings differ from the destination settings
+   std::unique_ptr<Detail::RNTupleDecompressor> fDecompressor;
+   std::unique_ptr<Detail::RNTupleCompressor> fCompressor;
+   /// The number of entries that are already committed to the destination
+   NTupleSize_t fNEntries = 0;
+
+public:
+   RNTupleMerger();
+   RNTupleMerger(const RNTupleMerger &other) = delete;
+   RNTupleMerger &operator=(const RNTupleMerger &other) = delete;
+   ~RNTupleMerger();
+
+   /// Merge the given sources into the destination.  The sources need to be attached, the destination must not be
+   /// created yet.  The destination is created from the schema of the first source and committed at the end.
+   /// Throws an RException if the sources cannot be merged.
+   void Merge(std::span<Detail::RPageSource *> sources, Detail::RPageSink &destination);
 };
 
 } // namespace Experimental
@@ -28,6 +28,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -322,10 +323,66 @@ public:
    void ObserveMetrics(RNTupleMetrics &observee);
 
    void Print(std::ostream &output, const std::string &prefix = "") const;
+   /// Writes the counters of this object and of the observed sub metrics as a nested JSON object
+   void PrintJSON(std::ostream &output) const;
+   /// Writes the counters in the Prometheus text exposition format. The metrics names are the counter names
+   /// with the namespace separators replaced by underscores. Disabled metrics are skipped.
+   void PrintPrometheus(std::ostream &output, const std::string &prefix = "") const;
    void Enable();
    bool IsEnabled() const { return fIsEnabled; }
 };
 
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleTimeline
+\ingroup NTuple
+\brief Records when clusters are read, decompressed, and consumed
+
+Similar to TTreePerfStats, the timeline shows whether the I/O thread and the decompression keep up with the consumer
+of the data.  Timestamps are in nanoseconds relative to the construction of the timeline.  Consumption of a cluster
+spans the time between populating the first and the last page of the cluster.  The class is thread-safe.
+*/
+// clang-format on
+class RNTupleTimeline {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+   enum class EEventType { kRead, kUnzip, kConsume };
+
+   struct REvent {
+      EEventType fType;
+      std::uint64_t fClusterId;
+      std::int64_t fStartNs;
+      std::int64_t fEndNs;
+   };
+
+private:
+   static constexpr std::uint64_t kInvalidClusterId = std::uint64_t(-1);
+
+   Clock_t::time_point fOrigin;
+   mutable std::mutex fLock;
+   std::vector<REvent> fEvents;
+   /// The currently consumed cluster; its event is committed to fEvents once another cluster is consumed
+   REvent fConsumeEvent{EEventType::kConsume, kInvalidClusterId, 0, 0};
+
+   std::int64_t ToNs(Clock_t::time_point tp) const
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(tp - fOrigin).count();
+   }
+
+public:
+   RNTupleTimeline() : fOrigin(Clock_t::now()) {}
+
+   void AddEvent(EEventType type, std::uint64_t clusterId, Clock_t::time_point start, Clock_t::time_point end);
+   /// Called when a page of the given cluster is handed out to the consumer
+   void MarkConsumed(std::uint64_t clusterId);
+   /// Returns the recorded events in the order of their completion
+   std::vector<REvent> GetEvents() const;
+   /// Writes the events in the Chrome trace event format, which can be displayed by e.g. chrome://tracing
+   void PrintJSON(std::ostream &output) const;
+};
+
 } // namespace Detail
 } // namespace Experimental
 } // namespace ROOT
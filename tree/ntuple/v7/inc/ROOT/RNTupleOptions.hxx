@@ -19,6 +19,7 @@
 #include <Compression.h>
 #include <ROOT/RNTupleUtil.hxx>
 
+#include <cstddef>
 #include <memory>
 
 namespace ROOT {
@@ -126,15 +127,29 @@ public:
       kDefault = kOn,
    };
 
+   /// Indicates that the page coalescing gap is derived from the tolerated read overhead, see SetCoalescingGap()
+   static constexpr std::size_t kCoalescingGapAuto = std::size_t(-1);
+
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
    unsigned int fClusterBunchSize = 1;
+   std::size_t fCoalescingGap = kCoalescingGapAuto;
+   bool fDetailedMetrics = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
    unsigned int GetClusterBunchSize() const  { return fClusterBunchSize; }
    void SetClusterBunchSize(unsigned int val) { fClusterBunchSize = val; }
+   std::size_t GetCoalescingGap() const { return fCoalescingGap; }
+   /// When loading a cluster, pages separated on storage by no more than the given number of bytes are read with
+   /// a single request.  By default, the gap is chosen such that at most 25% of extra bytes are read.
+   void SetCoalescingGap(std::size_t val) { fCoalescingGap = val; }
+   bool GetDetailedMetrics() const { return fDetailedMetrics; }
+   /// If set, the page source additionally provides per-column I/O counters and a timeline of cluster
+   /// loading, decompression, and consumption.  Like the other counters, they are only filled once the metrics
+   /// are enabled.
+   void SetDetailedMetrics(bool val) { fDetailedMetrics = val; }
 };
 
 } // namespace Experimental
@@ -215,6 +215,13 @@ public:
    MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
       return fField.MapV(clusterIndex, nItems);
    }
+
+   /// Copies the values of the `nItems` consecutive indexes starting at `globalIndex` into `buffer`, which needs
+   /// to hold `nItems` constructed objects.  For mappable fields, the values are copied page by page in one go;
+   /// MapV() provides zero-copy access to the same page ranges.
+   void ReadBulk(NTupleSize_t globalIndex, NTupleSize_t nItems, T *buffer) {
+      fField.ReadBulk(globalIndex, nItems, buffer);
+   }
 };
 
 
@@ -231,6 +238,24 @@ class RNTupleViewCollection : public RNTupleView<ClusterSize_t> {
 private:
    Detail::RPageSource* fSource;
    DescriptorId_t fCollectionFieldId;
+   /// A column with one element per collection item, used to translate cluster-local into global item indexes
+   DescriptorId_t fItemColumnId = kInvalidDescriptorId;
+
+   NTupleSize_t GetGlobalItemIndex(const RClusterIndex &clusterIndex) {
+      const auto &desc = fSource->GetDescriptor();
+      // The principal column of the first (possibly nested) sub field has exactly one element per item
+      auto fieldId = fCollectionFieldId;
+      while (fItemColumnId == kInvalidDescriptorId) {
+         const auto &linkIds = desc.GetFieldDescriptor(fieldId).GetLinkIds();
+         if (linkIds.empty())
+            throw RException(R__FAIL("collection '" + desc.GetFieldDescriptor(fCollectionFieldId).GetFieldName() +
+                                     "' has no item columns"));
+         fieldId = linkIds[0];
+         fItemColumnId = desc.FindColumnId(fieldId, 0);
+      }
+      const auto &columnRange = desc.GetClusterDescriptor(clusterIndex.GetClusterId()).GetColumnRange(fItemColumnId);
+      return columnRange.fFirstElementIndex + clusterIndex.GetIndex();
+   }
 
    RNTupleViewCollection(DescriptorId_t fieldId, Detail::RPageSource* source)
       : RNTupleView<ClusterSize_t>(fieldId, source)
@@ -282,6 +307,21 @@ public:
       return RNTupleViewCollection(fieldId, fSource);
    }
 
+   /// Fills the `nItems + 1` collection offsets for the `nItems` consecutive collections starting at `globalIndex`,
+   /// such that the items of collection `globalIndex + i` have the global indexes `[offsets[i], offsets[i + 1])`.
+   /// Together with RNTupleView::ReadBulk() of the item fields, this gives bulk access to the collection values.
+   void ReadBulk(NTupleSize_t globalIndex, NTupleSize_t nItems, NTupleSize_t *offsets) {
+      ClusterSize_t size;
+      RClusterIndex collectionStart;
+      for (NTupleSize_t i = 0; i < nItems; ++i) {
+         fField.GetCollectionInfo(globalIndex + i, &collectionStart, &size);
+         // Items of consecutive collections are consecutive in the global item index space, also across clusters
+         if (i == 0)
+            offsets[0] = GetGlobalItemIndex(collectionStart);
+         offsets[i + 1] = offsets[i] + size;
+      }
+   }
+
    ClusterSize_t operator()(NTupleSize_t globalIndex) {
       ClusterSize_t size;
       RClusterIndex collectionStart;
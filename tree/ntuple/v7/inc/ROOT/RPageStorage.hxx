@@ -230,6 +230,8 @@ public:
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
    /// Returns the sink's write options.
    const RNTupleWriteOptions &GetWriteOptions() const { return *fOptions; }
+   /// Returns the descriptor as built so far, i.e. the schema after Create() and the committed clusters
+   const RNTupleDescriptor &GetDescriptor() const { return fDescriptorBuilder.GetDescriptor(); }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t /*columnHandle*/) final {}
@@ -290,6 +292,25 @@ protected:
       RNTupleCalcPerf &fCompressionRatio;
    };
    std::unique_ptr<RCounters> fCounters;
+   /// Per-column I/O counters, available if the page source is opened with detailed metrics
+   struct RColumnCounters {
+      /// The column counters are grouped in a sub metrics object named "column<column id>"
+      RNTupleMetrics fMetrics;
+      RNTupleAtomicCounter &fNPageLoaded;
+      RNTupleAtomicCounter &fSzReadPayload;
+      RNTupleAtomicCounter &fSzUnzip;
+      RNTupleAtomicCounter &fTimeWallUnzip;
+      RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuUnzip;
+      RNTupleCalcPerf &fCompressionRatio;
+
+      explicit RColumnCounters(const std::string &name);
+   };
+   /// Indexed by column id; empty unless detailed metrics are requested by the read options
+   std::vector<std::unique_ptr<RColumnCounters>> fColumnCounters;
+   /// Never enabled; returned by GetColumnCounters() for columns without their own counters
+   std::unique_ptr<RColumnCounters> fDisabledColumnCounters;
+   /// Only set if detailed metrics are requested by the read options
+   std::unique_ptr<RNTupleTimeline> fTimeline;
    /// Wraps the I/O counters and is observed by the RNTupleReader metrics
    RNTupleMetrics fMetrics;
 
@@ -297,6 +318,8 @@ protected:
    RNTupleDescriptor fDescriptor;
    /// The active columns are implicitly defined by the model fields or views
    RCluster::ColumnSet_t fActiveColumns;
+   /// Columns that are announced to be read before their fields are connected, see SetExpectedColumns()
+   RCluster::ColumnSet_t fExpectedColumns;
 
    /// Helper to unzip pages and header/footer; comprises a 16MB (kMAXZIPBUF) unzip buffer.
    /// Not all page sources need a decompressor (e.g. virtual ones for chains and friends don't), thus we
@@ -308,6 +331,9 @@ protected:
    virtual void UnzipClusterImpl(RCluster * /* cluster */)
       { }
 
+   /// The union of the active and the expected columns; that is the column set requested from the cluster pool
+   RCluster::ColumnSet_t GetRequestedColumns() const;
+
    /// Helper for unstreaming a page. This is commonly used in derived, concrete page sources.  The implementation
    /// currently always makes a memory copy, even if the sealed page is uncompressed and in the final memory layout.
    /// The optimization of directly mapping pages is left to the concrete page source implementations.
@@ -321,6 +347,16 @@ protected:
    /// Alternatively, a subclass might provide its own RNTupleMetrics object by overriding the
    /// GetMetrics() member function.
    void EnableDefaultMetrics(const std::string &prefix);
+   /// Creates the per-column counters and the timeline once the descriptor is known; called by Attach()
+   void EnableDetailedMetrics();
+   /// Returns the counters of the given column or, if there are none, a set of disabled counters.  Thus the
+   /// returned counters can be used unconditionally.  Requires EnableDefaultMetrics().
+   RColumnCounters &GetColumnCounters(DescriptorId_t columnId)
+   {
+      return (columnId < fColumnCounters.size()) ? *fColumnCounters[columnId] : *fDisabledColumnCounters;
+   }
+   /// Returns the timeline if it exists and the metrics are enabled, nullptr otherwise
+   RNTupleTimeline *GetActiveTimeline() { return (fTimeline && fMetrics.IsEnabled()) ? fTimeline.get() : nullptr; }
 
 public:
    RPageSource(std::string_view ntupleName, const RNTupleReadOptions &fOptions);
@@ -340,9 +376,15 @@ public:
    const RNTupleReadOptions &GetReadOptions() const { return fOptions; }
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) override;
    void DropColumn(ColumnHandle_t columnHandle) override;
+   /// Announce the columns that are going to be read, e.g. the columns booked by an RDataFrame event loop, before
+   /// the corresponding fields are connected.  Clusters are then loaded with all of these columns in one go
+   /// rather than being completed column by column as more fields get connected.  Must not be called
+   /// concurrently to reading from the page source.
+   void SetExpectedColumns(const RCluster::ColumnSet_t &columns) { fExpectedColumns = columns; }
+   const RCluster::ColumnSet_t &GetExpectedColumns() const { return fExpectedColumns; }
 
    /// Open the physical storage container for the tree
-   void Attach() { fDescriptor = AttachImpl(); }
+   void Attach();
    NTupleSize_t GetNEntries();
    NTupleSize_t GetNElements(ColumnHandle_t columnHandle);
    ColumnId_t GetColumnId(ColumnHandle_t columnHandle);
@@ -377,6 +419,8 @@ public:
 
    /// Returns the default metrics object.  Subclasses might alternatively override the method and provide their own metrics object.
    virtual RNTupleMetrics &GetMetrics() override { return fMetrics; };
+   /// Returns nullptr unless the page source was opened with detailed metrics, see RNTupleReadOptions
+   const RNTupleTimeline *GetTimeline() const { return fTimeline.get(); }
 };
 
 } // namespace Detail
@@ -38,6 +38,7 @@
 #include <cstring> // for memset
 #include <exception>
 #include <iostream>
+#include <limits>
 #include <type_traits>
 #include <unordered_map>
 
@@ -124,6 +125,11 @@ std::string GetNormalizedType(const std::string &typeName) {
    if (normalizedType.substr(0, 7) == "vector<") normalizedType = "std::" + normalizedType;
    if (normalizedType.substr(0, 6) == "array<") normalizedType = "std::" + normalizedType;
    if (normalizedType.substr(0, 8) == "variant<") normalizedType = "std::" + normalizedType;
+   if (normalizedType.substr(0, 5) == "pair<") normalizedType = "std::" + normalizedType;
+   if (normalizedType.substr(0, 4) == "set<") normalizedType = "std::" + normalizedType;
+   if (normalizedType.substr(0, 4) == "map<") normalizedType = "std::" + normalizedType;
+   if (normalizedType.substr(0, 14) == "unordered_set<") normalizedType = "std::" + normalizedType;
+   if (normalizedType.substr(0, 14) == "unordered_map<") normalizedType = "std::" + normalizedType;
 
    return normalizedType;
 }
@@ -201,6 +207,29 @@ ROOT::Experimental::Detail::RFieldBase::Create(const std::string &fieldName, con
       auto arrayLength = std::stoi(arrayDef[1]);
       auto itemField = Create(GetNormalizedType(arrayDef[0]), arrayDef[0]);
       result = std::make_unique<RArrayField>(fieldName, itemField.Unwrap(), arrayLength);
+   } else if (normalizedType.substr(0, 10) == "std::pair<") {
+      auto innerTypes = TokenizeTypeList(normalizedType.substr(10, normalizedType.length() - 11));
+      if (innerTypes.size() != 2)
+         return R__FAIL(std::string("Field ") + fieldName + " has invalid pair type " + normalizedType);
+      std::array<std::unique_ptr<RFieldBase>, 2> items{Create("_0", innerTypes[0]).Unwrap(),
+                                                       Create("_1", innerTypes[1]).Unwrap()};
+      result = std::make_unique<RPairField>(fieldName, items);
+   } else if (normalizedType.substr(0, 9) == "std::set<" || normalizedType.substr(0, 19) == "std::unordered_set<") {
+      auto prefixLength = normalizedType.find('<') + 1;
+      auto innerTypes =
+         TokenizeTypeList(normalizedType.substr(prefixLength, normalizedType.length() - prefixLength - 1));
+      if (innerTypes.empty())
+         return R__FAIL(std::string("Field ") + fieldName + " has invalid set type " + normalizedType);
+      auto itemField = Create("_0", innerTypes[0]);
+      result = std::make_unique<RProxiedCollectionField>(fieldName, normalizedType, itemField.Unwrap());
+   } else if (normalizedType.substr(0, 9) == "std::map<" || normalizedType.substr(0, 19) == "std::unordered_map<") {
+      auto prefixLength = normalizedType.find('<') + 1;
+      auto innerTypes =
+         TokenizeTypeList(normalizedType.substr(prefixLength, normalizedType.length() - prefixLength - 1));
+      if (innerTypes.size() < 2)
+         return R__FAIL(std::string("Field ") + fieldName + " has invalid map type " + normalizedType);
+      auto itemField = Create("_0", "std::pair<" + innerTypes[0] + "," + innerTypes[1] + ">");
+      result = std::make_unique<RProxiedCollectionField>(fieldName, normalizedType, itemField.Unwrap());
    }
 #if __cplusplus >= 201703L
    if (normalizedType.substr(0, 13) == "std::variant<") {
@@ -350,6 +379,28 @@ void ROOT::Experimental::Detail::RFieldBase::ConnectPageSink(RPageSink &pageSink
 }
 
 
+void ROOT::Experimental::Detail::RFieldBase::ReadBulk(NTupleSize_t globalIndex, NTupleSize_t nValues, void *values)
+{
+   if (!fIsSimple) {
+      for (NTupleSize_t i = 0; i < nValues; ++i) {
+         auto value = CaptureValue(static_cast<unsigned char *>(values) + i * GetValueSize());
+         ReadGlobalImpl(globalIndex + i, &value);
+      }
+      return;
+   }
+
+   auto value = CaptureValue(values);
+   NTupleSize_t nRead = 0;
+   while (nRead < nValues) {
+      // RColumn::ReadV() takes care of page boundaries but counts in cluster size units
+      auto nBatch = static_cast<ClusterSize_t::ValueType>(std::min(
+         nValues - nRead, static_cast<NTupleSize_t>(std::numeric_limits<ClusterSize_t::ValueType>::max())));
+      RColumnElementBase elemArray(value.fMappedElement, nRead);
+      fPrincipalColumn->ReadV(globalIndex + nRead, nBatch, &elemArray);
+      nRead += nBatch;
+   }
+}
+
 void ROOT::Experimental::Detail::RFieldBase::ConnectPageSource(RPageSource &pageSource)
 {
    R__ASSERT(fColumns.empty());
@@ -888,15 +939,35 @@ void ROOT::Experimental::RClassField::AcceptVisitor(Detail::RFieldVisitor &visit
 
 //------------------------------------------------------------------------------
 
+ROOT::Experimental::RRecordField::RRecordField(std::string_view fieldName,
+                                               std::vector<std::unique_ptr<Detail::RFieldBase>> &&itemFields,
+                                               const std::vector<std::size_t> &offsets, std::string_view typeName)
+   : ROOT::Experimental::Detail::RFieldBase(fieldName, typeName, ENTupleStructure::kRecord, false /* isSimple */),
+     fOffsets(offsets)
+{
+   R__ASSERT(itemFields.size() == fOffsets.size());
+   for (std::size_t i = 0; i < itemFields.size(); ++i) {
+      fMaxAlignment = std::max(fMaxAlignment, itemFields[i]->GetAlignment());
+      fSize = std::max(fSize, fOffsets[i] + itemFields[i]->GetValueSize());
+      Attach(std::move(itemFields[i]));
+   }
+   fSize += GetItemPadding(fSize, fMaxAlignment);
+}
+
 ROOT::Experimental::RRecordField::RRecordField(
    std::string_view fieldName, std::vector<std::unique_ptr<Detail::RFieldBase>> &itemFields)
    : ROOT::Experimental::Detail::RFieldBase(fieldName, "", ENTupleStructure::kRecord, false /* isSimple */)
 {
    for (auto &item : itemFields) {
       fMaxAlignment = std::max(fMaxAlignment, item->GetAlignment());
-      fSize += GetItemPadding(fSize, item->GetAlignment()) + item->GetValueSize();
+      fSize += GetItemPadding(fSize, item->GetAlignment());
+      fOffsets.push_back(fSize);
+      fSize += item->GetValueSize();
       Attach(std::move(item));
    }
+   // Trailing padding: although this is implementation specific, most add enough padding to comply with the
+   // requirements of the type with strictest alignment
+   fSize += GetItemPadding(fSize, fMaxAlignment);
 }
 
 
@@ -916,57 +987,47 @@ ROOT::Experimental::RRecordField::CloneImpl(std::string_view newName) const
    std::vector<std::unique_ptr<Detail::RFieldBase>> cloneItems;
    for (auto &item : fSubFields)
       cloneItems.emplace_back(item->Clone(item->GetName()));
-   return std::make_unique<RRecordField>(newName, cloneItems);
+   return std::unique_ptr<RRecordField>(new RRecordField(newName, std::move(cloneItems), fOffsets, GetType()));
 }
 
 std::size_t ROOT::Experimental::RRecordField::AppendImpl(const Detail::RFieldValue &value) {
    std::size_t nbytes = 0;
-   std::size_t offset = 0;
-   for (auto &item : fSubFields) {
-      auto memberValue = item->CaptureValue(value.Get<unsigned char>() + offset);
-      nbytes += item->Append(memberValue);
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      auto memberValue = fSubFields[i]->CaptureValue(value.Get<unsigned char>() + fOffsets[i]);
+      nbytes += fSubFields[i]->Append(memberValue);
    }
    return nbytes;
 }
 
 void ROOT::Experimental::RRecordField::ReadGlobalImpl(NTupleSize_t globalIndex, Detail::RFieldValue *value)
 {
-   std::size_t offset = 0;
-   for (auto &item : fSubFields) {
-      auto memberValue = item->CaptureValue(value->Get<unsigned char>() + offset);
-      item->Read(globalIndex, &memberValue);
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      auto memberValue = fSubFields[i]->CaptureValue(value->Get<unsigned char>() + fOffsets[i]);
+      fSubFields[i]->Read(globalIndex, &memberValue);
    }
 }
 
 void ROOT::Experimental::RRecordField::ReadInClusterImpl(const RClusterIndex &clusterIndex, Detail::RFieldValue *value)
 {
-   std::size_t offset = 0;
-   for (auto &item : fSubFields) {
-      auto memberValue = item->CaptureValue(value->Get<unsigned char>() + offset);
-      item->Read(clusterIndex, &memberValue);
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      auto memberValue = fSubFields[i]->CaptureValue(value->Get<unsigned char>() + fOffsets[i]);
+      fSubFields[i]->Read(clusterIndex, &memberValue);
    }
 }
 
 ROOT::Experimental::Detail::RFieldValue ROOT::Experimental::RRecordField::GenerateValue(void *where)
 {
-   std::size_t offset = 0;
-   for (auto &item : fSubFields) {
-      item->GenerateValue(static_cast<unsigned char *>(where) + offset);
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      fSubFields[i]->GenerateValue(static_cast<unsigned char *>(where) + fOffsets[i]);
    }
    return Detail::RFieldValue(true /* captureFlag */, this, where);
 }
 
 void ROOT::Experimental::RRecordField::DestroyValue(const Detail::RFieldValue& value, bool dtorOnly)
 {
-   std::size_t offset = 0;
-   for (auto &item : fSubFields) {
-      auto memberValue = item->CaptureValue(value.Get<unsigned char>() + offset);
-      item->DestroyValue(memberValue, true /* dtorOnly */);
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      auto memberValue = fSubFields[i]->CaptureValue(value.Get<unsigned char>() + fOffsets[i]);
+      fSubFields[i]->DestroyValue(memberValue, true /* dtorOnly */);
    }
 
    if (!dtorOnly)
@@ -982,11 +1043,9 @@ ROOT::Experimental::Detail::RFieldValue ROOT::Experimental::RRecordField::Captur
 std::vector<ROOT::Experimental::Detail::RFieldValue>
 ROOT::Experimental::RRecordField::SplitValue(const Detail::RFieldValue &value) const
 {
-   std::size_t offset = 0;
    std::vector<Detail::RFieldValue> result;
-   for (auto &item : fSubFields) {
-      result.emplace_back(item->CaptureValue(value.Get<unsigned char>() + offset));
-      offset += GetItemPadding(offset, item->GetAlignment()) + item->GetValueSize();
+   for (unsigned i = 0; i < fSubFields.size(); ++i) {
+      result.emplace_back(fSubFields[i]->CaptureValue(value.Get<unsigned char>() + fOffsets[i]));
    }
    return result;
 }
@@ -999,6 +1058,183 @@ void ROOT::Experimental::RRecordField::AcceptVisitor(Detail::RFieldVisitor &visi
 
 //------------------------------------------------------------------------------
 
+std::string
+ROOT::Experimental::RPairField::GetTypeName(const std::array<std::unique_ptr<Detail::RFieldBase>, 2> &itemFields)
+{
+   return "std::pair<" + itemFields[0]->GetType() + "," + itemFields[1]->GetType() + ">";
+}
+
+std::array<std::size_t, 2> ROOT::Experimental::RPairField::GetMemberOffsets(const std::string &typeName)
+{
+   auto cl = TClass::GetClass(typeName.c_str());
+   if (cl == nullptr)
+      throw RException(R__FAIL("RField: no I/O support for type " + typeName));
+   auto offsetFirst = cl->GetDataMemberOffset("first");
+   auto offsetSecond = cl->GetDataMemberOffset("second");
+   if (offsetFirst < 0 || offsetSecond < 0)
+      throw RException(R__FAIL("RField: cannot determine the memory layout of " + typeName));
+   return {static_cast<std::size_t>(offsetFirst), static_cast<std::size_t>(offsetSecond)};
+}
+
+ROOT::Experimental::RPairField::RPairField(std::string_view fieldName, const std::string &typeName,
+                                           std::array<std::unique_ptr<Detail::RFieldBase>, 2> &&itemFields,
+                                           const std::array<std::size_t, 2> &offsets)
+   : ROOT::Experimental::RRecordField(
+        fieldName,
+        std::vector<std::unique_ptr<Detail::RFieldBase>>(std::make_move_iterator(itemFields.begin()),
+                                                         std::make_move_iterator(itemFields.end())),
+        {offsets[0], offsets[1]}, typeName)
+{
+}
+
+ROOT::Experimental::RPairField::RPairField(std::string_view fieldName,
+                                           std::array<std::unique_ptr<Detail::RFieldBase>, 2> &&itemFields,
+                                           const std::array<std::size_t, 2> &offsets)
+   : RPairField(fieldName, GetTypeName(itemFields), std::move(itemFields), offsets)
+{
+}
+
+ROOT::Experimental::RPairField::RPairField(std::string_view fieldName,
+                                           std::array<std::unique_ptr<Detail::RFieldBase>, 2> &itemFields)
+   : RPairField(fieldName, std::move(itemFields), GetMemberOffsets(GetTypeName(itemFields)))
+{
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RFieldBase>
+ROOT::Experimental::RPairField::CloneImpl(std::string_view newName) const
+{
+   std::array<std::unique_ptr<Detail::RFieldBase>, 2> cloneItems = {fSubFields[0]->Clone(fSubFields[0]->GetName()),
+                                                                    fSubFields[1]->Clone(fSubFields[1]->GetName())};
+   return std::unique_ptr<RPairField>(new RPairField(newName, std::move(cloneItems), {GetOffsets()[0], GetOffsets()[1]}));
+}
+
+//------------------------------------------------------------------------------
+
+ROOT::Experimental::RProxiedCollectionField::RProxiedCollectionField(std::string_view fieldName,
+                                                                     std::string_view typeName,
+                                                                     std::unique_ptr<Detail::RFieldBase> itemField)
+   : ROOT::Experimental::Detail::RFieldBase(fieldName, typeName, ENTupleStructure::kCollection, false /* isSimple */),
+     fItemSize(itemField->GetValueSize()), fNWritten(0)
+{
+   auto cl = TClass::GetClass(std::string(typeName).c_str());
+   if (cl == nullptr || cl->GetCollectionProxy() == nullptr)
+      throw RException(R__FAIL("RField: no I/O support for type " + std::string(typeName)));
+   fProxy.reset(cl->GetCollectionProxy()->Generate());
+   if (fProxy->GetProperties() & TVirtualCollectionProxy::kIsEmulated)
+      throw RException(R__FAIL("RField: emulated collection proxy for " + std::string(typeName) + " is not supported"));
+   if (fProxy->GetIncrement() != fItemSize) {
+      throw RException(R__FAIL("RField: item size mismatch for " + std::string(typeName) + " (" +
+                               std::to_string(fProxy->GetIncrement()) + " vs. " + std::to_string(fItemSize) + ")"));
+   }
+   Attach(std::move(itemField));
+}
+
+std::unique_ptr<ROOT::Experimental::Detail::RFieldBase>
+ROOT::Experimental::RProxiedCollectionField::CloneImpl(std::string_view newName) const
+{
+   auto newItemField = fSubFields[0]->Clone(fSubFields[0]->GetName());
+   return std::make_unique<RProxiedCollectionField>(newName, GetType(), std::move(newItemField));
+}
+
+std::size_t ROOT::Experimental::RProxiedCollectionField::AppendImpl(const Detail::RFieldValue &value)
+{
+   TVirtualCollectionProxy::TPushPop RAII(fProxy.get(), value.GetRawPtr());
+   std::size_t nbytes = 0;
+   auto count = fProxy->Size();
+   for (unsigned i = 0; i < count; ++i) {
+      auto itemValue = fSubFields[0]->CaptureValue(fProxy->At(i));
+      nbytes += fSubFields[0]->Append(itemValue);
+   }
+   Detail::RColumnElement<ClusterSize_t> elemIndex(&fNWritten);
+   fNWritten += count;
+   fColumns[0]->Append(elemIndex);
+   return nbytes + sizeof(elemIndex);
+}
+
+void ROOT::Experimental::RProxiedCollectionField::ReadGlobalImpl(NTupleSize_t globalIndex, Detail::RFieldValue *value)
+{
+   ClusterSize_t nItems;
+   RClusterIndex collectionStart;
+   fPrincipalColumn->GetCollectionInfo(globalIndex, &collectionStart, &nItems);
+
+   // The items cannot be read in place because the memory layout of the container is unknown; they are read
+   // into a staging buffer instead and then inserted in one go
+   TVirtualCollectionProxy::TPushPop RAII(fProxy.get(), value->GetRawPtr());
+   fProxy->Clear();
+   if (nItems == 0)
+      return;
+
+   fReadBuffer.resize(nItems * fItemSize);
+   for (std::size_t i = 0; i < nItems; ++i) {
+      auto itemValue = fSubFields[0]->GenerateValue(fReadBuffer.data() + (i * fItemSize));
+      fSubFields[0]->Read(collectionStart + i, &itemValue);
+   }
+   fProxy->Insert(fReadBuffer.data(), value->GetRawPtr(), nItems);
+   for (std::size_t i = 0; i < nItems; ++i) {
+      auto itemValue = fSubFields[0]->CaptureValue(fReadBuffer.data() + (i * fItemSize));
+      fSubFields[0]->DestroyValue(itemValue, true /* dtorOnly */);
+   }
+}
+
+void ROOT::Experimental::RProxiedCollectionField::GenerateColumnsImpl()
+{
+   RColumnModel modelIndex(EColumnType::kIndex, true /* isSorted*/);
+   fColumns.emplace_back(std::unique_ptr<Detail::RColumn>(
+      Detail::RColumn::Create<ClusterSize_t, EColumnType::kIndex>(modelIndex, 0)));
+}
+
+void ROOT::Experimental::RProxiedCollectionField::GenerateColumnsImpl(const RNTupleDescriptor &desc)
+{
+   EnsureColumnType({EColumnType::kIndex}, 0, desc);
+   GenerateColumnsImpl();
+}
+
+ROOT::Experimental::Detail::RFieldValue ROOT::Experimental::RProxiedCollectionField::GenerateValue(void *where)
+{
+   return Detail::RFieldValue(true /* captureFlag */, this, fProxy->New(where));
+}
+
+void ROOT::Experimental::RProxiedCollectionField::DestroyValue(const Detail::RFieldValue &value, bool dtorOnly)
+{
+   fProxy->Destructor(value.GetRawPtr(), true /* dtorOnly */);
+   if (!dtorOnly)
+      free(value.GetRawPtr());
+}
+
+ROOT::Experimental::Detail::RFieldValue ROOT::Experimental::RProxiedCollectionField::CaptureValue(void *where)
+{
+   return Detail::RFieldValue(true /* captureFlag */, this, where);
+}
+
+std::vector<ROOT::Experimental::Detail::RFieldValue>
+ROOT::Experimental::RProxiedCollectionField::SplitValue(const Detail::RFieldValue &value) const
+{
+   TVirtualCollectionProxy::TPushPop RAII(fProxy.get(), value.GetRawPtr());
+   auto nItems = fProxy->Size();
+   std::vector<Detail::RFieldValue> result;
+   for (unsigned i = 0; i < nItems; ++i) {
+      result.emplace_back(fSubFields[0]->CaptureValue(fProxy->At(i)));
+   }
+   return result;
+}
+
+size_t ROOT::Experimental::RProxiedCollectionField::GetValueSize() const
+{
+   return fProxy->Sizeof();
+}
+
+void ROOT::Experimental::RProxiedCollectionField::CommitCluster()
+{
+   fNWritten = 0;
+}
+
+void ROOT::Experimental::RProxiedCollectionField::AcceptVisitor(Detail::RFieldVisitor &visitor) const
+{
+   visitor.VisitProxiedCollectionField(*this);
+}
+
+//------------------------------------------------------------------------------
+
 
 ROOT::Experimental::RVectorField::RVectorField(
    std::string_view fieldName, std::unique_ptr<Detail::RFieldBase> itemField)
@@ -327,6 +327,12 @@ void ROOT::Experimental::RPrintValueVisitor::VisitVectorField(const RVectorField
 }
 
 
+void ROOT::Experimental::RPrintValueVisitor::VisitProxiedCollectionField(const RProxiedCollectionField &field)
+{
+   PrintCollection(field);
+}
+
+
 void ROOT::Experimental::RPrintValueVisitor::VisitVectorBoolField(const RField<std::vector<bool>> &field)
 {
    PrintCollection(field);
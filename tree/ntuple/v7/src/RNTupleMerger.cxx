@@ -13,17 +13,82 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RError.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleMerger.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+
+#include <TError.h>
+#include <TFile.h>
+#include <TFileMergeInfo.h>
+#include <TObjString.h>
+
+#include <algorithm>
+#include <utility>
 
 Long64_t ROOT::Experimental::RNTuple::Merge(TCollection* inputs, TFileMergeInfo* mergeInfo) {
+   // The input list is expected to contain the name of the ntuple as a TObjString, followed by the TFile
+   // objects of the files to be merged (see TFileMerger::MergeOne)
    if (inputs == nullptr || mergeInfo == nullptr) {
       return -1;
    }
-   return -1;
+   if (inputs->GetEntries() < 2) {
+      return -1;
+   }
+   auto outFile = dynamic_cast<TFile *>(mergeInfo->fOutputDirectory);
+   if (!outFile) {
+      R__LOG_ERROR(NTupleLog()) << "RNTuple merging requires the output to be the top-level directory of a TFile";
+      return -1;
+   }
+
+   TIter itr(inputs);
+   auto ntupleNameObj = dynamic_cast<TObjString *>(itr());
+   if (!ntupleNameObj)
+      return -1;
+   const std::string ntupleName = ntupleNameObj->GetString().Data();
+
+   try {
+      std::vector<std::unique_ptr<Detail::RPageSource>> sources;
+      std::vector<Detail::RPageSource *> sourcePtrs;
+      while (auto obj = itr()) {
+         auto inFile = dynamic_cast<TFile *>(obj);
+         if (!inFile)
+            return -1;
+         RNTupleReadOptions readOptions;
+         // The merger loads the clusters on its own, one at a time
+         readOptions.SetClusterCache(RNTupleReadOptions::EClusterCache::kOff);
+         sources.emplace_back(std::make_unique<Detail::RPageSourceFile>(ntupleName, inFile->GetName(), readOptions));
+         sources.back()->Attach();
+         sourcePtrs.emplace_back(sources.back().get());
+      }
+
+      RNTupleWriteOptions writeOptions;
+      writeOptions.SetCompression(outFile->GetCompressionSettings());
+      auto destination = std::make_unique<Detail::RPageSinkFile>(ntupleName, *outFile, writeOptions);
+
+      RNTupleMerger merger;
+      merger.Merge(sourcePtrs, *destination);
+      destination.reset();
+
+      // Update the anchor; the caller writes this object into the output directory
+      auto anchor = std::unique_ptr<RNTuple>(outFile->Get<RNTuple>(ntupleName.c_str()));
+      if (!anchor)
+         return -1;
+      *this = *anchor;
+   } catch (const RException &e) {
+      R__LOG_ERROR(NTupleLog()) << "cannot merge RNTuple " << ntupleName << ": " << e.what();
+      return -1;
+   }
+
+   return 0;
 }
 
 
@@ -34,6 +99,194 @@ ROOT::Experimental::RResult<ROOT::Experimental::RFieldMerger>
 ROOT::Experimental::RFieldMerger::Merge(const ROOT::Experimental::RFieldDescriptor &lhs,
    const ROOT::Experimental::RFieldDescriptor &rhs)
 {
-   return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " with field "
-      + rhs.GetFieldName() + " (unimplemented!)");
+   if (lhs.GetStructure() == ENTupleStructure::kInvalid || rhs.GetStructure() == ENTupleStructure::kInvalid)
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " with field " + rhs.GetFieldName() +
+                     " (invalid field)");
+   if (lhs.GetFieldName() != rhs.GetFieldName())
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " with field " + rhs.GetFieldName() +
+                     " (name mismatch)");
+   if (lhs.GetTypeName() != rhs.GetTypeName())
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " (type mismatch: " + lhs.GetTypeName() +
+                     " vs. " + rhs.GetTypeName() + ")");
+   if (lhs.GetStructure() != rhs.GetStructure())
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " (structure mismatch)");
+   if (lhs.GetNRepetitions() != rhs.GetNRepetitions())
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " (number of repetitions mismatch)");
+   if (lhs.GetLinkIds().size() != rhs.GetLinkIds().size())
+      return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " (number of sub fields mismatch)");
+
+   RFieldMerger merger;
+   merger.fMergedField = lhs.Clone();
+   return merger;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+ROOT::Experimental::RNTupleMerger::RNTupleMerger()
+   : fDecompressor(std::make_unique<Detail::RNTupleDecompressor>()),
+     fCompressor(std::make_unique<Detail::RNTupleCompressor>())
+{
+}
+
+ROOT::Experimental::RNTupleMerger::~RNTupleMerger() = default;
+
+void ROOT::Experimental::RNTupleMerger::CollectColumns(const RNTupleDescriptor &descriptor, DescriptorId_t fieldId,
+                                                       ColumnIdMap_t &columns)
+{
+   for (const auto &field : descriptor.GetFieldIterable(fieldId)) {
+      const auto fieldName = descriptor.GetQualifiedFieldName(field.GetId());
+      for (const auto &column : descriptor.GetColumnIterable(field)) {
+         columns[fieldName + "." + std::to_string(column.GetIndex())] = column.GetId();
+      }
+      CollectColumns(descriptor, field.GetId(), columns);
+   }
+}
+
+ROOT::Experimental::RResult<void>
+ROOT::Experimental::RNTupleMerger::MergeFieldTrees(const RNTupleDescriptor &lhs, DescriptorId_t lhsFieldId,
+                                                   const RNTupleDescriptor &rhs, DescriptorId_t rhsFieldId)
+{
+   for (const auto &lhsField : lhs.GetFieldIterable(lhsFieldId)) {
+      const auto rhsSubfieldId = rhs.FindFieldId(lhsField.GetFieldName(), rhsFieldId);
+      if (rhsSubfieldId == kInvalidDescriptorId)
+         return R__FAIL("field " + lhs.GetQualifiedFieldName(lhsField.GetId()) + " missing in merge input");
+      auto mergeResult = RFieldMerger::Merge(lhsField, rhs.GetFieldDescriptor(rhsSubfieldId));
+      if (!mergeResult)
+         return R__FORWARD_ERROR(mergeResult);
+      auto subfieldResult = MergeFieldTrees(lhs, lhsField.GetId(), rhs, rhsSubfieldId);
+      if (!subfieldResult)
+         return R__FORWARD_ERROR(subfieldResult);
+   }
+   return RResult<void>::Success();
+}
+
+ROOT::Experimental::RResult<std::vector<ROOT::Experimental::RNTupleMerger::RColumnInfo>>
+ROOT::Experimental::RNTupleMerger::MatchColumns(const RNTupleDescriptor &source, const RNTupleDescriptor &destination)
+{
+   ColumnIdMap_t sourceColumns;
+   ColumnIdMap_t destinationColumns;
+   CollectColumns(source, source.GetFieldZeroId(), sourceColumns);
+   CollectColumns(destination, destination.GetFieldZeroId(), destinationColumns);
+   if (sourceColumns.size() != destinationColumns.size())
+      return R__FAIL("number of columns mismatch");
+
+   std::vector<RColumnInfo> columns;
+   for (const auto &c : destinationColumns) {
+      auto itr = sourceColumns.find(c.first);
+      if (itr == sourceColumns.end())
+         return R__FAIL("column " + c.first + " missing in merge input");
+      const auto &sourceModel = source.GetColumnDescriptor(itr->second).GetModel();
+      const auto &destinationModel = destination.GetColumnDescriptor(c.second).GetModel();
+      if (!(sourceModel == destinationModel))
+         return R__FAIL("column " + c.first + " type mismatch");
+
+      RColumnInfo info;
+      info.fColumnName = c.first;
+      info.fColumnInputId = itr->second;
+      info.fColumnOutputId = c.second;
+      info.fColumnType = sourceModel.GetType();
+      columns.emplace_back(info);
+   }
+   // Commit the pages in the order of the destination columns
+   std::sort(columns.begin(), columns.end(),
+             [](const RColumnInfo &a, const RColumnInfo &b) { return a.fColumnOutputId < b.fColumnOutputId; });
+   return columns;
+}
+
+void ROOT::Experimental::RNTupleMerger::MergeSource(Detail::RPageSource &source,
+                                                    const std::vector<RColumnInfo> &columns,
+                                                    Detail::RPageSink &destination)
+{
+   const auto &descriptor = source.GetDescriptor();
+   const auto destinationCompression = destination.GetWriteOptions().GetCompression();
+
+   // Clusters are committed in entry order
+   std::vector<const RClusterDescriptor *> clusterDescriptors;
+   for (const auto &clusterDesc : descriptor.GetClusterIterable())
+      clusterDescriptors.emplace_back(&clusterDesc);
+   std::sort(clusterDescriptors.begin(), clusterDescriptors.end(),
+             [](const RClusterDescriptor *a, const RClusterDescriptor *b) {
+                return a->GetFirstEntryIndex() < b->GetFirstEntryIndex();
+             });
+
+   Detail::RCluster::ColumnSet_t columnSet;
+   std::vector<std::unique_ptr<Detail::RColumnElementBase>> elements;
+   for (const auto &column : columns) {
+      columnSet.insert(column.fColumnInputId);
+      elements.emplace_back(Detail::RColumnElementBase::Generate(column.fColumnType));
+   }
+
+   std::vector<unsigned char> packedBuffer;
+   for (const auto clusterDesc : clusterDescriptors) {
+      std::size_t nPages = 0;
+      for (const auto &column : columns)
+         nPages += clusterDesc->GetPageRange(column.fColumnInputId).fPageInfos.size();
+
+      // Read all the pages of the cluster in a single vector read
+      std::unique_ptr<Detail::RCluster> cluster;
+      if (nPages > 0) {
+         Detail::RCluster::RKey clusterKey{clusterDesc->GetId(), columnSet};
+         auto clusters = source.LoadClusters(std::span<Detail::RCluster::RKey>(&clusterKey, 1));
+         cluster = std::move(clusters[0]);
+      }
+
+      for (std::size_t i = 0; i < columns.size(); ++i) {
+         const auto &column = columns[i];
+         const auto &columnRange = clusterDesc->GetColumnRange(column.fColumnInputId);
+         const bool needsRecompression = columnRange.fCompressionSettings != destinationCompression;
+
+         std::uint64_t pageNo = 0;
+         for (const auto &pageInfo : clusterDesc->GetPageRange(column.fColumnInputId).fPageInfos) {
+            auto onDiskPage = cluster->GetOnDiskPage(Detail::ROnDiskPage::Key{column.fColumnInputId, pageNo});
+            R__ASSERT(onDiskPage && (onDiskPage->GetSize() == pageInfo.fLocator.fBytesOnStorage));
+            Detail::RPageStorage::RSealedPage sealedPage{onDiskPage->GetAddress(), onDiskPage->GetSize(),
+                                                         pageInfo.fNElements};
+
+            if (needsRecompression) {
+               const auto bytesPacked = elements[i]->GetPackedSize(pageInfo.fNElements);
+               if (packedBuffer.size() < bytesPacked)
+                  packedBuffer.resize(bytesPacked);
+               fDecompressor->Unzip(sealedPage.fBuffer, sealedPage.fSize, bytesPacked, packedBuffer.data());
+               sealedPage.fSize = fCompressor->Zip(packedBuffer.data(), bytesPacked, destinationCompression);
+               sealedPage.fBuffer = fCompressor->GetZipBuffer();
+            }
+
+            destination.CommitSealedPage(column.fColumnOutputId, sealedPage);
+            ++pageNo;
+         }
+      }
+
+      fNEntries += clusterDesc->GetNEntries();
+      destination.CommitCluster(fNEntries);
+   }
+}
+
+void ROOT::Experimental::RNTupleMerger::Merge(std::span<Detail::RPageSource *> sources,
+                                              Detail::RPageSink &destination)
+{
+   if (sources.empty())
+      throw RException(R__FAIL("no sources to merge"));
+
+   // Verify the schema compatibility before anything is written to the destination
+   const auto &firstDescriptor = sources[0]->GetDescriptor();
+   for (std::size_t i = 1; i < sources.size(); ++i) {
+      const auto &descriptor = sources[i]->GetDescriptor();
+      MergeFieldTrees(firstDescriptor, firstDescriptor.GetFieldZeroId(), descriptor, descriptor.GetFieldZeroId())
+         .ThrowOnError();
+      MergeFieldTrees(descriptor, descriptor.GetFieldZeroId(), firstDescriptor, firstDescriptor.GetFieldZeroId())
+         .ThrowOnError();
+   }
+
+   auto model = firstDescriptor.GenerateModel();
+   destination.Create(*model);
+
+   fNEntries = 0;
+   for (auto source : sources) {
+      auto columns = MatchColumns(source->GetDescriptor(), destination.GetDescriptor()).Unwrap();
+      MergeSource(*source, columns, destination);
+   }
+
+   destination.CommitDataset();
 }
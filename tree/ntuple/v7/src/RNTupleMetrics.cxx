@@ -15,10 +15,56 @@
 
 #include <ROOT/RNTupleMetrics.hxx>
 
+#include <cctype>
+#include <iomanip>
 #include <ostream>
 
 #include <iostream>
 
+namespace {
+
+std::string EscapeJSON(const std::string &str)
+{
+   std::string result;
+   for (auto c : str) {
+      if (c == '"' || c == '\\')
+         result += '\\';
+      result += c;
+   }
+   return result;
+}
+
+/// Counter values are either integers or fixed notation floating point numbers; only NaN and infinity contain an `n`
+std::string ValueToJSON(const std::string &value)
+{
+   if (value.find('n') != std::string::npos)
+      return "null";
+   return value;
+}
+
+std::string ToPrometheusName(const std::string &name)
+{
+   std::string result = name;
+   for (auto &c : result) {
+      if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != ':')
+         c = '_';
+   }
+   return result;
+}
+
+const char *GetEventName(ROOT::Experimental::Detail::RNTupleTimeline::EEventType type)
+{
+   using EEventType = ROOT::Experimental::Detail::RNTupleTimeline::EEventType;
+   switch (type) {
+   case EEventType::kRead: return "read";
+   case EEventType::kUnzip: return "unzip";
+   case EEventType::kConsume: return "consume";
+   }
+   return "";
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RNTuplePerfCounter::~RNTuplePerfCounter()
 {
 }
@@ -78,6 +124,47 @@ void ROOT::Experimental::Detail::RNTupleMetrics::Print(std::ostream &output, con
    }
 }
 
+void ROOT::Experimental::Detail::RNTupleMetrics::PrintJSON(std::ostream &output) const
+{
+   output << "{\"name\": \"" << EscapeJSON(fName) << "\", \"enabled\": " << (fIsEnabled ? "true" : "false");
+   if (fIsEnabled) {
+      output << ", \"counters\": [";
+      for (std::size_t i = 0; i < fCounters.size(); ++i) {
+         const auto &c = fCounters[i];
+         output << (i > 0 ? ", " : "") << "{\"name\": \"" << EscapeJSON(c->GetName()) << "\", \"unit\": \""
+                << EscapeJSON(c->GetUnit()) << "\", \"description\": \"" << EscapeJSON(c->GetDescription())
+                << "\", \"value\": " << ValueToJSON(c->GetValueAsString()) << "}";
+      }
+      output << "]";
+   }
+   output << ", \"metrics\": [";
+   for (std::size_t i = 0; i < fObservedMetrics.size(); ++i) {
+      if (i > 0)
+         output << ", ";
+      fObservedMetrics[i]->PrintJSON(output);
+   }
+   output << "]}";
+}
+
+void ROOT::Experimental::Detail::RNTupleMetrics::PrintPrometheus(std::ostream &output, const std::string &prefix) const
+{
+   if (!fIsEnabled)
+      return;
+
+   for (const auto &c : fCounters) {
+      auto name = ToPrometheusName(prefix + fName + kNamespaceSeperator + c->GetName());
+      output << "# HELP " << name << " " << c->GetDescription();
+      if (!c->GetUnit().empty())
+         output << " [" << c->GetUnit() << "]";
+      output << "\n# TYPE " << name << " gauge\n";
+      auto value = c->GetValueAsString();
+      output << name << " " << (value.find('n') != std::string::npos ? "NaN" : value) << "\n";
+   }
+   for (const auto c : fObservedMetrics) {
+      c->PrintPrometheus(output, prefix + fName + kNamespaceSeperator);
+   }
+}
+
 void ROOT::Experimental::Detail::RNTupleMetrics::Enable()
 {
    for (auto &c: fCounters)
@@ -91,3 +178,59 @@ void ROOT::Experimental::Detail::RNTupleMetrics::ObserveMetrics(RNTupleMetrics &
 {
    fObservedMetrics.push_back(&observee);
 }
+
+void ROOT::Experimental::Detail::RNTupleTimeline::AddEvent(EEventType type, std::uint64_t clusterId,
+                                                           Clock_t::time_point start, Clock_t::time_point end)
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   fEvents.push_back({type, clusterId, ToNs(start), ToNs(end)});
+}
+
+void ROOT::Experimental::Detail::RNTupleTimeline::MarkConsumed(std::uint64_t clusterId)
+{
+   const auto now = ToNs(Clock_t::now());
+   std::lock_guard<std::mutex> guard(fLock);
+   if (fConsumeEvent.fClusterId == clusterId) {
+      fConsumeEvent.fEndNs = now;
+      return;
+   }
+   if (fConsumeEvent.fClusterId != kInvalidClusterId)
+      fEvents.push_back(fConsumeEvent);
+   fConsumeEvent.fClusterId = clusterId;
+   fConsumeEvent.fStartNs = now;
+   fConsumeEvent.fEndNs = now;
+}
+
+std::vector<ROOT::Experimental::Detail::RNTupleTimeline::REvent>
+ROOT::Experimental::Detail::RNTupleTimeline::GetEvents() const
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   auto result = fEvents;
+   if (fConsumeEvent.fClusterId != kInvalidClusterId)
+      result.push_back(fConsumeEvent);
+   return result;
+}
+
+void ROOT::Experimental::Detail::RNTupleTimeline::PrintJSON(std::ostream &output) const
+{
+   // Complete events ("ph": "X") with timestamps in microseconds; every event type gets its own row.
+   // The timestamps are written with all their digits, down to the nanosecond.
+   const auto fill = output.fill('0');
+   auto printMicroseconds = [&output](std::int64_t ns) {
+      output << ns / 1000 << '.' << std::setw(3) << ns % 1000;
+   };
+   output << "{\"traceEvents\": [";
+   bool isFirst = true;
+   for (const auto &e : GetEvents()) {
+      output << (isFirst ? "" : ", ") << "{\"name\": \"cluster " << e.fClusterId << "\", \"cat\": \""
+             << GetEventName(e.fType) << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << static_cast<int>(e.fType)
+             << ", \"ts\": ";
+      printMicroseconds(e.fStartNs);
+      output << ", \"dur\": ";
+      printMicroseconds(e.fEndNs - e.fStartNs);
+      output << "}";
+      isFirst = false;
+   }
+   output << "]}";
+   output.fill(fill);
+}
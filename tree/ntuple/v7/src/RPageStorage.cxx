@@ -74,6 +74,13 @@ std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Det
    return std::make_unique<RPageSourceFile>(ntupleName, location, options);
 }
 
+void ROOT::Experimental::Detail::RPageSource::Attach()
+{
+   fDescriptor = AttachImpl();
+   if (fOptions.GetDetailedMetrics() && fCounters)
+      EnableDetailedMetrics();
+}
+
 ROOT::Experimental::Detail::RPageStorage::ColumnHandle_t
 ROOT::Experimental::Detail::RPageSource::AddColumn(DescriptorId_t fieldId, const RColumn &column)
 {
@@ -89,6 +96,15 @@ void ROOT::Experimental::Detail::RPageSource::DropColumn(ColumnHandle_t columnHa
    fActiveColumns.erase(columnHandle.fId);
 }
 
+ROOT::Experimental::Detail::RCluster::ColumnSet_t ROOT::Experimental::Detail::RPageSource::GetRequestedColumns() const
+{
+   if (fExpectedColumns.empty())
+      return fActiveColumns;
+   auto result = fActiveColumns;
+   result.insert(fExpectedColumns.begin(), fExpectedColumns.end());
+   return result;
+}
+
 ROOT::Experimental::NTupleSize_t ROOT::Experimental::Detail::RPageSource::GetNEntries()
 {
    return fDescriptor.GetNEntries();
@@ -228,6 +244,49 @@ void ROOT::Experimental::Detail::RPageSource::EnableDefaultMetrics(const std::st
          }
       )
    });
+   fDisabledColumnCounters = std::make_unique<RColumnCounters>("");
+}
+
+ROOT::Experimental::Detail::RPageSource::RColumnCounters::RColumnCounters(const std::string &name)
+   : fMetrics(name),
+     fNPageLoaded(*fMetrics.MakeCounter<RNTupleAtomicCounter *>("nPageLoaded", "", "number of pages loaded")),
+     fSzReadPayload(
+        *fMetrics.MakeCounter<RNTupleAtomicCounter *>("szReadPayload", "B", "volume read from storage")),
+     fSzUnzip(*fMetrics.MakeCounter<RNTupleAtomicCounter *>("szUnzip", "B", "volume after unzipping")),
+     fTimeWallUnzip(
+        *fMetrics.MakeCounter<RNTupleAtomicCounter *>("timeWallUnzip", "ns", "wall clock time spent decompressing")),
+     fTimeCpuUnzip(*fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter> *>("timeCpuUnzip", "ns",
+                                                                                     "CPU time spent decompressing")),
+     fCompressionRatio(*fMetrics.MakeCounter<RNTupleCalcPerf *>(
+        "rtCompression", "", "ratio of compressed bytes / uncompressed bytes", fMetrics,
+        [](const RNTupleMetrics &metrics) -> std::pair<bool, double> {
+           if (const auto szReadPayload = metrics.GetLocalCounter("szReadPayload")) {
+              if (const auto szUnzip = metrics.GetLocalCounter("szUnzip")) {
+                 if (auto unzip = szUnzip->GetValueAsInt()) {
+                    return {true, (1. * szReadPayload->GetValueAsInt()) / unzip};
+                 }
+              }
+           }
+           return {false, -1.};
+        }))
+{
+}
+
+void ROOT::Experimental::Detail::RPageSource::EnableDetailedMetrics()
+{
+   // The column counters are observed by fMetrics and therefore must not be replaced
+   if (fTimeline)
+      return;
+
+   const auto nColumns = fDescriptor.GetNColumns();
+   fColumnCounters.reserve(nColumns);
+   for (std::size_t i = 0; i < nColumns; ++i) {
+      fColumnCounters.emplace_back(std::make_unique<RColumnCounters>("column" + std::to_string(i)));
+      fMetrics.ObserveMetrics(fColumnCounters.back()->fMetrics);
+   }
+   fTimeline = std::make_unique<RNTupleTimeline>();
+   if (fMetrics.IsEnabled())
+      fMetrics.Enable();
 }
 
 
@@ -326,6 +326,10 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto elementSize = element->GetSize();
    const auto bytesOnStorage = pageInfo.fLocator.fBytesOnStorage;
 
+   auto &columnCounters = GetColumnCounters(columnId);
+   if (auto timeline = GetActiveTimeline())
+      timeline->MarkConsumed(clusterId);
+
    const void *sealedPageBuffer = nullptr; // points either to directReadBuffer or to a read-only page in the cluster
    std::unique_ptr<unsigned char []> directReadBuffer; // only used if cluster pool is turned off
 
@@ -335,10 +339,12 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       fCounters->fNPageLoaded.Inc();
       fCounters->fNRead.Inc();
       fCounters->fSzReadPayload.Add(bytesOnStorage);
+      columnCounters.fNPageLoaded.Inc();
+      columnCounters.fSzReadPayload.Add(bytesOnStorage);
       sealedPageBuffer = directReadBuffer.get();
    } else {
       if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
-         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActiveColumns);
+         fCurrentCluster = fClusterPool->GetCluster(clusterId, GetRequestedColumns());
       R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
 
       auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, idxInCluster));
@@ -354,8 +360,10 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    std::unique_ptr<unsigned char []> pageBuffer;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+      RNTupleAtomicTimer columnTimer(columnCounters.fTimeWallUnzip, columnCounters.fTimeCpuUnzip);
       pageBuffer = UnsealPage({sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element);
       fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
+      columnCounters.fSzUnzip.Add(elementSize * pageInfo.fNElements);
    }
 
    const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
@@ -376,8 +384,11 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
 {
    const auto columnId = columnHandle.fId;
    auto cachedPage = fPagePool->GetPage(columnId, globalIndex);
-   if (!cachedPage.IsNull())
+   if (!cachedPage.IsNull()) {
+      if (auto timeline = GetActiveTimeline())
+         timeline->MarkConsumed(cachedPage.GetClusterInfo().GetId());
       return cachedPage;
+   }
 
    const auto clusterId = fDescriptor.FindClusterId(columnId, globalIndex);
    R__ASSERT(clusterId != kInvalidDescriptorId);
@@ -395,8 +406,11 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto idxInCluster = clusterIndex.GetIndex();
    const auto columnId = columnHandle.fId;
    auto cachedPage = fPagePool->GetPage(columnId, clusterIndex);
-   if (!cachedPage.IsNull())
+   if (!cachedPage.IsNull()) {
+      if (auto timeline = GetActiveTimeline())
+         timeline->MarkConsumed(clusterId);
       return cachedPage;
+   }
 
    R__ASSERT(clusterId != kInvalidDescriptorId);
    const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
@@ -433,7 +447,7 @@ ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
 
    // Collect the page necessary page meta-data and sum up the total size of the compressed and packed pages
    std::vector<ROnDiskPageLocator> onDiskPages;
-   auto activeSize = 0;
+   std::uint64_t activeSize = 0;
    for (auto columnId : clusterKey.fColumnSet) {
       const auto &pageRange = clusterDesc.GetPageRange(columnId);
       NTupleSize_t pageNo = 0;
@@ -457,23 +471,27 @@ ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
    // of extra bytes.
    // TODO(jblomer): Eventually we may want to select the parameter at runtime according to link latency and speed,
    // memory consumption, device block size.
-   float maxOverhead = 0.25 * float(activeSize);
-   std::vector<std::size_t> gaps;
-   for (unsigned i = 1; i < onDiskPages.size(); ++i) {
-      gaps.emplace_back(onDiskPages[i].fOffset - (onDiskPages[i-1].fSize + onDiskPages[i-1].fOffset));
-   }
-   std::sort(gaps.begin(), gaps.end());
-   std::size_t gapCut = 0;
-   std::size_t currentGap = 0;
-   float szExtra = 0.0;
-   for (auto g : gaps) {
-      if (g != currentGap) {
-         gapCut = currentGap;
-         currentGap = g;
+   // The gap can also be fixed by the read options, e.g. according to the block size of the storage device.
+   std::size_t gapCut = fOptions.GetCoalescingGap();
+   if (gapCut == RNTupleReadOptions::kCoalescingGapAuto) {
+      float maxOverhead = 0.25 * float(activeSize);
+      std::vector<std::size_t> gaps;
+      for (unsigned i = 1; i < onDiskPages.size(); ++i) {
+         gaps.emplace_back(onDiskPages[i].fOffset - (onDiskPages[i-1].fSize + onDiskPages[i-1].fOffset));
+      }
+      std::sort(gaps.begin(), gaps.end());
+      gapCut = 0;
+      std::size_t currentGap = 0;
+      float szExtra = 0.0;
+      for (auto g : gaps) {
+         if (g != currentGap) {
+            gapCut = currentGap;
+            currentGap = g;
+         }
+         szExtra += g;
+         if (szExtra  > maxOverhead)
+            break;
       }
-      szExtra += g;
-      if (szExtra  > maxOverhead)
-         break;
    }
 
    // In a first step, we coalesce the read requests and calculate the cluster buffer size.
@@ -491,7 +509,7 @@ ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
       R__ASSERT(s.fOffset >= readUpTo);
       auto overhead = s.fOffset - readUpTo;
       szPayload += s.fSize;
-      if (overhead <= gapCut) {
+      if ((req.fSize > 0) && (overhead <= gapCut)) {
          szOverhead += overhead;
          s.fBufPos = reinterpret_cast<intptr_t>(req.fBuffer) + req.fSize + overhead;
          req.fSize += overhead + s.fSize;
@@ -518,6 +536,9 @@ ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
    for (const auto &s : onDiskPages) {
       ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
       pageMap->Register(key, ROnDiskPage(buffer + s.fBufPos, s.fSize));
+      auto &columnCounters = GetColumnCounters(s.fColumnId);
+      columnCounters.fNPageLoaded.Inc();
+      columnCounters.fSzReadPayload.Add(s.fSize);
    }
    fCounters->fNPageLoaded.Add(onDiskPages.size());
    for (auto i = currentReadRequestIdx; i < readRequests.size(); ++i) {
@@ -544,10 +565,16 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadClusters(std::span<RCluster::RK
    }
 
    auto nReqs = readRequests.size();
+   const auto readStart = RNTupleTimeline::Clock_t::now();
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
       fFile->ReadV(&readRequests[0], nReqs);
    }
+   if (auto timeline = GetActiveTimeline()) {
+      const auto readEnd = RNTupleTimeline::Clock_t::now();
+      for (const auto &key : clusterKeys)
+         timeline->AddEvent(RNTupleTimeline::EEventType::kRead, key.fClusterId, readStart, readEnd);
+   }
    fCounters->fNReadV.Inc();
    fCounters->fNRead.Add(nReqs);
 
@@ -558,6 +585,7 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadClusters(std::span<RCluster::RK
 void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *cluster)
 {
    RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+   const auto unzipStart = RNTupleTimeline::Clock_t::now();
    fTaskScheduler->Reset();
 
    const auto clusterId = cluster->GetId();
@@ -581,12 +609,18 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
 
          auto taskFunc =
             [this, columnId, clusterId, firstInPage, onDiskPage,
+             &columnCounters = GetColumnCounters(columnId),
              element = allElements.back().get(),
              nElements = pi.fNElements,
              indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex
             ] () {
-               auto pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
+               std::unique_ptr<unsigned char []> pageBuffer;
+               {
+                  RNTupleAtomicTimer columnTimer(columnCounters.fTimeWallUnzip, columnCounters.fTimeCpuUnzip);
+                  pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
+               }
                fCounters->fSzUnzip.Add(element->GetSize() * nElements);
+               columnCounters.fSzUnzip.Add(element->GetSize() * nElements);
 
                auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), element->GetSize(), nElements);
                newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
@@ -607,4 +641,7 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
    fCounters->fNPagePopulated.Add(cluster->GetNOnDiskPages());
 
    fTaskScheduler->Wait();
+
+   if (auto timeline = GetActiveTimeline())
+      timeline->AddEvent(RNTupleTimeline::EEventType::kUnzip, clusterId, unzipStart, RNTupleTimeline::Clock_t::now());
 }
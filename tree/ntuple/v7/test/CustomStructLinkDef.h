@@ -16,4 +16,13 @@
 
 #pragma link C++ class ComplexStruct+;
 
+#pragma link C++ class std::pair<std::int64_t, float>+;
+#pragma link C++ class std::pair<double, std::string>+;
+#pragma link C++ class std::set<std::int64_t>+;
+#pragma link C++ class std::set<float>+;
+#pragma link C++ class std::unordered_set<std::string>+;
+#pragma link C++ class std::map<std::int64_t, float>+;
+#pragma link C++ class std::map<std::string, float>+;
+#pragma link C++ class std::unordered_map<std::int32_t, std::vector<float>>+;
+
 #endif
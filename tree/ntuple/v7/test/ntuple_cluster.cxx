@@ -332,3 +332,65 @@ TEST(PageStorageFile, LoadClusters)
    EXPECT_EQ(1U, clusters[1]->GetId());
    EXPECT_EQ(1U, clusters[1]->GetNOnDiskPages());
 }
+
+TEST(PageStorageFile, CoalescingGap)
+{
+   FileRaii fileGuard("test_pagestoragefile_coalescinggap.root");
+
+   {
+      auto model = ROOT::Experimental::RNTupleModel::Create();
+      *model->MakeField<float>("pt") = 1.0;
+      *model->MakeField<float>("eta") = 2.0;
+      *model->MakeField<float>("phi") = 3.0;
+      auto ntuple = ROOT::Experimental::RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      ntuple->Fill();
+   }
+
+   for (auto gap : {std::size_t(0), std::size_t(1024 * 1024)}) {
+      ROOT::Experimental::RNTupleReadOptions options;
+      options.SetCoalescingGap(gap);
+      ROOT::Experimental::Detail::RPageSourceFile source("myNTuple", fileGuard.GetPath(), options);
+      source.Attach();
+      source.GetMetrics().Enable();
+      const auto &desc = source.GetDescriptor();
+
+      // The pages of "pt" and "phi" are separated on disk by the page of "eta"
+      std::vector<ROOT::Experimental::Detail::RCluster::RKey> clusterKeys;
+      clusterKeys.push_back({0, {desc.FindColumnId(desc.FindFieldId("pt"), 0),
+                                 desc.FindColumnId(desc.FindFieldId("phi"), 0)}});
+      auto cluster = std::move(source.LoadClusters(clusterKeys)[0]);
+      EXPECT_EQ(2U, cluster->GetNOnDiskPages());
+      auto nRead = source.GetMetrics().GetCounter("RPageSourceFile.nRead")->GetValueAsInt();
+      EXPECT_EQ((gap == 0) ? 2 : 1, nRead);
+   }
+}
+
+TEST(PageStorageFile, ExpectedColumns)
+{
+   FileRaii fileGuard("test_pagestoragefile_expectedcolumns.root");
+
+   {
+      auto model = ROOT::Experimental::RNTupleModel::Create();
+      *model->MakeField<float>("pt") = 1.0;
+      *model->MakeField<float>("eta") = 2.0;
+      *model->MakeField<float>("phi") = 3.0;
+      auto ntuple = ROOT::Experimental::RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      ntuple->Fill();
+   }
+
+   ROOT::Experimental::Detail::RPageSourceFile source("myNTuple", fileGuard.GetPath(),
+                                                      ROOT::Experimental::RNTupleReadOptions());
+   source.Attach();
+   source.GetMetrics().Enable();
+   const auto &desc = source.GetDescriptor();
+   auto ptId = desc.FindFieldId("pt");
+   source.SetExpectedColumns({desc.FindColumnId(ptId, 0), desc.FindColumnId(desc.FindFieldId("eta"), 0)});
+
+   auto column = std::unique_ptr<ROOT::Experimental::Detail::RColumn>(
+      ROOT::Experimental::Detail::RColumn::Create<float, ROOT::Experimental::EColumnType::kReal32>(
+         ROOT::Experimental::RColumnModel(ROOT::Experimental::EColumnType::kReal32, false), 0));
+   column->Connect(ptId, &source);
+   EXPECT_EQ(1.0, *column->Map<float>(0));
+   // The "eta" page is loaded together with the "pt" page but "phi" is not read
+   EXPECT_EQ(2, source.GetMetrics().GetCounter("RPageSourceFile.nPageLoaded")->GetValueAsInt());
+}
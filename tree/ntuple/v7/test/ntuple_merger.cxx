@@ -1,5 +1,9 @@
 #include "ntuple_test.hxx"
 
+#include <TFileMergeInfo.h>
+#include <TList.h>
+#include <TObjString.h>
+
 namespace {
 
 // Reads an integer from a little-endian 4 byte buffer
@@ -79,4 +83,165 @@ TEST(RFieldMerger, Merge)
 {
    auto mergeResult = RFieldMerger::Merge(RFieldDescriptor(), RFieldDescriptor());
    EXPECT_FALSE(mergeResult);
+
+   auto fieldFloat = RFieldDescriptorBuilder()
+      .FieldId(1)
+      .FieldName("pt")
+      .TypeName("float")
+      .Structure(ENTupleStructure::kLeaf)
+      .MakeDescriptor()
+      .Unwrap();
+   auto fieldDouble = RFieldDescriptorBuilder()
+      .FieldId(2)
+      .FieldName("pt")
+      .TypeName("double")
+      .Structure(ENTupleStructure::kLeaf)
+      .MakeDescriptor()
+      .Unwrap();
+   auto mergeSame = RFieldMerger::Merge(fieldFloat, fieldFloat);
+   EXPECT_TRUE(static_cast<bool>(mergeSame));
+   auto mergeDifferent = RFieldMerger::Merge(fieldFloat, fieldDouble);
+   EXPECT_FALSE(mergeDifferent);
+}
+
+TEST(RNTupleMerger, MergeSymmetric)
+{
+   FileRaii fileGuard1("test_ntuple_merge_in_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_in_2.root");
+   FileRaii fileGuard3("test_ntuple_merge_out.root");
+
+   // The two inputs have the same schema but the fields are created in different order
+   {
+      auto model = RNTupleModel::Create();
+      auto fieldPt = model->MakeField<float>("pt");
+      auto fieldJets = model->MakeField<std::vector<float>>("jets");
+      RNTupleWriteOptions options;
+      options.SetCompression(505);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard1.GetPath(), options);
+      for (int i = 0; i < 10; ++i) {
+         *fieldPt = i;
+         *fieldJets = std::vector<float>(i, float(i));
+         ntuple->Fill();
+         if (i == 4)
+            ntuple->CommitCluster();
+      }
+   }
+   {
+      auto model = RNTupleModel::Create();
+      auto fieldJets = model->MakeField<std::vector<float>>("jets");
+      auto fieldPt = model->MakeField<float>("pt");
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard2.GetPath(), options);
+      for (int i = 10; i < 15; ++i) {
+         *fieldPt = i;
+         *fieldJets = std::vector<float>(i, float(i));
+         ntuple->Fill();
+      }
+   }
+
+   {
+      std::vector<std::unique_ptr<RPageSource>> sources;
+      sources.push_back(RPageSource::Create("ntuple", fileGuard1.GetPath()));
+      sources.push_back(RPageSource::Create("ntuple", fileGuard2.GetPath()));
+      std::vector<RPageSource *> sourcePtrs;
+      for (const auto &s : sources) {
+         s->Attach();
+         sourcePtrs.push_back(s.get());
+      }
+
+      // The pages of the first input are copied verbatim, the ones of the second input are recompressed
+      RNTupleWriteOptions options;
+      options.SetCompression(505);
+      auto destination = std::make_unique<RPageSinkFile>("ntuple", fileGuard3.GetPath(), options);
+      RNTupleMerger merger;
+      merger.Merge(sourcePtrs, *destination);
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard3.GetPath());
+   EXPECT_EQ(15U, ntuple->GetNEntries());
+   EXPECT_EQ(3U, ntuple->GetDescriptor().GetNClusters());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(float(i), viewPt(i));
+      EXPECT_EQ(std::vector<float>(i, float(i)), viewJets(i));
+   }
+}
+
+TEST(RNTupleMerger, MergeIncompatible)
+{
+   FileRaii fileGuard1("test_ntuple_merge_incompatible_in_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_incompatible_in_2.root");
+   FileRaii fileGuard3("test_ntuple_merge_incompatible_out.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto fieldPt = model->MakeField<float>("pt", 1.0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard1.GetPath());
+      ntuple->Fill();
+   }
+   {
+      auto model = RNTupleModel::Create();
+      auto fieldPt = model->MakeField<double>("pt", 1.0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard2.GetPath());
+      ntuple->Fill();
+   }
+
+   std::vector<std::unique_ptr<RPageSource>> sources;
+   sources.push_back(RPageSource::Create("ntuple", fileGuard1.GetPath()));
+   sources.push_back(RPageSource::Create("ntuple", fileGuard2.GetPath()));
+   std::vector<RPageSource *> sourcePtrs;
+   for (const auto &s : sources) {
+      s->Attach();
+      sourcePtrs.push_back(s.get());
+   }
+
+   auto destination = std::make_unique<RPageSinkFile>("ntuple", fileGuard3.GetPath(), RNTupleWriteOptions());
+   RNTupleMerger merger;
+   try {
+      merger.Merge(sourcePtrs, *destination);
+      FAIL() << "merging fields of different types should throw";
+   } catch (const RException &err) {
+      EXPECT_THAT(err.what(), testing::HasSubstr("type mismatch"));
+   }
+}
+
+TEST(RNTupleMerger, MergeHadd)
+{
+   FileRaii fileGuard1("test_ntuple_merge_hadd_in_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_hadd_in_2.root");
+   FileRaii fileGuard3("test_ntuple_merge_hadd_out.root");
+
+   for (const auto &path : {fileGuard1.GetPath(), fileGuard2.GetPath()}) {
+      auto model = RNTupleModel::Create();
+      auto fieldPt = model->MakeField<float>("pt", 42.0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", path);
+      ntuple->Fill();
+      ntuple->Fill();
+   }
+
+   {
+      auto file1 = std::unique_ptr<TFile>(TFile::Open(fileGuard1.GetPath().c_str()));
+      auto file2 = std::unique_ptr<TFile>(TFile::Open(fileGuard2.GetPath().c_str()));
+      auto outFile = std::unique_ptr<TFile>(TFile::Open(fileGuard3.GetPath().c_str(), "RECREATE"));
+      TFileMergeInfo info(outFile.get());
+      TObjString name("ntuple");
+      TList inputs;
+      inputs.Add(&name);
+      inputs.Add(file1.get());
+      inputs.Add(file2.get());
+
+      auto anchor = std::unique_ptr<RNTuple>(file1->Get<RNTuple>("ntuple"));
+      ASSERT_TRUE(anchor);
+      EXPECT_EQ(0, anchor->Merge(&inputs, &info));
+      inputs.Clear();
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard3.GetPath());
+   EXPECT_EQ(4U, ntuple->GetNEntries());
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(42.0, viewPt(i));
+   }
 }
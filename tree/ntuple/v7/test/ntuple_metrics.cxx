@@ -1,6 +1,7 @@
 #include "ntuple_test.hxx"
 
 #include <cmath>
+#include <iomanip>
 
 TEST(Metrics, Counters)
 {
@@ -112,3 +113,120 @@ TEST(Metrics, RNTupleWriter)
    // one page for the int field, one for the float field
    EXPECT_EQ(2, page_counter->GetValueAsInt());
 }
+
+TEST(Metrics, Export)
+{
+   RNTupleMetrics inner("inner");
+   auto ctr = inner.MakeCounter<RNTuplePlainCounter *>("plain", "B", "example \"1\"");
+   inner.MakeCounter<RNTupleCalcPerf *>("calc", "", "always NaN", inner,
+                                        [](const RNTupleMetrics &) -> std::pair<bool, double> {
+                                           return {false, 0.};
+                                        });
+   RNTupleMetrics outer("outer");
+   outer.ObserveMetrics(inner);
+
+   std::ostringstream osDisabled;
+   outer.PrintJSON(osDisabled);
+   EXPECT_EQ("{\"name\": \"outer\", \"enabled\": false, \"metrics\": [{\"name\": \"inner\", \"enabled\": false, "
+             "\"metrics\": []}]}",
+             osDisabled.str());
+   std::ostringstream osPrometheusDisabled;
+   outer.PrintPrometheus(osPrometheusDisabled);
+   EXPECT_TRUE(osPrometheusDisabled.str().empty());
+
+   outer.Enable();
+   ctr->SetValue(42);
+
+   std::ostringstream osJSON;
+   outer.PrintJSON(osJSON);
+   EXPECT_EQ("{\"name\": \"outer\", \"enabled\": true, \"counters\": [], \"metrics\": [{\"name\": \"inner\", "
+             "\"enabled\": true, \"counters\": [{\"name\": \"plain\", \"unit\": \"B\", \"description\": "
+             "\"example \\\"1\\\"\", \"value\": 42}, {\"name\": \"calc\", \"unit\": \"\", \"description\": "
+             "\"always NaN\", \"value\": null}], \"metrics\": []}]}",
+             osJSON.str());
+
+   std::ostringstream osPrometheus;
+   outer.PrintPrometheus(osPrometheus);
+   EXPECT_NE(std::string::npos, osPrometheus.str().find("# TYPE outer_inner_plain gauge\nouter_inner_plain 42\n"));
+   EXPECT_NE(std::string::npos, osPrometheus.str().find("\nouter_inner_calc NaN\n"));
+}
+
+TEST(Metrics, RNTupleReaderDetailed)
+{
+   FileRaii fileGuard("test_ntuple_reader_metrics_detailed.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldPt = model->MakeField<float>("pt");
+      auto fldE = model->MakeField<double>("E");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 10; ++i) {
+         *fldPt = i;
+         *fldE = 2 * i;
+         ntuple->Fill();
+         if (i == 4)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntupleDefault = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   EXPECT_EQ(nullptr, ntupleDefault->GetTimeline());
+   EXPECT_EQ(nullptr, ntupleDefault->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.column0.nPageLoaded"));
+
+   RNTupleReadOptions options;
+   options.SetDetailedMetrics(true);
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   ntuple->EnableMetrics();
+   ASSERT_NE(nullptr, ntuple->GetTimeline());
+
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+
+   const auto &desc = ntuple->GetDescriptor();
+   const auto columnIdPt = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   const auto columnIdE = desc.FindColumnId(desc.FindFieldId("E"), 0);
+   const std::string prefix = "RNTupleReader.RPageSourceFile.column";
+   auto ctrPagesPt = ntuple->GetMetrics().GetCounter(prefix + std::to_string(columnIdPt) + ".nPageLoaded");
+   auto ctrPagesE = ntuple->GetMetrics().GetCounter(prefix + std::to_string(columnIdE) + ".nPageLoaded");
+   auto ctrUnzipPt = ntuple->GetMetrics().GetCounter(prefix + std::to_string(columnIdPt) + ".szUnzip");
+   ASSERT_NE(nullptr, ctrPagesPt);
+   ASSERT_NE(nullptr, ctrPagesE);
+   ASSERT_NE(nullptr, ctrUnzipPt);
+   // One page per cluster for the pt column, the E column is never read
+   EXPECT_EQ(2, ctrPagesPt->GetValueAsInt());
+   EXPECT_EQ(0, ctrPagesE->GetValueAsInt());
+   EXPECT_EQ(static_cast<std::int64_t>(10 * sizeof(float)), ctrUnzipPt->GetValueAsInt());
+
+   unsigned int nRead = 0;
+   unsigned int nConsume = 0;
+   for (const auto &e : ntuple->GetTimeline()->GetEvents()) {
+      EXPECT_LE(e.fStartNs, e.fEndNs);
+      if (e.fType == RNTupleTimeline::EEventType::kRead)
+         nRead++;
+      if (e.fType == RNTupleTimeline::EEventType::kConsume)
+         nConsume++;
+   }
+   EXPECT_EQ(2U, nRead);
+   EXPECT_EQ(2U, nConsume);
+
+   std::ostringstream osTrace;
+   ntuple->GetTimeline()->PrintJSON(osTrace);
+   EXPECT_EQ(0U, osTrace.str().find("{\"traceEvents\": [{"));
+}
+
+TEST(Metrics, TimelineJSON)
+{
+   RNTupleTimeline timeline;
+   const auto start = RNTupleTimeline::Clock_t::now() + std::chrono::seconds(10);
+   timeline.AddEvent(RNTupleTimeline::EEventType::kRead, 7, start, start + std::chrono::nanoseconds(1234));
+   auto events = timeline.GetEvents();
+   ASSERT_EQ(1U, events.size());
+
+   // The timestamps keep all their digits, down to the nanosecond
+   std::ostringstream osExpected;
+   osExpected << "\"ts\": " << events[0].fStartNs / 1000 << '.' << std::setfill('0') << std::setw(3)
+              << events[0].fStartNs % 1000 << ", \"dur\": 1.234}";
+   std::ostringstream osJSON;
+   timeline.PrintJSON(osJSON);
+   EXPECT_NE(std::string::npos, osJSON.str().find(osExpected.str())) << osJSON.str();
+}
@@ -132,6 +132,62 @@ TEST(RNTuple, BulkViewCollection)
    }
 }
 
+TEST(RNTuple, ReadBulk)
+{
+   FileRaii fileGuard("test_ntuple_read_bulk.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto fieldTag = model->MakeField<std::string>("tag");
+   auto fieldJets = model->MakeField<std::vector<std::int32_t>>("jets");
+   {
+      RNTupleWriteOptions opt;
+      opt.SetApproxUnzippedPageSize(1000 * sizeof(float));
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), opt);
+      for (int i = 0; i < 10'000; i++) {
+         *fieldPt = i;
+         *fieldTag = std::to_string(i);
+         fieldJets->clear();
+         for (int j = 0; j < i % 3; ++j)
+            fieldJets->push_back(i + j);
+         ntuple->Fill();
+         if (i % 4'000 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+
+   // Spans several pages and clusters
+   auto viewPt = ntuple->GetView<float>("pt");
+   std::vector<float> pt(5'000);
+   viewPt.ReadBulk(2'500, pt.size(), pt.data());
+   for (unsigned i = 0; i < pt.size(); ++i)
+      ASSERT_EQ(static_cast<float>(2'500 + i), pt[i]) << i;
+
+   // Non-mappable fields are read value by value
+   auto viewTag = ntuple->GetView<std::string>("tag");
+   std::vector<std::string> tags(10);
+   viewTag.ReadBulk(3'995, tags.size(), tags.data());
+   for (unsigned i = 0; i < tags.size(); ++i)
+      EXPECT_EQ(std::to_string(3'995 + i), tags[i]);
+
+   // Collections: offsets + values
+   auto viewJets = ntuple->GetViewCollection("jets");
+   auto viewJetItems = viewJets.GetView<std::int32_t>("_0");
+   const NTupleSize_t firstEntry = 3'990;
+   const NTupleSize_t nEntries = 20;
+   std::vector<NTupleSize_t> offsets(nEntries + 1);
+   viewJets.ReadBulk(firstEntry, nEntries, offsets.data());
+   std::vector<std::int32_t> items(offsets[nEntries] - offsets[0]);
+   viewJetItems.ReadBulk(offsets[0], items.size(), items.data());
+   for (NTupleSize_t i = 0; i < nEntries; ++i) {
+      const auto entry = firstEntry + i;
+      ASSERT_EQ(entry % 3, offsets[i + 1] - offsets[i]) << entry;
+      for (NTupleSize_t j = 0; j < entry % 3; ++j)
+         EXPECT_EQ(static_cast<std::int32_t>(entry + j), items[offsets[i] - offsets[0] + j]);
+   }
+}
+
 TEST(RNTuple, Composable)
 {
    FileRaii fileGuard("test_ntuple_composable.root");
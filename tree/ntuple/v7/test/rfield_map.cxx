@@ -0,0 +1,178 @@
+#include "ntuple_test.hxx"
+
+TEST(RNTuple, StdPair)
+{
+   auto field = RField<std::pair<std::int64_t, float>>("pairField");
+   EXPECT_STREQ("std::pair<std::int64_t,float>", field.GetType().c_str());
+   auto otherField = RFieldBase::Create("test", "std::pair<int64_t, float>").Unwrap();
+   EXPECT_STREQ(field.GetType().c_str(), otherField->GetType().c_str());
+   EXPECT_EQ((sizeof(std::pair<std::int64_t, float>)), field.GetValueSize());
+   EXPECT_EQ((sizeof(std::pair<std::int64_t, float>)), otherField->GetValueSize());
+   EXPECT_EQ((alignof(std::pair<std::int64_t, float>)), field.GetAlignment());
+   EXPECT_EQ((alignof(std::pair<std::int64_t, float>)), otherField->GetAlignment());
+
+   FileRaii fileGuard("test_ntuple_rfield_stdpair.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto pair_field = model->MakeField<std::pair<double, std::string>>({"myPair", "a very cool field"});
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "pair_ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 100; i++) {
+         *pair_field = {static_cast<double>(i), std::to_string(i)};
+         ntuple->Fill();
+         if (i % 10 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("pair_ntuple", fileGuard.GetPath());
+   EXPECT_EQ(100, ntuple->GetNEntries());
+
+   auto viewPair = ntuple->GetView<std::pair<double, std::string>>("myPair");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(static_cast<double>(i), viewPair(i).first);
+      EXPECT_EQ(std::to_string(i), viewPair(i).second);
+   }
+}
+
+TEST(RNTuple, StdPairNonStandardLayout)
+{
+   // DerivedA has data members in both the derived and the base class
+   using Pair_t = std::pair<float, DerivedA>;
+   auto field = RField<Pair_t>("pairField");
+   EXPECT_EQ(sizeof(Pair_t), field.GetValueSize());
+   EXPECT_EQ(alignof(Pair_t), field.GetAlignment());
+
+   FileRaii fileGuard("test_ntuple_rfield_stdpair_nonstandardlayout.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto pair_field = model->MakeField<Pair_t>("myPair");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "pair_ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 10; i++) {
+         pair_field->first = i;
+         pair_field->second.a = 2 * i;
+         pair_field->second.a_s = std::to_string(i);
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("pair_ntuple", fileGuard.GetPath());
+   auto viewPair = ntuple->GetView<Pair_t>("myPair");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPair(i).first);
+      EXPECT_FLOAT_EQ(static_cast<float>(2 * i), viewPair(i).second.a);
+      EXPECT_EQ(std::to_string(i), viewPair(i).second.a_s);
+   }
+}
+
+TEST(RNTuple, StdSet)
+{
+   auto field = RField<std::set<std::int64_t>>("setField");
+   EXPECT_STREQ("std::set<std::int64_t>", field.GetType().c_str());
+   auto otherField = RFieldBase::Create("test", "std::set<std::int64_t>").Unwrap();
+   EXPECT_EQ(ENTupleStructure::kCollection, otherField->GetStructure());
+   EXPECT_EQ((sizeof(std::set<std::int64_t>)), field.GetValueSize());
+   EXPECT_EQ((sizeof(std::set<std::int64_t>)), otherField->GetValueSize());
+
+   FileRaii fileGuard("test_ntuple_rfield_stdset.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto set_field = model->MakeField<std::set<float>>({"mySet", "float set"});
+      auto set_field2 = model->MakeField<std::unordered_set<std::string>>({"myUnorderedSet", "string set"});
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "set_ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 100; i++) {
+         *set_field = {static_cast<float>(i), static_cast<float>(i * 2), static_cast<float>(i * 3)};
+         set_field2->clear();
+         for (int j = 0; j < i % 5; ++j)
+            set_field2->insert(std::to_string(j));
+         ntuple->Fill();
+         if (i % 25 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("set_ntuple", fileGuard.GetPath());
+   EXPECT_EQ(100, ntuple->GetNEntries());
+
+   auto viewSet = ntuple->GetView<std::set<float>>("mySet");
+   auto viewSet2 = ntuple->GetView<std::unordered_set<std::string>>("myUnorderedSet");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(std::set<float>({static_cast<float>(i), static_cast<float>(i * 2), static_cast<float>(i * 3)}),
+                viewSet(i));
+      EXPECT_EQ(static_cast<std::size_t>(i % 5), viewSet2(i).size());
+      for (int j = 0; j < static_cast<int>(i % 5); ++j)
+         EXPECT_EQ(1U, viewSet2(i).count(std::to_string(j)));
+   }
+}
+
+TEST(RNTuple, StdMap)
+{
+   auto field = RField<std::map<std::int64_t, float>>("mapField");
+   EXPECT_STREQ("std::map<std::int64_t,float>", field.GetType().c_str());
+   auto otherField = RFieldBase::Create("test", "std::map<int64_t, float>").Unwrap();
+   EXPECT_STREQ(field.GetType().c_str(), otherField->GetType().c_str());
+   EXPECT_EQ((sizeof(std::map<std::int64_t, float>)), field.GetValueSize());
+   EXPECT_EQ((sizeof(std::map<std::int64_t, float>)), otherField->GetValueSize());
+   // The map items are (key, value) pairs
+   EXPECT_STREQ("std::pair<std::int64_t,float>", field.GetSubFields()[0]->GetType().c_str());
+
+   FileRaii fileGuard("test_ntuple_rfield_stdmap.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto map_field = model->MakeField<std::map<std::string, float>>({"myMap", "string -> float map"});
+      auto map_field2 = model->MakeField<std::unordered_map<std::int32_t, std::vector<float>>>("myUnorderedMap");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "map_ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 100; i++) {
+         *map_field = {{"foo", static_cast<float>(i)}, {"bar", static_cast<float>(i * 2)}};
+         map_field2->clear();
+         for (int j = 0; j < i % 3; ++j)
+            (*map_field2)[j] = std::vector<float>(j, static_cast<float>(i));
+         ntuple->Fill();
+         if (i % 25 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("map_ntuple", fileGuard.GetPath());
+   EXPECT_EQ(100, ntuple->GetNEntries());
+
+   auto viewMap = ntuple->GetView<std::map<std::string, float>>("myMap");
+   auto viewMap2 = ntuple->GetView<std::unordered_map<std::int32_t, std::vector<float>>>("myUnorderedMap");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ((std::map<std::string, float>{{"foo", static_cast<float>(i)}, {"bar", static_cast<float>(i * 2)}}),
+                viewMap(i));
+      EXPECT_EQ(static_cast<std::size_t>(i % 3), viewMap2(i).size());
+      for (int j = 0; j < static_cast<int>(i % 3); ++j)
+         EXPECT_EQ(std::vector<float>(j, static_cast<float>(i)), viewMap2(i).at(j));
+   }
+
+   // Read back through the type-erased fields created from the on-disk type names
+   std::ostringstream os;
+   ntuple->Show(0, ROOT::Experimental::ENTupleShowFormat::kCompleteJSON, os);
+   EXPECT_NE(std::string::npos, os.str().find("\"foo\""));
+}
+
+TEST(RNTuple, RecordPadding)
+{
+   std::vector<std::unique_ptr<RFieldBase>> items;
+   items.emplace_back(std::make_unique<RField<char>>("c"));
+   items.emplace_back(std::make_unique<RField<std::int64_t>>("i"));
+   items.emplace_back(std::make_unique<RField<char>>("d"));
+   auto record = std::make_unique<ROOT::Experimental::RRecordField>("record", items);
+
+   struct {
+      char c;
+      std::int64_t i;
+      char d;
+   } expected;
+   EXPECT_EQ(sizeof(expected), record->GetValueSize());
+   EXPECT_EQ(alignof(decltype(expected)), record->GetAlignment());
+
+   auto value = record->GenerateValue();
+   auto elements = record->SplitValue(value);
+   ASSERT_EQ(3U, elements.size());
+   EXPECT_EQ(offsetof(decltype(expected), i),
+             static_cast<std::size_t>(elements[1].Get<unsigned char>() - value.Get<unsigned char>()));
+   EXPECT_EQ(offsetof(decltype(expected), d),
+             static_cast<std::size_t>(elements[2].Get<unsigned char>() - value.Get<unsigned char>()));
+   record->DestroyValue(value);
+}
@@ -0,0 +1,156 @@
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeParallelWriter
+#define ROOT_TTreeParallelWriter
+
+#include "RtypesCore.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+class TMemFile;
+class TTree;
+
+namespace ROOT {
+namespace Experimental {
+
+class TTreeParallelWriter;
+
+/**
+ * \class TTreeFillContext TTreeParallelWriter.hxx
+ * \ingroup tree
+ *
+ * A TTreeFillContext fills entries of the output tree of a TTreeParallelWriter from a single thread.
+ * The entries are serialized into the baskets of a private copy of the output tree, which lives in
+ * an in-memory file. Once a cluster is complete, the baskets are compressed in the filling thread
+ * (in parallel across branches if implicit multi-threading is enabled) and the compressed baskets are
+ * appended to the output tree without being unstreamed again.
+ */
+class TTreeFillContext {
+   friend class TTreeParallelWriter;
+
+private:
+   TTreeParallelWriter &fWriter;
+   std::unique_ptr<TMemFile> fFile; ///< Holds the baskets of the current cluster
+   TTree *fTree = nullptr;          ///< Private copy of the output tree; owned by fFile
+   Long64_t fClusterEntries = 0;    ///< Commit after this many entries, unless zero
+   Long64_t fClusterBytes = 0;      ///< Commit after this many uncompressed bytes, if fClusterEntries is zero
+   Long64_t fNBytes = 0;            ///< Uncompressed bytes filled since the last commit
+   Long64_t fTicket = -1;           ///< Position of the current cluster in the output in sequential commit mode
+
+   TTreeFillContext(TTreeParallelWriter &writer);
+
+public:
+   TTreeFillContext(const TTreeFillContext &) = delete;
+   TTreeFillContext &operator=(const TTreeFillContext &) = delete;
+   /** Commits the remaining entries. */
+   ~TTreeFillContext();
+
+   /** Returns the tree whose branch addresses have to be set before calling Fill(). */
+   TTree *GetTree() const { return fTree; }
+
+   /** Fills one entry from the current branch addresses; commits the cluster if it is complete.
+    *  Returns the number of uncompressed bytes filled. */
+   Int_t Fill();
+
+   /** Appends the entries filled so far as a new cluster to the output tree. */
+   void Commit();
+};
+
+/**
+ * \class TTreeParallelWriter TTreeParallelWriter.hxx
+ * \ingroup tree
+ *
+ * TTreeParallelWriter fills a single TTree from multiple threads. Every thread obtains its own
+ * TTreeFillContext, which buffers and compresses a cluster worth of entries independently of the
+ * other threads. Complete clusters are appended to the output tree either in the order in which
+ * they are committed or in the order in which their first entry was filled.
+ *
+ * Compared to TBufferMerger, the data does not go through a TMemFile image and TFileMerger:
+ * the compressed baskets are copied directly onto the output tree by the committing thread.
+ *
+ * ~~~ {.cpp}
+ * ROOT::EnableThreadSafety();
+ * TFile f("out.root", "RECREATE");
+ * TTree t("t", "t");
+ * float px = 0;
+ * t.Branch("px", &px);
+ * {
+ *    ROOT::Experimental::TTreeParallelWriter writer(t);
+ *    auto work = [&writer]() {
+ *       auto ctx = writer.CreateFillContext();
+ *       float px = 0;
+ *       ctx->GetTree()->SetBranchAddress("px", &px);
+ *       for (int i = 0; i < 1000; ++i) {
+ *          px = i;
+ *          ctx->Fill();
+ *       }
+ *    };
+ *    std::thread t1(work), t2(work);
+ *    t1.join();
+ *    t2.join();
+ * }
+ * t.Write();
+ * ~~~
+ *
+ * The output tree must not be used while fill contexts exist. The fill contexts must be destroyed
+ * before the writer. Thread-safety must be enabled with ROOT::EnableThreadSafety().
+ */
+class TTreeParallelWriter {
+   friend class TTreeFillContext;
+
+public:
+   enum class ECommitOrder {
+      /// Clusters are appended in the order in which they are committed
+      kArrival,
+      /// Clusters are appended in the order in which their first entry is filled. A thread must not fill
+      /// from several fill contexts at the same time in this mode, as it would wait for itself.
+      kSequential
+   };
+
+private:
+   TTree &fTarget;
+   ECommitOrder fOrder;
+   Long64_t fClusterEntries = 0;
+   Long64_t fClusterBytes = 0;
+   Int_t fNContexts = 0;
+   std::mutex fMutex;                ///< Protects the output tree and the members below
+   std::condition_variable fCvOrder; ///< Signals the progress of fNextCommit
+   Long64_t fNextTicket = 0;         ///< Handed out to the next cluster in sequential mode
+   Long64_t fNextCommit = 0;         ///< Ticket of the next cluster to be appended in sequential mode
+
+   Long64_t TakeTicket();
+   void CommitCluster(TTreeFillContext &context);
+   void ReleaseContext();
+
+public:
+   /** Constructor
+    * @param target Output tree, attached to a writable file, which defines the branches
+    * @param order Order in which the clusters of the different fill contexts are appended
+    */
+   TTreeParallelWriter(TTree &target, ECommitOrder order = ECommitOrder::kArrival);
+   TTreeParallelWriter(const TTreeParallelWriter &) = delete;
+   TTreeParallelWriter &operator=(const TTreeParallelWriter &) = delete;
+   ~TTreeParallelWriter();
+
+   /** Sets the cluster size of fill contexts created afterwards. A positive value is a number of entries,
+    *  a negative value a number of uncompressed bytes. By default, the auto flush setting of the output
+    *  tree is used. */
+   void SetClusterSize(Long64_t size);
+
+   /** Returns a new fill context; can be called concurrently from multiple threads. Returns nullptr if the
+    *  output tree is not attached to a writable file. */
+   std::unique_ptr<TTreeFillContext> CreateFillContext();
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
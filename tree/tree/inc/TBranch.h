@@ -50,6 +50,7 @@ class TBulkBranchRead;
 }
 namespace Internal {
 class TBranchIMTHelper; ///< A helper class for managing IMT work during TTree:Fill operations.
+class TBranchZSTDDictionary; ///< Trains the ZSTD dictionary of the baskets of a branch.
 }
 }
 
@@ -90,6 +91,7 @@ class TBranch : public TNamed , public TAttFill {
    using TIOFeatures = ROOT::TIOFeatures;
 
 protected:
+   friend class TBasket;
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
@@ -150,6 +152,8 @@ protected:
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
+   ROOT::Internal::TBranchZSTDDictionary *fZSTDDictionary = nullptr; ///<! Trains the ZSTD dictionary of the baskets, if enabled
+
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
@@ -235,6 +239,7 @@ public:
            Long64_t  GetTotalSize(Option_t *option="")   const;
            Long64_t  GetTotBytes(Option_t *option="")    const;
            Long64_t  GetZipBytes(Option_t *option="")    const;
+           UInt_t    GetZSTDDictionaryID() const;
            Long64_t  GetEntryNumber() const {return fEntryNumber;}
            Long64_t  GetFirstEntry()  const {return fFirstEntry; }
          TIOFeatures GetIOFeatures() const;
@@ -282,6 +287,7 @@ public:
    virtual void      SetStatus(Bool_t status=1);
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
+           void      SetZSTDDictionary(Int_t nbaskets = 10);
            Bool_t    SupportsBulkRead() const;
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
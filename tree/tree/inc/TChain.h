@@ -23,6 +23,9 @@
 
 #include "TTree.h"
 
+#include <atomic>
+#include <memory>
+
 class TFile;
 class TBrowser;
 class TCut;
@@ -30,6 +33,14 @@ class TEntryList;
 class TEventList;
 class TCollection;
 
+#ifdef R__USE_IMT
+namespace ROOT {
+namespace Experimental {
+class TTaskGroup;
+}
+}
+#endif
+
 class TChain : public TTree {
 
 protected:
@@ -43,6 +54,12 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Bool_t       fPrefetchNextFile = kFALSE;         ///<! If true, the next file is opened in the background (requires IMT)
+   Int_t        fPrefetchTreeNumber = -1;           ///<! Tree number of the file opened in the background, -1 if none
+   std::atomic<TFile *> fPrefetchFile{nullptr};     ///<! File opened in the background (We own the file.)
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::Experimental::TTaskGroup> fPrefetchTaskGroup; ///<! Runs the opening of the next file
+#endif
 
 private:
    TChain(const TChain&);            // not implemented
@@ -52,6 +69,8 @@ private:
 protected:
    void InvalidateCurrentTree();
    void ReleaseChainProof();
+   void PrefetchFile(Int_t treenum);
+   TFile *TakePrefetchedFile(Int_t treenum);
 
 public:
    // TChain constants
@@ -93,6 +112,7 @@ public:
    virtual Long64_t  GetChainEntryNumber(Long64_t entry) const;
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
            Int_t     GetNtrees() const { return fNtrees; }
+           Bool_t    GetPrefetchNextFile() const { return fPrefetchNextFile; }
    virtual Long64_t  GetEntries() const;
    virtual Long64_t  GetEntries(const char *sel) { return TTree::GetEntries(sel); }
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall=0);
@@ -162,6 +182,7 @@ public:
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
+           void      SetPrefetchNextFile(Bool_t prefetch = kTRUE);
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
@@ -642,6 +642,7 @@ public:
    virtual void            SetTreeIndex(TVirtualIndex* index);
    virtual void            SetWeight(Double_t w = 1, Option_t* option = "");
    virtual void            SetUpdate(Int_t freq = 0) { fUpdate = freq; }
+   void                    SetZSTDDictionary(Int_t nbaskets = 10);
    virtual void            Show(Long64_t entry = -1, Int_t lenmax = 20);
    virtual void            StartViewer(); // *MENU*
    virtual Int_t           StopCacheLearningPhase();
@@ -25,6 +25,7 @@
 #include "TTimeStamp.h"
 #include "ROOT/TIOFeatures.hxx"
 #include "RZip.h"
+#include "TBranchZSTDDictionary.h"
 
 #include <bitset>
 
@@ -470,6 +471,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   const char *mappedBuffer = nullptr;
+   // Refers to the compressed basket in the memory mapped file, if any
+   std::unique_ptr<TBufferFile> mappedBufferRef;
 
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
@@ -493,11 +497,22 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 
    // Determine which buffer to use, so that we can avoid a memcpy in case of
    // the basket was not compressed.
+   if (fBranch->GetCompressionLevel() != 0 && file->IsMapped()) {
+      R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+      mappedBuffer = file->GetMappedBuffer(pos, len);
+   }
+
    TBuffer* readBufferRef;
    if (R__unlikely(fBranch->GetCompressionLevel()==0)) {
       // Initialize the buffer to hold the uncompressed data.
       fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, len, file);
       readBufferRef = fBufferRef;
+   } else if (mappedBuffer) {
+      // Decompress directly from the memory mapped file, without copying the compressed data.
+      // The mapping is read-only; this buffer is only used to unstream the header.
+      mappedBufferRef.reset(new TBufferFile(TBuffer::kRead, len, const_cast<char *>(mappedBuffer), kFALSE));
+      mappedBufferRef->SetParent(file);
+      readBufferRef = mappedBufferRef.get();
    } else {
       // Initialize the buffer to hold the compressed data.
       fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file);
@@ -513,7 +528,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       return 1;
    }
 
-   if (pf) {
+   if (mappedBuffer) {
+      // The data is already in memory
+   } else if (pf) {
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       Int_t st = 0;
@@ -618,6 +635,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
+         ROOT::Internal::TBranchZSTDDictionary::LoadDictionary(file, rawCompressedObjectBuffer, nin);
          R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
          if (!nout) break;
          noutot += nout;
@@ -1228,6 +1246,15 @@ Int_t TBasket::WriteBuffer()
       fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
+      // In the ZSTD dictionary mode, the first baskets of the branch train the dictionary
+      // that compresses the following ones
+      UInt_t zstdDictID = 0;
+      auto zstdDict = fBranch->fZSTDDictionary;
+      if (zstdDict && cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+         zstdDictID = zstdDict->GetDictID();
+         if (zstdDict->IsSampling())
+            zstdDict->AddSample(objbuf, std::min(fObjlen, Int_t(kMAXZIPBUF)), file);
+      }
       noutot = 0;
       nzip   = 0;
       for (Int_t i = 0; i < nbuffers; ++i) {
@@ -1242,7 +1269,10 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (zstdDictID)
+            R__zipZSTDDict(zstdDictID, cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout);
+         else
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
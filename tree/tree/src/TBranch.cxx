@@ -50,6 +50,7 @@
 #include "snprintf.h"
 
 #include "TBranchIMTHelper.h"
+#include "TBranchZSTDDictionary.h"
 
 #include "ROOT/TIOFeatures.hxx"
 
@@ -452,6 +453,9 @@ TBranch::~TBranch()
    delete fBrowsables;
    fBrowsables = 0;
 
+   delete fZSTDDictionary;
+   fZSTDDictionary = nullptr;
+
    // Note: We do *not* have ownership of the buffer.
    fEntryBuffer = 0;
 
@@ -2730,6 +2734,37 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the ZSTD dictionary mode for this branch and its sub-branches.
+///
+/// Small baskets, e.g. of low-multiplicity branches, compress badly on their own.
+/// In this mode, the content of the first `nbaskets` baskets written by the branch
+/// trains a ZSTD dictionary, which compresses all the following baskets. The
+/// dictionary is stored once in the file, next to the tree, and it is read back
+/// automatically when the baskets are read. It is only used if the baskets are
+/// compressed with ZSTD. A value of 0 disables the mode for the baskets not yet written.
+
+void TBranch::SetZSTDDictionary(Int_t nbaskets)
+{
+   delete fZSTDDictionary;
+   fZSTDDictionary = (nbaskets > 0) ? new ROOT::Internal::TBranchZSTDDictionary(nbaskets) : nullptr;
+
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i=0;i<nb;i++) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->SetZSTDDictionary(nbaskets);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ID of the ZSTD dictionary that compresses the baskets written from now on,
+/// or 0 if there is none. See SetZSTDDictionary().
+
+UInt_t TBranch::GetZSTDDictionaryID() const
+{
+   return fZSTDDictionary ? fZSTDDictionary->GetDictID() : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
@@ -0,0 +1,102 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TBranchZSTDDictionary.h"
+
+#include "TError.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
+#include "RZip.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace {
+/// Upper limit of the dictionary size; larger dictionaries do not help the small baskets the mode is meant for
+constexpr size_t kMaxDictSize = 16 * 1024;
+/// ZDICT_DICTSIZE_MIN
+constexpr size_t kMinDictSize = 256;
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adds the uncompressed content of a basket to the samples. Once fNSamples are collected, the dictionary is
+/// trained, registered and written to the file. If the training fails, e.g. because there is too little data,
+/// the baskets are compressed without dictionary.
+
+void TBranchZSTDDictionary::AddSample(const char *buffer, Int_t size, TFile *file)
+{
+   if (fDone || size <= 0)
+      return;
+   fSamples.insert(fSamples.end(), buffer, buffer + size);
+   fSampleSizes.push_back(size);
+   if (fSampleSizes.size() < static_cast<size_t>(fNSamples))
+      return;
+
+   fDone = kTRUE;
+   const size_t capacity = std::min(kMaxDictSize, fSamples.size() / 4);
+   if (capacity >= kMinDictSize) {
+      std::string dict(capacity, '\0');
+      const size_t dictSize =
+         R__ZSTDTrainDictionary(&dict[0], capacity, fSamples.data(), fSampleSizes.data(), fSampleSizes.size());
+      if (dictSize > 0) {
+         dict.resize(dictSize);
+         fDictID = R__ZSTDRegisterDictionary(dict.data(), dict.size());
+         const TString name = GetKeyName(fDictID);
+         if (fDictID && !file->GetKey(name))
+            file->WriteObjectAny(&dict, "string", name);
+      }
+   }
+   std::vector<char>().swap(fSamples);
+   std::vector<size_t>().swap(fSampleSizes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Name of the key that holds the dictionary in the file
+
+TString TBranchZSTDDictionary::GetKeyName(UInt_t dictID)
+{
+   return TString::Format("ZSTDDictionary_%u", dictID);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns whether the compressed block can be unzipped, i.e. it uses no ZSTD dictionary or a registered one
+
+Bool_t TBranchZSTDDictionary::HasDictionary(const UChar_t *buffer, Int_t size)
+{
+   const UInt_t dictID = R__ZSTDGetDictID(buffer, size);
+   return !dictID || R__ZSTDHasDictionary(dictID);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Registers the ZSTD dictionary that the compressed block uses, reading it from the file if it is not known yet
+
+void TBranchZSTDDictionary::LoadDictionary(TFile *file, const UChar_t *buffer, Int_t size)
+{
+   if (HasDictionary(buffer, size) || !file)
+      return;
+
+   const UInt_t dictID = R__ZSTDGetDictID(buffer, size);
+   R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+   std::unique_ptr<std::string> dict(file->Get<std::string>(GetKeyName(dictID)));
+   if (!dict) {
+      ::Error("TBranchZSTDDictionary::LoadDictionary", "ZSTD dictionary %u not found in %s", dictID, file->GetName());
+      return;
+   }
+   R__ZSTDRegisterDictionary(dict->data(), dict->size());
+}
+
+} // Internal
+} // ROOT
@@ -0,0 +1,57 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBranchZSTDDictionary
+#define ROOT_TBranchZSTDDictionary
+
+#include "RtypesCore.h"
+#include "TString.h"
+
+#include <cstddef>
+#include <vector>
+
+class TFile;
+
+/** \class ROOT::Internal::TBranchZSTDDictionary
+ Trains the ZSTD dictionary of a branch from the content of its first baskets, see TBranch::SetZSTDDictionary.
+ The dictionary is stored once in the file, as a std::string under the key returned by GetKeyName(), and it is
+ loaded from there by the readers of the baskets compressed with it.
+*/
+
+namespace ROOT {
+namespace Internal {
+
+class TBranchZSTDDictionary {
+public:
+   explicit TBranchZSTDDictionary(Int_t nsamples) : fNSamples(nsamples) {}
+
+   /// Returns the ID of the dictionary for the next baskets, or 0 if there is none (yet)
+   UInt_t GetDictID() const { return fDictID; }
+   /// Returns whether more baskets are needed to train the dictionary
+   Bool_t IsSampling() const { return !fDone; }
+
+   void AddSample(const char *buffer, Int_t size, TFile *file);
+
+   static TString GetKeyName(UInt_t dictID);
+   static Bool_t HasDictionary(const UChar_t *buffer, Int_t size);
+   static void LoadDictionary(TFile *file, const UChar_t *buffer, Int_t size);
+
+private:
+   Int_t fNSamples;                  ///< Number of baskets to sample before training the dictionary
+   Bool_t fDone = kFALSE;            ///< The dictionary is trained, or the training failed
+   UInt_t fDictID = 0;               ///< ID of the trained dictionary, 0 if there is none
+   std::vector<char> fSamples;       ///< Uncompressed content of the sampled baskets, back-to-back
+   std::vector<size_t> fSampleSizes; ///< Size of each sample in fSamples
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -63,6 +63,10 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -198,6 +202,9 @@ TChain::~TChain()
    delete fFiles;
    fFiles = 0;
 
+   // Waits for a pending background open and deletes the file
+   TakePrefetchedFile(-1);
+
    //first delete cache if exists
    auto tc = fFile && fTree ? fTree->GetReadCache(fFile) : nullptr;
    if (tc) {
@@ -1507,7 +1514,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      fFile = TakePrefetchedFile(treenum);
+      if (!fFile)
+         fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
@@ -1543,6 +1552,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
    // FIXME: We may set fDirectory to zero here!
    fDirectory = fFile;
 
+   // While this tree is processed, open the next one in the background.
+   PrefetchFile(treenum + 1);
+
    // Reuse cache from previous file (if any).
    if (tpf) {
       if (fFile) {
@@ -2211,6 +2223,63 @@ void TChain::ParseTreeFilename(const char *name, TString &filename, TString &tre
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the file of the given tree number in a background task and read the tree header.
+/// The file is picked up by LoadTree() once it switches to that tree.
+/// Nothing is done unless SetPrefetchNextFile() was called and implicit multi-threading is enabled.
+
+void TChain::PrefetchFile(Int_t treenum)
+{
+#ifdef R__USE_IMT
+   if (!fPrefetchNextFile || !ROOT::IsImplicitMTEnabled() || (treenum >= fNtrees) || (fPrefetchTreeNumber >= 0))
+      return;
+   auto element = static_cast<TChainElement *>(fFiles->At(treenum));
+   if (!element)
+      return;
+
+   if (!fPrefetchTaskGroup)
+      fPrefetchTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   fPrefetchTreeNumber = treenum;
+   TString filename = element->GetTitle();
+   TString treename = element->GetName();
+   fPrefetchTaskGroup->Run([this, filename, treename]() {
+      TDirectory::TContext ctxt;
+      TFile *file = TFile::Open(filename);
+      if (file && !file->IsZombie()) {
+         // Reads the keys, the streamer infos and the tree header. The tree is attached to the file,
+         // so that LoadTree() finds it in memory.
+         file->Get(treename);
+      }
+      fPrefetchFile = file;
+   });
+#else
+   (void)treenum;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the background opening of a file started by PrefetchFile() and return the file if it
+/// belongs to the tree number treenum. The caller takes ownership. Otherwise, the prefetched file is deleted
+/// and nullptr is returned.
+
+TFile *TChain::TakePrefetchedFile(Int_t treenum)
+{
+   if (fPrefetchTreeNumber < 0)
+      return nullptr;
+
+#ifdef R__USE_IMT
+   fPrefetchTaskGroup->Wait();
+#endif
+   TFile *file = fPrefetchFile.exchange(nullptr);
+   const bool isMatch = (fPrefetchTreeNumber == treenum);
+   fPrefetchTreeNumber = -1;
+   if (!isMatch) {
+      delete file;
+      return nullptr;
+   }
+   return file;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the header information of each tree in the chain.
 /// See TTree::Print for a list of options.
@@ -2280,6 +2349,10 @@ Long64_t TChain::Process(TSelector* selector, Option_t* option, Long64_t nentrie
 
 void TChain::RecursiveRemove(TObject *obj)
 {
+   TFile *prefetchFile = fPrefetchFile;
+   if (prefetchFile && prefetchFile == obj) {
+      fPrefetchFile.compare_exchange_strong(prefetchFile, nullptr);
+   }
    if (fFile == obj) {
       fFile = 0;
       fDirectory = 0;
@@ -2322,6 +2395,7 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   TakePrefetchedFile(-1);
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2987,6 +3061,22 @@ void TChain::SetPacketSize(Int_t size)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable/Disable opening the next file of the chain in the background.
+///
+/// While the entries of a file are processed, the next file is opened and its tree header
+/// is read by a background task, so that the switch to the next file does not stall the
+/// event loop. This is beneficial for chains of many small files on slow or remote storage.
+/// The prefetching requires implicit multi-threading (ROOT::EnableImplicitMT()); otherwise
+/// the setting has no effect.
+
+void TChain::SetPrefetchNextFile(Bool_t prefetch)
+{
+   fPrefetchNextFile = prefetch;
+   if (!prefetch)
+      TakePrefetchedFile(-1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable/Disable PROOF processing on the current default Proof (gProof).
 ///
@@ -8696,6 +8696,11 @@ Int_t TTree::SetCacheSizeAux(Bool_t autocache /* = kTRUE */, Long64_t cacheSize
       return 0;
    }
 
+   if (autocache && file->IsMapped()) {
+      // Baskets of memory mapped files are decompressed in place; a cache would only add a copy
+      return 0;
+   }
+
    // Check for an existing cache
    TTreeCache* pf = GetReadCache(file);
    if (pf) {
@@ -9301,6 +9306,23 @@ void TTree::SetWeight(Double_t w, Option_t*)
    fWeight = w;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the ZSTD dictionary mode for all the existing branches.
+///
+/// The first `nbaskets` baskets of each branch train a ZSTD dictionary that
+/// compresses the following baskets of the branch, which helps for small baskets.
+/// The dictionaries are stored in the file. They are only used if the baskets
+/// are compressed with ZSTD, see TBranch::SetZSTDDictionary.
+
+void TTree::SetZSTDDictionary(Int_t nbaskets)
+{
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i = 0; i < nb; ++i) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->SetZSTDDictionary(nbaskets);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print values of all active leaves for entry.
 ///
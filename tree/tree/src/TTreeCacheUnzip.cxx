@@ -19,6 +19,7 @@ A TTreeCache which exploits parallelized decompression of its own content.
 */
 
 #include "TTreeCacheUnzip.h"
+#include "TBranchZSTDDictionary.h"
 #include "TBranch.h"
 #include "TChain.h"
 #include "TEnv.h"
@@ -911,6 +912,13 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
             return uzlen;
          }
 
+         // The ZSTD dictionaries are read from the file by TBasket::ReadBasketBuffers, which then unzips the basket
+         if (!ROOT::Internal::TBranchZSTDDictionary::HasDictionary(bufcur, nin)) {
+            if (alloc) delete [] *dest;
+            *dest = 0;
+            return -1;
+         }
+
          R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
 
          if (gDebug > 2)
@@ -0,0 +1,153 @@
+/*************************************************************************
+ * Copyright (C) 1995-2022, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TTreeParallelWriter.hxx"
+
+#include "TError.h"
+#include "TMemFile.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TVirtualMutex.h"
+
+namespace {
+/// Used if the output tree does not define a cluster size; same as the TTree default auto flush setting
+constexpr Long64_t kDefaultClusterBytes = 30000000;
+} // anonymous namespace
+
+namespace ROOT {
+namespace Experimental {
+
+TTreeFillContext::TTreeFillContext(TTreeParallelWriter &writer) : fWriter(writer)
+{
+}
+
+TTreeFillContext::~TTreeFillContext()
+{
+   Commit();
+   // Deletes fTree
+   fFile.reset();
+   fWriter.ReleaseContext();
+}
+
+Int_t TTreeFillContext::Fill()
+{
+   if (fTicket < 0 && fWriter.fOrder == TTreeParallelWriter::ECommitOrder::kSequential)
+      fTicket = fWriter.TakeTicket();
+
+   Int_t nbytes = fTree->Fill();
+   fNBytes += nbytes;
+
+   if (fClusterEntries > 0 ? (fTree->GetEntries() >= fClusterEntries) : (fNBytes >= fClusterBytes))
+      Commit();
+   return nbytes;
+}
+
+void TTreeFillContext::Commit()
+{
+   if (fTree->GetEntries() == 0)
+      return;
+
+   // Compress and write the baskets in the calling thread, outside of the critical section.
+   fTree->FlushBaskets();
+   fWriter.CommitCluster(*this);
+
+   // Drops the baskets written so far while keeping the branch addresses
+   fFile->ResetAfterMerge(nullptr);
+   fNBytes = 0;
+   fTicket = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TTreeParallelWriter::TTreeParallelWriter(TTree &target, ECommitOrder order) : fTarget(target), fOrder(order)
+{
+   if (!target.GetCurrentFile() || !target.GetCurrentFile()->IsWritable())
+      Error("TTreeParallelWriter", "output tree %s is not attached to a writable file", target.GetName());
+
+   SetClusterSize(target.GetAutoFlush());
+}
+
+TTreeParallelWriter::~TTreeParallelWriter()
+{
+   if (fNContexts > 0)
+      Fatal("TTreeParallelWriter", "TTreeFillContexts must be destroyed before the writer");
+}
+
+void TTreeParallelWriter::SetClusterSize(Long64_t size)
+{
+   std::lock_guard<std::mutex> guard(fMutex);
+   fClusterEntries = (size > 0) ? size : 0;
+   fClusterBytes = (size < 0) ? -size : kDefaultClusterBytes;
+}
+
+std::unique_ptr<TTreeFillContext> TTreeParallelWriter::CreateFillContext()
+{
+   auto targetFile = fTarget.GetCurrentFile();
+   if (!targetFile || !targetFile->IsWritable()) {
+      Error("CreateFillContext", "output tree %s is not attached to a writable file", fTarget.GetName());
+      return nullptr;
+   }
+
+   std::unique_ptr<TTreeFillContext> context(new TTreeFillContext(*this));
+
+   std::lock_guard<std::mutex> guard(fMutex);
+   context->fClusterEntries = fClusterEntries;
+   context->fClusterBytes = fClusterBytes;
+   {
+      // Like for TBufferMergerFile, the in-memory files are not registered with gROOT
+      R__LOCKGUARD(gROOTMutex);
+      const auto compress = targetFile->GetCompressionSettings();
+      context->fFile.reset(new TMemFile(fTarget.GetName(), "RECREATE", "", compress));
+      gROOT->GetListOfFiles()->Remove(context->fFile.get());
+   }
+
+   TDirectory::TContext ctxt(context->fFile.get());
+   auto tree = fTarget.CloneTree(0);
+   // Separate the trees, such that changes of the branch addresses of one do not affect the other
+   fTarget.GetListOfClones()->Remove(tree);
+   tree->ResetBranchAddresses();
+   tree->SetDirectory(context->fFile.get());
+   // Clusters are formed by the fill context
+   tree->SetAutoFlush(0);
+   tree->SetAutoSave(0);
+   context->fTree = tree;
+
+   ++fNContexts;
+   return context;
+}
+
+Long64_t TTreeParallelWriter::TakeTicket()
+{
+   std::lock_guard<std::mutex> guard(fMutex);
+   return fNextTicket++;
+}
+
+void TTreeParallelWriter::CommitCluster(TTreeFillContext &context)
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   if (fOrder == ECommitOrder::kSequential)
+      fCvOrder.wait(lock, [this, &context] { return fNextCommit == context.fTicket; });
+
+   // Copies the compressed baskets from the in-memory file; the data is not unstreamed
+   fTarget.CopyEntries(context.fTree, -1, "fast");
+
+   if (fOrder == ECommitOrder::kSequential) {
+      ++fNextCommit;
+      lock.unlock();
+      fCvOrder.notify_all();
+   }
+}
+
+void TTreeParallelWriter::ReleaseContext()
+{
+   std::lock_guard<std::mutex> guard(fMutex);
+   --fNContexts;
+}
+
+} // namespace Experimental
+} // namespace ROOT
@@ -1,3 +1,4 @@
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
@@ -5,6 +6,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 #ifdef R__USE_IMT
 
 // ROOT-9668
@@ -28,4 +31,49 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, chainPrefetchNextFile)
+{
+   ROOT::EnableImplicitMT();
+   const auto nFiles = 4;
+   for (int i = 0; i < nFiles; ++i) {
+      TFile f(TString::Format("chainPrefetchNextFile_%d.root", i), "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      t.Branch("x", &x);
+      // The third file has no entries
+      for (int j = 0; j < 10 * (i != 2); ++j) {
+         x = 100 * i + j;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain c("t");
+   c.Add("chainPrefetchNextFile_*.root");
+   c.SetPrefetchNextFile();
+   EXPECT_TRUE(c.GetPrefetchNextFile());
+   int x = -1;
+   c.SetBranchAddress("x", &x);
+   std::vector<int> values;
+   for (Long64_t i = 0; c.LoadTree(i) >= 0; ++i) {
+      c.GetEntry(i);
+      values.push_back(x);
+   }
+   ASSERT_EQ(30u, values.size());
+   EXPECT_EQ(0, values[0]);
+   EXPECT_EQ(109, values[19]);
+   EXPECT_EQ(300, values[20]);
+   EXPECT_EQ(309, values[29]);
+
+   // Jumping back discards the prefetched file
+   c.GetEntry(5);
+   EXPECT_EQ(5, x);
+   EXPECT_EQ(0, c.GetTreeNumber());
+   c.Reset();
+
+   for (int i = 0; i < nFiles; ++i)
+      gSystem->Unlink(TString::Format("chainPrefetchNextFile_%d.root", i));
+   ROOT::DisableImplicitMT();
+}
+
 #endif // R__USE_IMT
@@ -411,3 +411,42 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, ZSTDDictionary)
+{
+   TMemFile f("tbasket_zstddict.root", "CREATE", "", ROOT::CompressionSettings(ROOT::kZSTD, 5));
+   auto t = new TTree("t", "t");
+   Int_t idx = 0;
+   Float_t x = 0;
+   t->Branch("idx", &idx, "idx/I", 4000);
+   t->Branch("x", &x, "x/F", 4000);
+   t->SetZSTDDictionary(20);
+   const Int_t nEntries = 50000;
+   for (idx = 0; idx < nEntries; ++idx) {
+      x = (idx % 17) * 0.5f;
+      t->Fill();
+   }
+   t->Write();
+
+   // Each branch trained its own dictionary, stored in the file
+   for (auto name : {"idx", "x"}) {
+      const UInt_t dictID = t->GetBranch(name)->GetZSTDDictionaryID();
+      EXPECT_NE(0u, dictID) << name;
+      EXPECT_NE(nullptr, f.GetKey(TString::Format("ZSTDDictionary_%u", dictID))) << name;
+   }
+   delete t;
+
+   t = f.Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   EXPECT_EQ(nEntries, t->GetEntries());
+   Int_t idxIn = -1;
+   Float_t xIn = -1;
+   t->SetBranchAddress("idx", &idxIn);
+   t->SetBranchAddress("x", &xIn);
+   for (Int_t i = 0; i < nEntries; ++i) {
+      ASSERT_GT(t->GetEntry(i), 0);
+      EXPECT_EQ(i, idxIn);
+      EXPECT_EQ((i % 17) * 0.5f, xIn);
+   }
+   delete t;
+}
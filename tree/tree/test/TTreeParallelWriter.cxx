@@ -0,0 +1,174 @@
+#include "ROOT/TTreeParallelWriter.hxx"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "ROOTUnitTestSupport.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using ROOT::Experimental::TTreeParallelWriter;
+
+namespace {
+
+void FillParallel(TTreeParallelWriter &writer, int nThreads, int nEntriesPerThread)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&writer, t, nEntriesPerThread]() {
+         auto context = writer.CreateFillContext();
+         int id = 0;
+         std::vector<float> v;
+         context->GetTree()->SetBranchAddress("id", &id);
+         auto pv = &v;
+         context->GetTree()->SetBranchAddress("v", &pv);
+         for (int i = 0; i < nEntriesPerThread; ++i) {
+            id = t * nEntriesPerThread + i;
+            v.assign(id % 4, static_cast<float>(id));
+            context->Fill();
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+/// The tree is attached to the current directory, i.e. the output file
+TTree *CreateTree()
+{
+   auto t = new TTree("t", "t");
+   int id = 0;
+   std::vector<float> v;
+   t->Branch("id", &id);
+   t->Branch("v", &v);
+   t->ResetBranchAddresses();
+   t->SetAutoFlush(50);
+   return t;
+}
+
+std::vector<int> ReadIds(const char *fileName, bool checkVector)
+{
+   std::vector<int> result;
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   int id = 0;
+   std::vector<float> *v = nullptr;
+   t->SetBranchAddress("id", &id);
+   t->SetBranchAddress("v", &v);
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      t->GetEntry(i);
+      result.push_back(id);
+      if (checkVector) {
+         EXPECT_EQ(static_cast<std::size_t>(id % 4), v->size());
+         for (auto x : *v)
+            EXPECT_FLOAT_EQ(static_cast<float>(id), x);
+      }
+   }
+   t->ResetBranchAddresses();
+   delete v;
+   return result;
+}
+
+} // anonymous namespace
+
+TEST(TTreeParallelWriter, ArrivalOrder)
+{
+   ROOT::EnableThreadSafety();
+   const auto fileName = "ttreeparallelwriter_arrival.root";
+   {
+      TFile f(fileName, "RECREATE");
+      auto t = CreateTree();
+      {
+         TTreeParallelWriter writer(*t);
+         FillParallel(writer, 4, 100);
+      }
+      EXPECT_EQ(400, t->GetEntries());
+      f.Write();
+   }
+
+   auto ids = ReadIds(fileName, true);
+   ASSERT_EQ(400u, ids.size());
+   std::sort(ids.begin(), ids.end());
+   for (int i = 0; i < 400; ++i)
+      EXPECT_EQ(i, ids[i]);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeParallelWriter, SequentialOrder)
+{
+   ROOT::EnableThreadSafety();
+   const auto fileName = "ttreeparallelwriter_sequential.root";
+   const int nTasks = 8;
+   const int nEntriesPerTask = 25;
+   {
+      TFile f(fileName, "RECREATE");
+      auto t = CreateTree();
+      {
+         TTreeParallelWriter writer(*t, TTreeParallelWriter::ECommitOrder::kSequential);
+         // Every task fills exactly one cluster
+         writer.SetClusterSize(nEntriesPerTask);
+
+         // The tasks take their position with their first entry. The ones that start first wait the longest
+         // before filling the rest, such that their clusters are complete after the ones of the later tasks.
+         std::mutex startMutex;
+         int nStarted = 0;
+         auto task = [&]() {
+            auto context = writer.CreateFillContext();
+            int id = 0;
+            std::vector<float> v;
+            context->GetTree()->SetBranchAddress("id", &id);
+            auto pv = &v;
+            context->GetTree()->SetBranchAddress("v", &pv);
+            int first = 0;
+            {
+               std::lock_guard<std::mutex> lock(startMutex);
+               first = nStarted++ * nEntriesPerTask;
+               id = first;
+               v.assign(id % 4, static_cast<float>(id));
+               context->Fill();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5 * (nTasks - first / nEntriesPerTask)));
+            for (int i = 1; i < nEntriesPerTask; ++i) {
+               id = first + i;
+               v.assign(id % 4, static_cast<float>(id));
+               context->Fill();
+            }
+         };
+         std::vector<std::thread> threads;
+         for (int i = 0; i < nTasks; ++i)
+            threads.emplace_back(task);
+         for (auto &thread : threads)
+            thread.join();
+      }
+      EXPECT_EQ(nTasks * nEntriesPerTask, t->GetEntries());
+      f.Write();
+   }
+
+   // The clusters are read back in the order in which the tasks started, not in commit order
+   auto ids = ReadIds(fileName, true);
+   ASSERT_EQ(static_cast<std::size_t>(nTasks * nEntriesPerTask), ids.size());
+   for (int i = 0; i < nTasks * nEntriesPerTask; ++i)
+      EXPECT_EQ(i, ids[i]);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeParallelWriter, NoOutputFile)
+{
+   TDirectory::TContext ctxt(nullptr);
+   TTree t("t", "t");
+   int id = 0;
+   t.Branch("id", &id);
+
+   ROOTUnitTestSupport::CheckDiagsRAII diags;
+   diags.requiredDiag(kError, "TTreeParallelWriter", "output tree t is not attached to a writable file");
+   diags.requiredDiag(kError, "CreateFillContext", "output tree t is not attached to a writable file");
+   TTreeParallelWriter writer(t);
+   EXPECT_EQ(nullptr, writer.CreateFillContext());
+}
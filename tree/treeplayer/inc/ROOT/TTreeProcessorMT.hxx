@@ -20,14 +20,18 @@
 #include "TTreeReader.h"
 #include "TError.h"
 #include "TEntryList.h"
+#include "TNotifyLink.h"
 #include "ROOT/TThreadedObject.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/InternalTreeUtils.hxx" // RFriendInfo
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+class TFileCacheRead;
+
 /** \class TTreeView
     \brief A helper class that encapsulates a file and a tree.
 
@@ -48,8 +52,48 @@ the threaded object.
 namespace ROOT {
 namespace Internal {
 
+/** \class TTreeCacheSettings
+    \brief Settings of the TTreeCaches shared by the tasks of a TTreeProcessorMT.
+
+The branches to be cached are either declared upfront or taken from the cache of the first task
+that completes its learning phase. Later tasks add them to their cache right away and skip the
+learning phase, also when they move on to other files.
+
+Optionally, the cache size is adapted to the read latency measured by the caches of the previous
+tasks: it grows for high latency storage, such that fewer vectored reads are issued, and shrinks
+back towards its initial size for low latency storage.
+*/
+class TTreeCacheSettings {
+public:
+   /// Read statistics of a cache at the beginning of a task
+   struct RReadStats {
+      const TFileCacheRead *fCache = nullptr;
+      Int_t fReadCalls = 0;
+      Double_t fReadTime = 0;
+   };
+
+private:
+   std::mutex fMutex;                  ///< Protects the members below
+   std::vector<std::string> fBranches; ///< Branches to be cached by all tasks
+   bool fHasBranches = false;          ///< True once fBranches is known
+   bool fSubBranches = false;          ///< True if the sub-branches of fBranches should be cached, too
+   bool fAdaptiveSize = false;         ///< True if the cache size is adapted to the read latency
+   Long64_t fMinSize = 0;              ///< Initial cache size, the lower bound of the adaptive size
+   Long64_t fSize = 0;                 ///< Cache size for the following tasks, zero to keep the default
+
+public:
+   void SetBranches(const std::vector<std::string> &branches);
+   void SetAdaptiveSize(bool enable);
+   void Apply(TTree &tree);
+   RReadStats GetReadStats(TTree &tree) const;
+   void Update(TTree &tree, const RReadStats &start);
+};
+
 class TTreeView {
 private:
+   /// Notifies this view when fChain switches to another tree. Must come before fChain, which unlinks it on deletion.
+   TNotifyLink<TTreeView> fNotify{this};
+   TTreeCacheSettings *fCacheSettings = nullptr;  ///< Applied to the cache of every tree of fChain, if set
    std::vector<std::unique_ptr<TChain>> fFriends; ///< Friends of the tree/chain, if present
    std::unique_ptr<TEntryList> fEntryList;        ///< TEntryList for fChain, if present
    // NOTE: fFriends and fEntryList MUST come before fChain to be deleted after it, because neither friend trees nor
@@ -67,7 +111,9 @@ public:
    std::unique_ptr<TTreeReader> GetTreeReader(Long64_t start, Long64_t end, const std::vector<std::string> &treeName,
                                               const std::vector<std::string> &fileNames, const TreeUtils::RFriendInfo &friendInfo,
                                               const TEntryList &entryList, const std::vector<Long64_t> &nEntries,
-                                              const std::vector<std::vector<Long64_t>> &friendEntries);
+                                              const std::vector<std::vector<Long64_t>> &friendEntries,
+                                              TTreeCacheSettings *cacheSettings = nullptr);
+   Bool_t Notify();
 };
 } // End of namespace Internal
 
@@ -79,6 +125,7 @@ private:
    TEntryList fEntryList;
    const Internal::TreeUtils::RFriendInfo fFriendInfo;
    ROOT::TThreadExecutor fPool; ///<! Thread pool for processing.
+   Internal::TTreeCacheSettings fCacheSettings; ///< Shared by the TTreeCaches of all tasks
 
    /// Thread-local TreeViews
    // Must be declared after fPool, for IMT to be initialized first!
@@ -96,6 +143,9 @@ public:
 
    void Process(std::function<void(TTreeReader &)> func);
 
+   void SetCacheBranches(const std::vector<std::string> &branches);
+   void SetAdaptiveCacheSize(bool enable = true);
+
    static void SetTasksPerWorkerHint(unsigned int m);
    static unsigned int GetTasksPerWorkerHint();
 };
@@ -24,11 +24,20 @@
 
 #include "TVirtualIndex.h"
 
+#include <vector>
+
 class TTreeFormula;
 
 class TTreeIndex : public TVirtualIndex {
 
 protected:
+   /// Element of the packed index: the values and the entry number are adjacent in memory
+   struct IndexEntry {
+      Long64_t fMajor;
+      Long64_t fMinor;
+      Long64_t fEntry;
+   };
+
    TString        fMajorName;           ///< Index major name
    TString        fMinorName;           ///< Index minor name
    Long64_t       fN;                   ///< Number of entries
@@ -39,9 +48,13 @@ protected:
    TTreeFormula  *fMinorFormula;        ///<! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  ///<! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  ///<! Pointer to minor TreeFormula in Parent tree (if any)
+   std::vector<IndexEntry> fPacked;     ///<! Sorted values and entry numbers used for the lookups
 
    TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   Bool_t         FillValuesParallel(Long64_t *major, Long64_t *minor);
+   void           PackValues();
+   static void    SortEntries(std::vector<IndexEntry> &entries);
 
 private:
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
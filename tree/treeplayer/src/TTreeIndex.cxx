@@ -15,32 +15,115 @@ A Tree Index with majorname and minorname.
 
 #include "TTreeIndex.h"
 
+#include "RConfigure.h"
 #include "TTreeFormula.h"
 #include "TTree.h"
 #include "TBuffer.h"
+#include "TBufferFile.h"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TLeaf.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/InternalTreeUtils.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TChain.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#endif
+
+#include <algorithm>
+#include <cstring>
 
 ClassImp(TTreeIndex);
 
+namespace {
 
-struct IndexSortComparator {
+#ifdef R__USE_IMT
+/// Minimum number of entries read by a task of the parallel index build
+const Long64_t kMinEntriesPerTask = 100000;
+/// Minimum number of entries sorted by a task of the parallel sort
+const std::size_t kMinEntriesPerSortTask = 1000000;
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+template <typename T>
+void CopyValues(const TBuffer &buf, Long64_t n, Long64_t *values)
+{
+   auto src = reinterpret_cast<const T *>(buf.GetCurrent());
+   for (Long64_t i = 0; i < n; ++i)
+      values[i] = (Long64_t)src[i];
+}
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
-   }
+/// Convert n values of a leaf of type typeName deserialized by the bulk API; return false for unsupported types
+bool CopyBulkValues(const char *typeName, const TBuffer &buf, Long64_t n, Long64_t *values)
+{
+   if (!strcmp(typeName, "Int_t")) CopyValues<Int_t>(buf, n, values);
+   else if (!strcmp(typeName, "UInt_t")) CopyValues<UInt_t>(buf, n, values);
+   else if (!strcmp(typeName, "Long64_t")) CopyValues<Long64_t>(buf, n, values);
+   else if (!strcmp(typeName, "ULong64_t")) CopyValues<ULong64_t>(buf, n, values);
+   else if (!strcmp(typeName, "Short_t")) CopyValues<Short_t>(buf, n, values);
+   else if (!strcmp(typeName, "UShort_t")) CopyValues<UShort_t>(buf, n, values);
+   else if (!strcmp(typeName, "Char_t")) CopyValues<Char_t>(buf, n, values);
+   else if (!strcmp(typeName, "UChar_t")) CopyValues<UChar_t>(buf, n, values);
+   else if (!strcmp(typeName, "Bool_t")) CopyValues<Bool_t>(buf, n, values);
+   else if (!strcmp(typeName, "Float_t")) CopyValues<Float_t>(buf, n, values);
+   else if (!strcmp(typeName, "Double_t")) CopyValues<Double_t>(buf, n, values);
+   else return false;
+   return true;
+}
 
-  // pointers to the start of index values tables keeping upper 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
-};
+/// Return the leaf named `name` if its values can be read without evaluating a TTreeFormula:
+/// a scalar leaf of a plain TBranch of the tree itself (not of a friend)
+TLeaf *GetPlainLeaf(TTree &tree, const char *name)
+{
+   TLeaf *leaf = tree.GetLeaf(name);
+   if (!leaf || leaf->GetLeafCount() || leaf->GetLenStatic() != 1)
+      return nullptr;
+   TBranch *branch = leaf->GetBranch();
+   if (branch->IsA() != TBranch::Class() || branch->GetTree() != tree.GetTree())
+      return nullptr;
+   return leaf;
+}
+
+/// Read the values of the leaf `name` for the entries [first, last) of `tree` into `values`.
+/// Whole baskets are read with the bulk API where possible; only the branch of the leaf is read.
+bool ReadLeafValues(TTree &tree, const char *name, Long64_t first, Long64_t last, Long64_t *values)
+{
+   TLeaf *leaf = GetPlainLeaf(tree, name);
+   if (!leaf)
+      return false;
+   TBranch *branch = leaf->GetBranch();
+   const bool bulk = branch->SupportsBulkRead();
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+
+   Long64_t entry = first;
+   while (entry < last) {
+      Int_t n = -1;
+      if (bulk) {
+         // The bulk API reads from the first entry of a basket only
+         const Long64_t *basketEntry = branch->GetBasketEntry();
+         const Int_t basket = TMath::BinarySearch(branch->GetWriteBasket() + 1, basketEntry, entry);
+         if (basket >= 0 && basketEntry[basket] == entry)
+            n = branch->GetBulkRead().GetBulkEntries(entry, buf);
+      }
+      if (n > 0) {
+         n = std::min<Long64_t>(n, last - entry);
+         if (!CopyBulkValues(leaf->GetTypeName(), buf, n, values + (entry - first)))
+            return false;
+         entry += n;
+      } else {
+         if (branch->GetEntry(entry) < 0)
+            return false;
+         values[entry - first] = leaf->GetValueLong64();
+         ++entry;
+      }
+   }
+   return true;
+}
+#endif
+} // anonymous namespace
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -168,34 +251,207 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!FillValuesParallel(tmp_major, tmp_minor)) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
+   std::vector<IndexEntry> entries(fN);
+   for (i=0;i<fN;i++) {
+      entries[i] = {tmp_major[i], tmp_minor[i], i};
+   }
+   delete [] tmp_major;
+   delete [] tmp_minor;
+
+   SortEntries(entries);
    fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
    for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+      fIndexValues[i] = entries[i].fMajor;
+      fIndexValuesMinor[i] = entries[i].fMinor;
+      fIndex[i] = entries[i].fEntry;
    }
+   fPacked = std::move(entries);
 
-   delete [] tmp_major;
-   delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the major and minor names of all the entries in parallel,
+/// if implicit multi-threading is enabled.
+///
+/// This is supported if the names are the names of scalar leaves of plain branches
+/// (or an integer constant for the minor name) and the tree or chain is read from
+/// files. Each task opens its own copy of the tree and reads a range of clusters of
+/// only the two branches, whole baskets at once with the bulk API.
+/// Returns kFALSE if the values were not read, in which case they have to be
+/// computed by evaluating the formulas.
+
+Bool_t TTreeIndex::FillValuesParallel(Long64_t *major, Long64_t *minor)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || fN < kMinEntriesPerTask)
+      return kFALSE;
+   if (fTree->LoadTree(0) < 0 || !fTree->GetCurrentFile() || fTree->GetCurrentFile()->IsWritable())
+      return kFALSE;
+   const Bool_t constMinor = fMinorName.IsDigit();
+   if (!GetPlainLeaf(*fTree, fMajorName) || (!constMinor && !GetPlainLeaf(*fTree, fMinorName)))
+      return kFALSE;
+
+   std::vector<std::string> fileNames, treeNames;
+   try {
+      fileNames = ROOT::Internal::TreeUtils::GetFileNamesFromTree(*fTree);
+      treeNames = ROOT::Internal::TreeUtils::GetTreeFullPaths(*fTree);
+   } catch (const std::runtime_error &) {
+      return kFALSE;
+   }
+   std::vector<Long64_t> offsets(fileNames.size() + 1, 0);
+   if (auto chain = dynamic_cast<TChain *>(fTree)) {
+      if (chain->GetNtrees() != (Int_t)fileNames.size())
+         return kFALSE;
+      std::copy(chain->GetTreeOffset(), chain->GetTreeOffset() + fileNames.size() + 1, offsets.begin());
+   } else {
+      offsets[1] = fN;
+   }
+   if (fileNames.size() != treeNames.size() || offsets.back() != fN)
+      return kFALSE;
+
+   ROOT::TThreadExecutor pool;
+   const Long64_t minEntriesPerTask = std::max(kMinEntriesPerTask, fN / (4 * (Long64_t)pool.GetPoolSize()));
+   std::atomic<bool> failed(false);
+
+   auto openTree = [&](std::size_t fileIdx, std::unique_ptr<TFile> &file) -> TTree * {
+      file.reset(TFile::Open(fileNames[fileIdx].c_str()));
+      TTree *tree = (file && !file->IsZombie()) ? file->Get<TTree>(treeNames[fileIdx].c_str()) : nullptr;
+      if (!tree || tree->GetEntries() != offsets[fileIdx + 1] - offsets[fileIdx])
+         return nullptr;
+      return tree;
+   };
+
+   auto fillRange = [&](std::size_t fileIdx, Long64_t first, Long64_t last) {
+      std::unique_ptr<TFile> file;
+      TTree *tree = openTree(fileIdx, file);
+      const Long64_t offset = offsets[fileIdx];
+      if (!tree || !ReadLeafValues(*tree, fMajorName, first, last, major + offset + first)) {
+         failed = true;
+         return;
+      }
+      if (constMinor) {
+         std::fill(minor + offset + first, minor + offset + last, fMinorName.Atoll());
+      } else if (!ReadLeafValues(*tree, fMinorName, first, last, minor + offset + first)) {
+         failed = true;
+      }
+   };
+
+   // Split each file into ranges of clusters, which are read concurrently
+   auto processFile = [&](std::size_t fileIdx) {
+      std::vector<std::pair<Long64_t, Long64_t>> ranges;
+      {
+         std::unique_ptr<TFile> file;
+         TTree *tree = openTree(fileIdx, file);
+         if (!tree) {
+            failed = true;
+            return;
+         }
+         auto clusters = tree->GetClusterIterator(0);
+         Long64_t start = 0, end = 0;
+         while ((end = clusters.Next()) < tree->GetEntries()) {
+            if (clusters.GetNextEntry() - start >= minEntriesPerTask) {
+               ranges.emplace_back(start, clusters.GetNextEntry());
+               start = clusters.GetNextEntry();
+            }
+         }
+         if (start < tree->GetEntries())
+            ranges.emplace_back(start, tree->GetEntries());
+      }
+      pool.Foreach([&](const std::pair<Long64_t, Long64_t> &range) { fillRange(fileIdx, range.first, range.second); },
+                   ranges);
+   };
+
+   std::vector<std::size_t> fileIdxs(fileNames.size());
+   for (std::size_t i = 0; i < fileIdxs.size(); ++i)
+      fileIdxs[i] = i;
+   pool.Foreach(processFile, fileIdxs);
+
+   return !failed;
+#else
+   (void)major;
+   (void)minor;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the index entries by major value, minor value and entry number.
+///
+/// With implicit multi-threading enabled, large indices are sorted in chunks in
+/// parallel, which are then merged pairwise in parallel.
+
+void TTreeIndex::SortEntries(std::vector<IndexEntry> &entries)
+{
+   auto less = [](const IndexEntry &a, const IndexEntry &b) {
+      if (a.fMajor != b.fMajor)
+         return a.fMajor < b.fMajor;
+      if (a.fMinor != b.fMinor)
+         return a.fMinor < b.fMinor;
+      return a.fEntry < b.fEntry;
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && entries.size() >= 2 * kMinEntriesPerSortTask) {
+      ROOT::TThreadExecutor pool;
+      std::size_t nChunks = 1;
+      while (nChunks < pool.GetPoolSize() && entries.size() / (2 * nChunks) >= kMinEntriesPerSortTask)
+         nChunks *= 2;
+      std::vector<std::size_t> bounds(nChunks + 1);
+      for (std::size_t i = 0; i <= nChunks; ++i)
+         bounds[i] = entries.size() * i / nChunks;
+
+      std::vector<std::size_t> chunks(nChunks);
+      for (std::size_t i = 0; i < nChunks; ++i)
+         chunks[i] = i;
+      pool.Foreach([&](std::size_t i) { std::sort(entries.begin() + bounds[i], entries.begin() + bounds[i + 1], less); },
+                   chunks);
+
+      for (std::size_t width = 1; width < nChunks; width *= 2) {
+         std::vector<std::size_t> merges;
+         for (std::size_t i = 0; i + width < nChunks; i += 2 * width)
+            merges.push_back(i);
+         pool.Foreach(
+            [&](std::size_t i) {
+               const auto last = std::min(i + 2 * width, nChunks);
+               std::inplace_merge(entries.begin() + bounds[i], entries.begin() + bounds[i + width],
+                                  entries.begin() + bounds[last], less);
+            },
+            merges);
+      }
+      return;
+   }
+#endif
+   std::sort(entries.begin(), entries.end(), less);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the packed entries used for the lookups from the sorted index tables.
+
+void TTreeIndex::PackValues()
+{
+   fPacked.resize(fN);
+   for (Long64_t i = 0; i < fN; i++) {
+      fPacked[i] = {fIndexValues[i], fIndexValuesMinor[i], fIndex[i]};
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor.
 
@@ -265,29 +521,21 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
    // Sort.
    if (!delaySort) {
-      Long64_t *addValues = GetIndexValues();
-      Long64_t *addValues2 = GetIndexValuesMinor();
-      Long64_t *ind = fIndex;
-      Long64_t *conv = new Long64_t[fN];
-
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
-      fIndex = new Long64_t[fN];
-      fIndexValues = new Long64_t[fN];
-      fIndexValuesMinor = new Long64_t[fN];
+      std::vector<IndexEntry> entries(fN);
+      for (Long64_t i = 0; i < fN; i++) {
+         entries[i] = {fIndexValues[i], fIndexValuesMinor[i], fIndex[i]};
+      }
+      SortEntries(entries);
 
-      for (Int_t i=0;i<fN;i++) {
-         fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
+      for (Long64_t i = 0; i < fN; i++) {
+         fIndexValues[i] = entries[i].fMajor;
+         fIndexValuesMinor[i] = entries[i].fMinor;
+         fIndex[i] = entries[i].fEntry;
       }
-      delete [] addValues;
-      delete [] addValues2;
-      delete [] ind;
-      delete [] conv;
+      fPacked = std::move(entries);
+   } else {
+      // The index cannot be used for lookups before it is sorted
+      fPacked.clear();
    }
 }
 
@@ -356,17 +604,20 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
 /// use lower_bound STD algorithm.
+/// The search is done on the packed entries, such that each step of the
+/// bisection touches a single cache line.
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
-   Long64_t mid, step, pos = 0, count = fN;
+   Long64_t mid, step, pos = 0, count = fPacked.size();
    // find lower bound using bisection
    while( count > 0 ) {
       step = count / 2;
       mid = pos + step;
       // check if *mid < major|minor
-      if( fIndexValues[mid] < major
-          || ( fIndexValues[mid] == major &&  fIndexValuesMinor[mid] < minor ) ) {
+      const IndexEntry &e = fPacked[mid];
+      if( e.fMajor < major
+          || ( e.fMajor == major && e.fMinor < minor ) ) {
          pos = mid+1;
          count -= step + 1;
       } else
@@ -394,14 +645,15 @@ Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 
 Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor) const
 {
-   if (fN == 0) return -1;
+   const Long64_t n = fPacked.size();
+   if (n == 0) return -1;
 
    Long64_t pos = FindValues(major, minor);
-   if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
-      return fIndex[pos];
+   if( pos < n && fPacked[pos].fMajor == major && fPacked[pos].fMinor == minor )
+      return fPacked[pos].fEntry;
    if( --pos < 0 )
       return -1;
-   return fIndex[pos];
+   return fPacked[pos].fEntry;
 }
 
 
@@ -419,11 +671,12 @@ Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor)
 
 Long64_t TTreeIndex::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) const
 {
-   if (fN == 0) return -1;
+   const Long64_t n = fPacked.size();
+   if (n == 0) return -1;
 
    Long64_t pos = FindValues(major, minor);
-   if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
-      return fIndex[pos];
+   if( pos < n && fPacked[pos].fMajor == major && fPacked[pos].fMinor == minor )
+      return fPacked[pos].fEntry;
    return -1;
 }
 
@@ -578,6 +831,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       }
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
+      PackValues();
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
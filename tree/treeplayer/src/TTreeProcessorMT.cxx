@@ -25,8 +25,11 @@ objects.
 */
 
 #include "TROOT.h"
+#include "TTreeCache.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <algorithm>
+
 using namespace ROOT;
 
 namespace {
@@ -286,6 +289,121 @@ unsigned int TTreeProcessorMT::fgTasksPerWorkerHint = 10U;
 
 namespace Internal {
 
+namespace {
+/// Above this average duration of a read call of the cache, the cache size is doubled
+constexpr Double_t kHighReadLatency = 2e-3;
+/// Below this average duration of a read call of the cache, the cache size is halved
+constexpr Double_t kLowReadLatency = 2e-4;
+/// Upper bound of the adaptive cache size
+constexpr Long64_t kMaxAdaptiveCacheSize = 512 * 1024 * 1024;
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the branches to be cached by all tasks, including their sub-branches.
+void TTreeCacheSettings::SetBranches(const std::vector<std::string> &branches)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fBranches = branches;
+   fHasBranches = true;
+   fSubBranches = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the adaptation of the cache size to the measured read latency.
+void TTreeCacheSettings::SetAdaptiveSize(bool enable)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fAdaptiveSize = enable;
+   if (!enable)
+      fSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Configure the cache of the current tree of `tree`, a TChain, with the shared cache size and branches.
+/// If the branches are known, the learning phase of the cache is stopped.
+void TTreeCacheSettings::Apply(TTree &tree)
+{
+   std::vector<std::string> branches;
+   bool subBranches;
+   Long64_t size;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fHasBranches)
+         branches = fBranches;
+      subBranches = fSubBranches;
+      size = fSize;
+   }
+
+   TFile *file = tree.GetCurrentFile();
+   if (!file || !tree.GetTree())
+      return;
+   if (size > 0)
+      tree.SetCacheSize(size);
+   if (branches.empty() || !tree.GetTree()->GetReadCache(file, kTRUE))
+      return;
+
+   for (const auto &branch : branches) {
+      // Friends or other files might not have all branches
+      if (tree.GetBranch(branch.c_str()))
+         tree.AddBranchToCache(branch.c_str(), subBranches);
+   }
+   tree.StopCacheLearningPhase();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the read statistics of the cache of the current tree of `tree`; to be passed to Update() at the end
+/// of a task.
+TTreeCacheSettings::RReadStats TTreeCacheSettings::GetReadStats(TTree &tree) const
+{
+   RReadStats stats;
+   TFile *file = tree.GetCurrentFile();
+   if (!file || !tree.GetTree())
+      return stats;
+   if (auto cache = file->GetCacheRead(tree.GetTree())) {
+      stats.fCache = cache;
+      stats.fReadCalls = cache->GetReadCalls();
+      stats.fReadTime = cache->GetReadTime();
+   }
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the branches learned by the cache of the current tree of `tree` if they are not known yet and adapt
+/// the cache size to the read latency measured since `start`.
+void TTreeCacheSettings::Update(TTree &tree, const RReadStats &start)
+{
+   TFile *file = tree.GetCurrentFile();
+   if (!file || !tree.GetTree())
+      return;
+   auto cache = dynamic_cast<TTreeCache *>(file->GetCacheRead(tree.GetTree()));
+   if (!cache)
+      return;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+
+   if (!fHasBranches && !cache->IsLearning() && cache->GetCachedBranches()) {
+      for (auto branch : *cache->GetCachedBranches())
+         fBranches.emplace_back(branch->GetName());
+      fHasBranches = !fBranches.empty();
+   }
+
+   if (!fAdaptiveSize)
+      return;
+   if (fMinSize == 0)
+      fMinSize = cache->GetBufferSize();
+   const bool sameCache = (start.fCache == cache);
+   const Int_t readCalls = cache->GetReadCalls() - (sameCache ? start.fReadCalls : 0);
+   const Double_t readTime = cache->GetReadTime() - (sameCache ? start.fReadTime : 0);
+   if (readCalls <= 0)
+      return;
+   const Double_t latency = readTime / readCalls;
+   const Long64_t size = fSize > 0 ? fSize : cache->GetBufferSize();
+   if (latency > kHighReadLatency)
+      fSize = std::min(2 * size, kMaxAdaptiveCacheSize);
+   else if (latency < kLowReadLatency)
+      fSize = std::max(size / 2, fMinSize);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct fChain, also adding friends if needed and injecting knowledge of offsets if available.
 /// \param[in] treeNames Name of the tree for each file in `fileNames`.
@@ -302,7 +420,10 @@ void TTreeView::MakeChain(const std::vector<std::string> &treeNames, const std::
    const auto &friendFileNames = friendInfo.fFriendFileNames;
    const auto &friendChainSubNames = friendInfo.fFriendChainSubNames;
 
+   if (fNotify.IsLinked())
+      fNotify.RemoveLink(*fChain);
    fChain.reset(new TChain());
+   fNotify.PrependLink(*fChain);
    const auto nFiles = fileNames.size();
    for (auto i = 0u; i < nFiles; ++i) {
       fChain->Add((fileNames[i] + "?#" + treeNames[i]).c_str(), nEntries[i]);
@@ -348,8 +469,11 @@ std::unique_ptr<TTreeReader>
 TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::vector<std::string> &treeNames,
                          const std::vector<std::string> &fileNames, const TreeUtils::RFriendInfo &friendInfo,
                          const TEntryList &entryList, const std::vector<Long64_t> &nEntries,
-                         const std::vector<std::vector<Long64_t>> &friendEntries)
+                         const std::vector<std::vector<Long64_t>> &friendEntries,
+                         TTreeCacheSettings *cacheSettings)
 {
+   fCacheSettings = cacheSettings;
+
    const bool hasEntryList = entryList.GetN() > 0;
    const bool usingLocalEntries = friendInfo.fFriendNames.empty() && !hasEntryList;
    const bool needNewChain =
@@ -369,9 +493,21 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::vector<std::st
    }
    auto reader = std::make_unique<TTreeReader>(fChain.get(), fEntryList.get());
    reader->SetEntriesRange(start, end);
+   // Trees loaded later on are configured by Notify()
+   if (fCacheSettings && fChain->GetTree())
+      fCacheSettings->Apply(*fChain);
    return reader;
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Called by fChain when it switches to another tree; configures the cache of the new tree.
+Bool_t TTreeView::Notify()
+{
+   if (fCacheSettings)
+      fCacheSettings->Apply(*fChain);
+   return kTRUE;
+}
+
 } // namespace Internal
 } // namespace ROOT
 
@@ -538,8 +674,11 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 
       auto processCluster = [&](const EntryCluster &c) {
          auto r = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
-                                           theseEntries, friendEntries);
+                                           theseEntries, friendEntries, &fCacheSettings);
+         auto tree = r->GetTree();
+         const auto readStats = fCacheSettings.GetReadStats(*tree);
          func(*r);
+         fCacheSettings.Update(*tree, readStats);
       };
 
       fPool.Foreach(processCluster, thisFileClusters);
@@ -551,6 +690,29 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    fPool.Foreach(processFile, fileIdxs);
 }
 
+////////////////////////////////////////////////////////////////////////
+/// \brief Declare the branches to be cached by the TTreeCaches of all tasks.
+/// \param[in] branches Names of the branches; their sub-branches are cached, too.
+///
+/// By default, the branches learned by the cache of the first task are cached by the later tasks.
+/// Declaring the branches upfront skips the learning phase of the first task, too.
+/// Branches read through TTreeReaderValues and TTreeReaderArrays are always cached.
+void TTreeProcessorMT::SetCacheBranches(const std::vector<std::string> &branches)
+{
+   fCacheSettings.SetBranches(branches);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Adapt the size of the TTreeCaches to the read latency measured by previous tasks.
+/// \param[in] enable Whether to adapt the cache size.
+///
+/// The cache size is doubled, up to 512 MB, while the average duration of the read calls of the cache is
+/// above 2 ms, and is halved, down to its initial size, while it is below 0.2 ms.
+void TTreeProcessorMT::SetAdaptiveCacheSize(bool enable)
+{
+   fCacheSettings.SetAdaptiveSize(enable);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// \brief Retrieve the current value for the desired number of tasks per worker.
 /// \return The desired number of tasks to be created per worker. TTreeProcessorMT uses this value as an hint.
@@ -9,6 +9,7 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TSystem.h>
+#include <TTreeCache.h>
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
 #include <ROOT/TTreeProcessorMT.hxx>
@@ -518,3 +519,93 @@ TEST(TreeProcessorMT, TreesInSameFile)
    gSystem->Unlink(fname.c_str());
    ROOT::DisableImplicitMT();
 }
+
+TEST(TreeProcessorMT, CacheSettings)
+{
+   const std::vector<std::string> filenames = {"treeprocmt_cachesettings0.root", "treeprocmt_cachesettings1.root"};
+   WriteFiles({"t", "t"}, filenames);
+
+   ROOT::EnableImplicitMT(2);
+   std::vector<std::string_view> fnames(filenames.begin(), filenames.end());
+   ROOT::TTreeProcessorMT proc(fnames, "t");
+   proc.SetCacheBranches({"v"});
+
+   // No TTreeReaderValue: the branches and the end of the learning phase come from the shared settings
+   std::atomic_int nTasks(0);
+   std::atomic_int nConfigured(0);
+   proc.Process([&](TTreeReader &r) {
+      ASSERT_TRUE(r.Next());
+      ++nTasks;
+      auto tree = r.GetTree();
+      auto cache = dynamic_cast<TTreeCache *>(tree->GetCurrentFile()->GetCacheRead(tree->GetTree()));
+      if (cache && !cache->IsLearning() && cache->GetCachedBranches() &&
+          cache->GetCachedBranches()->FindObject("v"))
+         ++nConfigured;
+   });
+
+   EXPECT_EQ(2, nTasks.load());
+   EXPECT_EQ(nTasks.load(), nConfigured.load());
+
+   DeleteFiles(filenames);
+   ROOT::DisableImplicitMT();
+}
+
+namespace {
+/// A file with a high latency for the vectored reads, as issued by the TTreeCache
+class TSlowFile : public TFile {
+public:
+   using TFile::TFile;
+   Bool_t ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf) override
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return TFile::ReadBuffers(buf, pos, len, nbuf);
+   }
+};
+
+/// Read all entries of the tree through its cache and update the settings with the measured read time
+Long64_t ReadAndUpdate(TFile &file, ROOT::Internal::TTreeCacheSettings &settings)
+{
+   auto tree = file.Get<TTree>("t");
+   tree->SetCacheSize(100000);
+   tree->AddBranchToCache("*", kTRUE);
+   tree->StopCacheLearningPhase();
+   const auto cacheSize = file.GetCacheRead(tree)->GetBufferSize();
+
+   const auto start = settings.GetReadStats(*tree);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+   EXPECT_GT(file.GetCacheRead(tree)->GetReadCalls(), 0);
+   settings.Update(*tree, start);
+   return cacheSize;
+}
+} // anonymous namespace
+
+TEST(TreeProcessorMT, AdaptiveCacheSize)
+{
+   const std::vector<std::string> filenames = {"treeprocmt_adaptivecachesize.root"};
+   WriteFiles({"t"}, filenames);
+
+   ROOT::Internal::TTreeCacheSettings settings;
+   settings.SetAdaptiveSize(true);
+
+   // High latency: the cache size of the following tasks is doubled
+   Long64_t initialSize = 0;
+   {
+      TSlowFile file(filenames[0].c_str());
+      initialSize = ReadAndUpdate(file, settings);
+      auto tree = file.Get<TTree>("t");
+      settings.Apply(*tree);
+      EXPECT_EQ(2 * initialSize, tree->GetCacheSize());
+   }
+
+   // Low latency: it shrinks back to its initial size
+   {
+      TFile file(filenames[0].c_str());
+      ReadAndUpdate(file, settings);
+      auto tree = file.Get<TTree>("t");
+      settings.Apply(*tree);
+      EXPECT_EQ(initialSize, tree->GetCacheSize());
+   }
+
+   DeleteFiles(filenames);
+}
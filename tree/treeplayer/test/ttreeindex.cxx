@@ -0,0 +1,93 @@
+#include "RConfigure.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+// Enough entries for the index to be built by several tasks
+const Long64_t kNEntries = 300000;
+
+void WriteRunEventTree(const char *fileName)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   Int_t run = 0;
+   Long64_t event = 0;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.SetAutoFlush(10000);
+   for (Long64_t i = 0; i < kNEntries; ++i) {
+      // Neither the runs nor the events are in order
+      run = (i * 7919) % 13;
+      event = (i * 104729) % kNEntries;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void CheckIndex(TTree &t, const TTreeIndex &index)
+{
+   ASSERT_EQ(kNEntries, index.GetN());
+   const Long64_t *major = index.GetIndexValues();
+   const Long64_t *minor = index.GetIndexValuesMinor();
+   for (Long64_t i = 1; i < kNEntries; ++i)
+      EXPECT_TRUE(major[i - 1] < major[i] || (major[i - 1] == major[i] && minor[i - 1] <= minor[i]));
+
+   Int_t run = 0;
+   Long64_t event = 0;
+   t.SetBranchAddress("run", &run);
+   t.SetBranchAddress("event", &event);
+   for (Long64_t i = 0; i < kNEntries; i += 997) {
+      t.GetEntry(i);
+      EXPECT_EQ(i, index.GetEntryNumberWithIndex(run, event));
+   }
+   t.ResetBranchAddresses();
+   EXPECT_EQ(-1, index.GetEntryNumberWithIndex(13, 0));
+   EXPECT_EQ(-1, index.GetEntryNumberWithBestIndex(-1, 0));
+}
+
+} // anonymous namespace
+
+TEST(TTreeIndex, BuildSerial)
+{
+   const auto fileName = "ttreeindex_buildserial.root";
+   WriteRunEventTree(fileName);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   TTreeIndex index(t, "run", "event");
+   CheckIndex(*t, index);
+
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, BuildParallel)
+{
+   const auto fileName = "ttreeindex_buildparallel.root";
+   WriteRunEventTree(fileName);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   TTreeIndex serial(t, "run", "event");
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex parallel(t, "run", "event");
+   ROOT::DisableImplicitMT();
+
+   CheckIndex(*t, parallel);
+   for (Long64_t i = 0; i < kNEntries; ++i) {
+      EXPECT_EQ(serial.GetIndex()[i], parallel.GetIndex()[i]);
+      EXPECT_EQ(serial.GetIndexValues()[i], parallel.GetIndexValues()[i]);
+      EXPECT_EQ(serial.GetIndexValuesMinor()[i], parallel.GetIndexValuesMinor()[i]);
+   }
+
+   gSystem->Unlink(fileName);
+}
+#endif